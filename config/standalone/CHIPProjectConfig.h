@@ -60,6 +60,8 @@
 
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 0
 
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE 8
+
 #define CHIP_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL 1
 
 #ifndef CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
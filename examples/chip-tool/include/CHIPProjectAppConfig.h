@@ -58,6 +58,8 @@
 
 #define CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY 1
 
+#define CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE 16
+
 // Enable some test-only interaction model APIs.
 #define CONFIG_BUILD_FOR_HOST_UNIT_TEST 1
 
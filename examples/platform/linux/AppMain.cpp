@@ -105,6 +105,7 @@
 #endif // CHIP_DEVICE_LAYER_TARGET_DARWIN
 
 #if CHIP_DEVICE_LAYER_TARGET_LINUX
+#include <platform/Linux/CHIPLinuxEventLogStorage.h>
 #include <platform/Linux/NetworkCommissioningDriver.h>
 #endif // CHIP_DEVICE_LAYER_TARGET_LINUX
 
@@ -244,6 +245,31 @@ void InitNetworkCommissioning()
 #endif // CHIP_APP_MAIN_HAS_ETHERNET_DRIVER
     }
 }
+
+#if CHIP_DEVICE_LAYER_TARGET_LINUX
+DeviceLayer::Internal::ChipLinuxEventLogStorage sEventLogStorage;
+app::LogStorageResources sEventLogStorageResources[3];
+
+// Keeps the event log in a memory-mapped file, so that events survive restarts of the app.
+CHIP_ERROR InitEventLogStorage(const char * eventLogFile)
+{
+    // Ordered as expected by ServerInitParams::eventLogStorageResources.
+    static constexpr uint32_t kBufferSizes[]          = { CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_DEBUG_BUFFER_SIZE,
+                                                          CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_INFO_BUFFER_SIZE,
+                                                          CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_CRIT_BUFFER_SIZE };
+    static constexpr app::PriorityLevel kPriorities[] = { app::PriorityLevel::Debug, app::PriorityLevel::Info,
+                                                          app::PriorityLevel::Critical };
+    static_assert(ArraySize(kBufferSizes) == ArraySize(sEventLogStorageResources), "Unexpected number of event buffers");
+
+    ReturnErrorOnFailure(sEventLogStorage.Init(eventLogFile, kBufferSizes, ArraySize(kBufferSizes)));
+    for (size_t i = 0; i < ArraySize(sEventLogStorageResources); i++)
+    {
+        sEventLogStorageResources[i] = { sEventLogStorage.GetBuffer(i), sEventLogStorage.GetBufferSize(i), kPriorities[i],
+                                         sEventLogStorage.GetBufferState(i) };
+    }
+    return CHIP_NO_ERROR;
+}
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX
 } // anonymous namespace
 
 #if defined(ENABLE_CHIP_SHELL)
@@ -562,6 +588,22 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     chip::app::RuntimeOptionsProvider::Instance().SetSimulateNoInternalTime(
         LinuxDeviceOptions::GetInstance().mSimulateNoInternalTime);
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX
+    if (LinuxDeviceOptions::GetInstance().eventLogFile != nullptr)
+    {
+        CHIP_ERROR err = InitEventLogStorage(LinuxDeviceOptions::GetInstance().eventLogFile);
+        if (err == CHIP_NO_ERROR)
+        {
+            initParams.eventLogStorageResources = &sEventLogStorageResources[0];
+        }
+        else
+        {
+            ChipLogError(NotSpecified, "Failed to open the event log file, keeping events in memory: %" CHIP_ERROR_FORMAT,
+                         err.Format());
+        }
+    }
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX
+
     // Init ZCL Data Model and CHIP App Server
     Server::GetInstance().Init(initParams);
 
@@ -631,6 +673,10 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
 
     Server::GetInstance().Shutdown();
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX
+    sEventLogStorage.Shutdown();
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX
+
 #if ENABLE_TRACING
     tracing_setup.StopTracing();
 #endif
@@ -106,6 +106,7 @@ enum
 #if CHIP_WITH_NLFAULTINJECTION
     kDeviceOption_FaultInjection = 0x1027,
 #endif
+    kDeviceOption_EventLogFile = 0x1028,
 };
 
 constexpr unsigned kAppUsageLength = 64;
@@ -141,6 +142,7 @@ OptionDef sDeviceOptionDefs[] = {
     { "command", kArgumentRequired, kDeviceOption_Command },
     { "PICS", kArgumentRequired, kDeviceOption_PICS },
     { "KVS", kArgumentRequired, kDeviceOption_KVS },
+    { "event-log-file", kArgumentRequired, kDeviceOption_EventLogFile },
     { "interface-id", kArgumentRequired, kDeviceOption_InterfaceId },
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
     { "trace_file", kArgumentRequired, kDeviceOption_TraceFile },
@@ -257,6 +259,9 @@ const char * sDeviceOptionHelp =
     "  --KVS <filepath>\n"
     "       A file to store Key Value Store items.\n"
     "\n"
+    "  --event-log-file <filepath>\n"
+    "       A file to keep the event log in, so that events survive restarts (Linux only).\n"
+    "\n"
     "  --interface-id <interface>\n"
     "       A interface id to advertise on.\n"
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
@@ -490,6 +495,10 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         LinuxDeviceOptions::GetInstance().KVS = aValue;
         break;
 
+    case kDeviceOption_EventLogFile:
+        LinuxDeviceOptions::GetInstance().eventLogFile = aValue;
+        break;
+
     case kDeviceOption_InterfaceId:
         LinuxDeviceOptions::GetInstance().interfaceId =
             Inet::InterfaceId(static_cast<chip::Inet::InterfaceId::PlatformType>(atoi(aValue)));
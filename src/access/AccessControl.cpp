@@ -25,6 +25,10 @@
 
 #include <lib/core/Global.h>
 
+#if CHIP_CONFIG_ACCESS_CONTROL_CACHE
+#include <algorithm>
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
 namespace chip {
 namespace Access {
 
@@ -190,6 +194,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateCache();
     }
 
     return retval;
@@ -201,6 +206,7 @@ void AccessControl::Finish()
     ChipLogProgress(DataManagement, "AccessControl: finishing");
     mDelegate->Finish();
     mDelegate = nullptr;
+    InvalidateCache();
 }
 
 CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t * index,
@@ -218,6 +224,7 @@ CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescripto
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
 
     size_t i = 0;
+    InvalidateCache();
     ReturnErrorOnFailure(mDelegate->CreateEntry(&i, entry, &fabric));
 
     if (index)
@@ -234,6 +241,7 @@ CHIP_ERROR AccessControl::UpdateEntry(const SubjectDescriptor * subjectDescripto
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
+    InvalidateCache();
     ReturnErrorOnFailure(mDelegate->UpdateEntry(index, entry, &fabric));
     NotifyEntryChanged(subjectDescriptor, fabric, index, &entry, EntryListener::ChangeType::kUpdated);
     return CHIP_NO_ERROR;
@@ -248,6 +256,7 @@ CHIP_ERROR AccessControl::DeleteEntry(const SubjectDescriptor * subjectDescripto
     {
         p = &entry;
     }
+    InvalidateCache();
     ReturnErrorOnFailure(mDelegate->DeleteEntry(index, &fabric));
     if (p && p->HasDefaultDelegate())
     {
@@ -355,6 +364,33 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_CACHE
+    CHIP_ERROR result = CheckCached(subjectDescriptor, requestPath, requestPrivilege);
+    if (result == CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        result = CheckEntries(subjectDescriptor, requestPath, requestPrivilege);
+    }
+#else
+    CHIP_ERROR result = CheckEntries(subjectDescriptor, requestPath, requestPrivilege);
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
+    if (result == CHIP_NO_ERROR)
+    {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+    }
+    else if (result == CHIP_ERROR_ACCESS_DENIED)
+    {
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+    }
+
+    return result;
+}
+
+CHIP_ERROR AccessControl::CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege)
+{
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -456,19 +492,301 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
             }
         }
         // Entry passed all checks: access is allowed.
-
-#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-        ChipLogProgress(DataManagement, "AccessControl: allowed");
-#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-
         return CHIP_NO_ERROR;
     }
 
     // No entry was found which passed all checks: access is denied.
-    ChipLogProgress(DataManagement, "AccessControl: denied");
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
+CHIP_ERROR AccessControl::CheckCached(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                      Privilege requestPrivilege)
+{
+    for (size_t i = 0; i < mCachedDecisionCount; ++i)
+    {
+        const CachedDecision & decision = mCachedDecisions[i];
+        if (decision.subjectDescriptor.fabricIndex == subjectDescriptor.fabricIndex &&
+            decision.subjectDescriptor.authMode == subjectDescriptor.authMode &&
+            decision.subjectDescriptor.subject == subjectDescriptor.subject &&
+            decision.subjectDescriptor.cats == subjectDescriptor.cats && decision.requestPath.cluster == requestPath.cluster &&
+            decision.requestPath.endpoint == requestPath.endpoint && decision.requestPrivilege == requestPrivilege)
+        {
+            bool allowed = decision.allowed;
+            // Move the decision to the front.
+            std::rotate(mCachedDecisions.begin(), mCachedDecisions.begin() + i, mCachedDecisions.begin() + i + 1);
+            return allowed ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+        }
+    }
+
+    CompiledFabric * compiled = GetCompiledFabric(subjectDescriptor.fabricIndex);
+    VerifyOrReturnError(compiled != nullptr, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    bool usedDeviceTypeResolver = false;
+    bool allowed = compiled->Check(subjectDescriptor, requestPath, requestPrivilege, *mDeviceTypeResolver, usedDeviceTypeResolver);
+
+    if (!usedDeviceTypeResolver && !mCachedDecisions.empty())
+    {
+        if (mCachedDecisionCount < mCachedDecisions.size())
+        {
+            mCachedDecisionCount++;
+        }
+        std::move_backward(mCachedDecisions.begin(), mCachedDecisions.begin() + mCachedDecisionCount - 1,
+                           mCachedDecisions.begin() + mCachedDecisionCount);
+        mCachedDecisions[0] = { subjectDescriptor, requestPath, requestPrivilege, allowed };
+    }
+
+    return allowed ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+}
+
+AccessControl::CompiledFabric * AccessControl::GetCompiledFabric(FabricIndex fabricIndex)
+{
+    CompiledFabric * empty = nullptr;
+    for (auto & compiled : mCompiledFabrics)
+    {
+        if (!compiled.IsEmpty() && compiled.GetFabricIndex() == fabricIndex)
+        {
+            return compiled.IsCompiled() ? &compiled : nullptr;
+        }
+        if (compiled.IsEmpty() && empty == nullptr)
+        {
+            empty = &compiled;
+        }
+    }
+
+    if (empty == nullptr)
+    {
+        // All slots are taken (e.g. by fabrics that were since removed): recycle them in turn.
+        empty               = &mCompiledFabrics[mNextCompiledFabric];
+        mNextCompiledFabric = (mNextCompiledFabric + 1) % ArraySize(mCompiledFabrics);
+        empty->Clear();
+    }
+
+    CHIP_ERROR err = empty->Compile(*this, fabricIndex);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "AccessControl: failed to compile entries of fabric 0x%x: %" CHIP_ERROR_FORMAT,
+                     static_cast<unsigned>(fabricIndex), err.Format());
+        return nullptr;
+    }
+
+    return empty;
+}
+
+void AccessControl::InvalidateCache()
+{
+    for (auto & compiled : mCompiledFabrics)
+    {
+        compiled.Clear();
+    }
+    mCachedDecisionCount = 0;
+}
+
+CHIP_ERROR AccessControl::CompiledFabric::Compile(const AccessControl & accessControl, FabricIndex fabricIndex)
+{
+    Clear();
+    mState       = State::kFailed;
+    mFabricIndex = fabricIndex;
+
+    // First pass: size the arrays.
+    size_t entryCount   = 0;
+    size_t subjectCount = 0;
+    size_t targetCount  = 0;
+    {
+        EntryIterator iterator;
+        ReturnErrorOnFailure(accessControl.Entries(iterator, &fabricIndex));
+
+        Entry entry;
+        CHIP_ERROR err;
+        while ((err = iterator.Next(entry)) == CHIP_NO_ERROR)
+        {
+            size_t count = 0;
+            ReturnErrorOnFailure(entry.GetSubjectCount(count));
+            // An entry without subjects is stored under kUndefinedNodeId.
+            subjectCount += (count > 0) ? count : 1;
+            ReturnErrorOnFailure(entry.GetTargetCount(count));
+            targetCount += count;
+            entryCount++;
+        }
+        // Unlike a check, compiling must not silently skip the rest of the entries.
+        VerifyOrReturnError(err == CHIP_ERROR_SENTINEL, err);
+    }
+
+    // Allocate at least one element so that an empty fabric still compiles.
+    VerifyOrReturnError(mEntries.Calloc(entryCount > 0 ? entryCount : 1), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(mSubjects.Calloc(subjectCount > 0 ? subjectCount : 1), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(mTargets.Calloc(targetCount > 0 ? targetCount : 1), CHIP_ERROR_NO_MEMORY);
+
+    // Second pass: fill them, with the same validation as CheckEntries.
+    EntryIterator iterator;
+    ReturnErrorOnFailure(accessControl.Entries(iterator, &fabricIndex));
+
+    size_t entryIndex  = 0;
+    size_t targetIndex = 0;
+    Entry entry;
+    CHIP_ERROR err;
+    while ((err = iterator.Next(entry)) == CHIP_NO_ERROR)
+    {
+        // The entries must not change between the two passes.
+        VerifyOrReturnError(entryIndex < entryCount, CHIP_ERROR_INCORRECT_STATE);
+
+        CompiledEntry & compiledEntry = mEntries[entryIndex];
+        ReturnErrorOnFailure(entry.GetAuthMode(compiledEntry.authMode));
+        VerifyOrReturnError(compiledEntry.authMode == AuthMode::kCase || compiledEntry.authMode == AuthMode::kGroup,
+                            CHIP_ERROR_INCORRECT_STATE);
+        ReturnErrorOnFailure(entry.GetPrivilege(compiledEntry.privilege));
+
+        size_t count = 0;
+        ReturnErrorOnFailure(entry.GetSubjectCount(count));
+        if (count == 0)
+        {
+            VerifyOrReturnError(mSubjectCount < subjectCount, CHIP_ERROR_INCORRECT_STATE);
+            mSubjects[mSubjectCount++] = { kUndefinedNodeId, entryIndex };
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            NodeId subject = kUndefinedNodeId;
+            ReturnErrorOnFailure(entry.GetSubject(i, subject));
+            if (IsOperationalNodeId(subject) || IsCASEAuthTag(subject))
+            {
+                VerifyOrReturnError(compiledEntry.authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+            }
+            else if (IsGroupId(subject))
+            {
+                VerifyOrReturnError(compiledEntry.authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+            }
+            else
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            VerifyOrReturnError(mSubjectCount < subjectCount, CHIP_ERROR_INCORRECT_STATE);
+            mSubjects[mSubjectCount++] = { subject, entryIndex };
+        }
+
+        ReturnErrorOnFailure(entry.GetTargetCount(count));
+        VerifyOrReturnError(targetIndex + count <= targetCount, CHIP_ERROR_INCORRECT_STATE);
+        compiledEntry.targetStart = targetIndex;
+        compiledEntry.targetCount = count;
+        for (size_t i = 0; i < count; ++i)
+        {
+            ReturnErrorOnFailure(entry.GetTarget(i, mTargets[targetIndex++]));
+        }
+
+        entryIndex++;
+    }
+    VerifyOrReturnError(err == CHIP_ERROR_SENTINEL, err);
+    VerifyOrReturnError(entryIndex == entryCount, CHIP_ERROR_INCORRECT_STATE);
+
+    std::sort(mSubjects.Get(), mSubjects.Get() + mSubjectCount,
+              [](const CompiledSubject & a, const CompiledSubject & b) { return a.subject < b.subject; });
+
+    mState = State::kCompiled;
+    return CHIP_NO_ERROR;
+}
+
+void AccessControl::CompiledFabric::Clear()
+{
+    mState       = State::kEmpty;
+    mFabricIndex = kUndefinedFabricIndex;
+    mEntries.Free();
+    mSubjects.Free();
+    mSubjectCount = 0;
+    mTargets.Free();
+}
+
+bool AccessControl::CompiledFabric::Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                          Privilege requestPrivilege, DeviceTypeResolver & deviceTypeResolver,
+                                          bool & usedDeviceTypeResolver) const
+{
+    auto checkSubjects = [&](NodeId first, NodeId last) {
+        return CheckSubjects(first, last, subjectDescriptor, requestPath, requestPrivilege, deviceTypeResolver,
+                             usedDeviceTypeResolver);
+    };
+
+    // Entries without subjects apply to every subject.
+    if (checkSubjects(kUndefinedNodeId, kUndefinedNodeId))
+    {
+        return true;
+    }
+
+    const NodeId subject = subjectDescriptor.subject;
+    if ((IsOperationalNodeId(subject) || IsGroupId(subject)) && checkSubjects(subject, subject))
+    {
+        return true;
+    }
+
+    if (subjectDescriptor.authMode == AuthMode::kCase)
+    {
+        // A CAT subject matches a CAT of the same identifier with at least the same version, see
+        // CATValues::CheckSubjectAgainstCATs.
+        for (auto cat : subjectDescriptor.cats.values)
+        {
+            if (cat == kUndefinedCAT || GetCASEAuthTagVersion(cat) == 0)
+            {
+                continue;
+            }
+            NodeId identifier = NodeIdFromCASEAuthTag(cat) & ~static_cast<NodeId>(kTagVersionMask);
+            if (checkSubjects(identifier | 1, identifier | GetCASEAuthTagVersion(cat)))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool AccessControl::CompiledFabric::CheckSubjects(NodeId first, NodeId last, const SubjectDescriptor & subjectDescriptor,
+                                                  const RequestPath & requestPath, Privilege requestPrivilege,
+                                                  DeviceTypeResolver & deviceTypeResolver, bool & usedDeviceTypeResolver) const
+{
+    const CompiledSubject * begin = mSubjects.Get();
+    const CompiledSubject * end   = begin + mSubjectCount;
+
+    for (auto * it = std::lower_bound(begin, end, first, [](const CompiledSubject & a, NodeId b) { return a.subject < b; });
+         it != end && it->subject <= last; ++it)
+    {
+        const CompiledEntry & entry = mEntries[it->entryIndex];
+        if (entry.authMode != subjectDescriptor.authMode ||
+            !CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, entry.privilege))
+        {
+            continue;
+        }
+
+        if (entry.targetCount == 0)
+        {
+            return true;
+        }
+
+        for (size_t i = entry.targetStart; i < entry.targetStart + entry.targetCount; ++i)
+        {
+            const Entry::Target & target = mTargets[i];
+            if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
+            {
+                continue;
+            }
+            if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
+            {
+                continue;
+            }
+            if (target.flags & Entry::Target::kDeviceType)
+            {
+                usedDeviceTypeResolver = true;
+                if (!deviceTypeResolver.IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+                {
+                    continue;
+                }
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
 CHIP_ERROR AccessControl::Dump(const Entry & entry)
 {
@@ -26,6 +26,12 @@
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
 
+#if CHIP_CONFIG_ACCESS_CONTROL_CACHE
+#include <lib/support/ScopedBuffer.h>
+
+#include <array>
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
 // Dump function for use during development only (0 for disabled, non-zero for enabled).
 #define CHIP_ACCESS_CONTROL_DUMP_ENABLED 0
 
@@ -497,6 +503,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCache();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +554,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCache();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +576,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCache();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -649,6 +658,91 @@ private:
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
+    // Checks against the entries of the subject's fabric, through the delegate's iterator.
+    CHIP_ERROR CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                            Privilege requestPrivilege);
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CACHE
+    /**
+     * The entries of one fabric, flattened into plain arrays.  Subjects are
+     * kept sorted (with kUndefinedNodeId standing for entries without
+     * subjects), so the entries which may apply to a subject are found with a
+     * few binary searches.
+     */
+    class CompiledFabric
+    {
+    public:
+        CHIP_ERROR Compile(const AccessControl & accessControl, FabricIndex fabricIndex);
+        void Clear();
+
+        bool IsCompiled() const { return mState == State::kCompiled; }
+        bool IsFailed() const { return mState == State::kFailed; }
+        bool IsEmpty() const { return mState == State::kEmpty; }
+        FabricIndex GetFabricIndex() const { return mFabricIndex; }
+
+        // Returns whether some entry allows access.  usedDeviceTypeResolver is
+        // set if the result depends on the device types of the endpoint.
+        bool Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                   DeviceTypeResolver & deviceTypeResolver, bool & usedDeviceTypeResolver) const;
+
+    private:
+        enum class State : uint8_t
+        {
+            kEmpty,
+            kCompiled,
+            kFailed, // Could not be compiled: checks on this fabric go through the delegate.
+        };
+
+        struct CompiledEntry
+        {
+            AuthMode authMode;
+            Privilege privilege;
+            size_t targetStart;
+            size_t targetCount;
+        };
+
+        struct CompiledSubject
+        {
+            NodeId subject;
+            size_t entryIndex;
+        };
+
+        bool CheckSubjects(NodeId first, NodeId last, const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                           Privilege requestPrivilege, DeviceTypeResolver & deviceTypeResolver,
+                           bool & usedDeviceTypeResolver) const;
+
+        State mState             = State::kEmpty;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        Platform::ScopedMemoryBuffer<CompiledEntry> mEntries;
+        Platform::ScopedMemoryBuffer<CompiledSubject> mSubjects;
+        size_t mSubjectCount = 0;
+        Platform::ScopedMemoryBuffer<Entry::Target> mTargets;
+    };
+
+    struct CachedDecision
+    {
+        SubjectDescriptor subjectDescriptor;
+        RequestPath requestPath;
+        Privilege requestPrivilege;
+        bool allowed;
+    };
+
+    // Returns CHIP_ERROR_NOT_IMPLEMENTED if the check must go through CheckEntries.
+    CHIP_ERROR CheckCached(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                           Privilege requestPrivilege);
+    CompiledFabric * GetCompiledFabric(FabricIndex fabricIndex);
+    void InvalidateCache();
+
+    CompiledFabric mCompiledFabrics[CHIP_CONFIG_MAX_FABRICS];
+    size_t mNextCompiledFabric = 0;
+
+    // Most recently used first.
+    std::array<CachedDecision, CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE> mCachedDecisions;
+    size_t mCachedDecisionCount = 0;
+#else
+    void InvalidateCache() {}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
 private:
     Delegate * mDelegate = nullptr;
 
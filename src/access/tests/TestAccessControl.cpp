@@ -20,6 +20,7 @@
 #include "access/examples/ExampleAccessControlDelegate.h"
 
 #include <lib/core/CHIPCore.h>
+#include <lib/support/CHIPMem.h>
 
 #include <gtest/gtest.h>
 
@@ -421,7 +422,9 @@ constexpr DeviceTypeId invalidDeviceTypes[] = {
 class DeviceTypeResolver : public AccessControl::DeviceTypeResolver
 {
 public:
-    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return mIsDeviceTypeOnEndpoint; }
+
+    bool mIsDeviceTypeOnEndpoint = false;
 } testDeviceTypeResolver;
 
 // For testing, supports one subject and target, allows any value (valid or invalid)
@@ -1083,6 +1086,7 @@ public: // protected
     void SetUp() override { ASSERT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR); }
     static void SetUpTestSuite()
     {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
         AccessControl::Delegate * delegate = Examples::GetAccessControlDelegate();
         SetAccessControl(accessControl);
         VerifyOrDie(GetAccessControl().Init(delegate, testDeviceTypeResolver) == CHIP_NO_ERROR);
@@ -1091,6 +1095,7 @@ public: // protected
     {
         GetAccessControl().Finish();
         ResetAccessControlToDefault();
+        chip::Platform::MemoryShutdown();
     }
 };
 
@@ -1755,6 +1760,71 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestCheckAfterChanges)
+{
+    LoadAccessControl(accessControl, entryData1, entryData1Count);
+
+    // Checking twice must give the same results, whether or not decisions are remembered.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (const auto & checkData : checkData1)
+        {
+            CHIP_ERROR expectedResult = checkData.allow ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+            EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, checkData.requestPath, checkData.privilege), expectedResult);
+        }
+    }
+
+    const SubjectDescriptor subjectDescriptor = { .fabricIndex = 3, .authMode = AuthMode::kCase, .subject = kOperationalNodeId5 };
+    const RequestPath requestPath             = { .cluster = kColorControlCluster, .endpoint = 3 };
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_ERROR_ACCESS_DENIED);
+
+    // Entries are released before checking, since the example delegate has a single entry delegate.
+    size_t index     = 0;
+    auto writeEntry = [&index](bool create, Privilege privilege, const Target & target) {
+        Entry entry;
+        EXPECT_EQ(accessControl.PrepareEntry(entry), CHIP_NO_ERROR);
+        EXPECT_EQ(entry.SetFabricIndex(3), CHIP_NO_ERROR);
+        EXPECT_EQ(entry.SetAuthMode(AuthMode::kCase), CHIP_NO_ERROR);
+        EXPECT_EQ(entry.SetPrivilege(privilege), CHIP_NO_ERROR);
+        EXPECT_EQ(entry.AddSubject(nullptr, kOperationalNodeId5), CHIP_NO_ERROR);
+        EXPECT_EQ(entry.AddTarget(nullptr, target), CHIP_NO_ERROR);
+        if (create)
+        {
+            EXPECT_EQ(accessControl.CreateEntry(nullptr, 3, &index, entry), CHIP_NO_ERROR);
+        }
+        else
+        {
+            EXPECT_EQ(accessControl.UpdateEntry(nullptr, 3, index, entry), CHIP_NO_ERROR);
+        }
+    };
+    const Target clusterTarget    = { .flags = Target::kCluster, .cluster = kColorControlCluster };
+    const Target deviceTypeTarget = { .flags = Target::kDeviceType, .deviceType = 0x0000'0100 };
+
+    // A new entry takes effect immediately (on a fabric without entries, to stay within the per-fabric limit).
+    writeEntry(true, Privilege::kOperate, clusterTarget);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_NO_ERROR);
+
+    // So does an update.
+    writeEntry(false, Privilege::kView, clusterTarget);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_ERROR_ACCESS_DENIED);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_NO_ERROR);
+
+    // Targeting a device type makes the decision depend on the endpoint's device types.
+    writeEntry(false, Privilege::kView, deviceTypeTarget);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_ERROR_ACCESS_DENIED);
+    testDeviceTypeResolver.mIsDeviceTypeOnEndpoint = true;
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_NO_ERROR);
+    testDeviceTypeResolver.mIsDeviceTypeOnEndpoint = false;
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_ERROR_ACCESS_DENIED);
+
+    // And a deletion, through the delegate interface.
+    writeEntry(false, Privilege::kView, clusterTarget);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_NO_ERROR);
+    FabricIndex fabricIndex = 3;
+    EXPECT_EQ(accessControl.DeleteEntry(index, &fabricIndex), CHIP_NO_ERROR);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_ERROR_ACCESS_DENIED);
+}
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
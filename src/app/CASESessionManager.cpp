@@ -19,18 +19,28 @@
 #include <app/CASESessionManager.h>
 #include <lib/address_resolve/AddressResolve.h>
 
+#include <algorithm>
+
 namespace chip {
 
 CHIP_ERROR CASESessionManager::Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params)
 {
     ReturnErrorOnFailure(params.sessionInitParams.Validate());
-    mConfig = params;
+    mConfig      = params;
+    mSystemLayer = systemLayer;
     params.sessionInitParams.exchangeMgr->GetReliableMessageMgr()->RegisterSessionUpdateDelegate(this);
     return AddressResolve::Resolver::Instance().Init(systemLayer);
 }
 
 void CASESessionManager::Shutdown()
 {
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(HandleSessionSetupAdmissionTimer, this);
+        mSystemLayer = nullptr;
+    }
+    mQueuedSessionSetups.Clear();
+    mActiveSessionSetups.Clear();
     AddressResolve::Resolver::Instance().Shutdown();
 }
 
@@ -39,13 +49,14 @@ void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Cal
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                                 uint8_t attemptCount, Callback::Callback<OnDeviceConnectionRetry> * onRetry,
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
-                                                TransportPayloadCapability transportPayloadCapability)
+                                                TransportPayloadCapability transportPayloadCapability,
+                                                SessionSetupPriority priority)
 {
     FindOrEstablishSessionHelper(peerId, onConnection, onFailure, nullptr,
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                  attemptCount, onRetry,
 #endif
-                                 transportPayloadCapability);
+                                 transportPayloadCapability, priority);
 }
 
 void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
@@ -53,13 +64,14 @@ void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Cal
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                                 uint8_t attemptCount, Callback::Callback<OnDeviceConnectionRetry> * onRetry,
 #endif
-                                                TransportPayloadCapability transportPayloadCapability)
+                                                TransportPayloadCapability transportPayloadCapability,
+                                                SessionSetupPriority priority)
 {
     FindOrEstablishSessionHelper(peerId, onConnection, nullptr, onSetupFailure,
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                  attemptCount, onRetry,
 #endif
-                                 transportPayloadCapability);
+                                 transportPayloadCapability, priority);
 }
 
 void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
@@ -67,13 +79,14 @@ void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Cal
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                                 uint8_t attemptCount, Callback::Callback<OnDeviceConnectionRetry> * onRetry,
 #endif
-                                                TransportPayloadCapability transportPayloadCapability)
+                                                TransportPayloadCapability transportPayloadCapability,
+                                                SessionSetupPriority priority)
 {
     FindOrEstablishSessionHelper(peerId, onConnection, nullptr, nullptr,
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                  attemptCount, onRetry,
 #endif
-                                 transportPayloadCapability);
+                                 transportPayloadCapability, priority);
 }
 
 void CASESessionManager::FindOrEstablishSessionHelper(const ScopedNodeId & peerId,
@@ -83,16 +96,19 @@ void CASESessionManager::FindOrEstablishSessionHelper(const ScopedNodeId & peerI
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                                       uint8_t attemptCount, Callback::Callback<OnDeviceConnectionRetry> * onRetry,
 #endif
-                                                      TransportPayloadCapability transportPayloadCapability)
+                                                      TransportPayloadCapability transportPayloadCapability,
+                                                      SessionSetupPriority priority)
 {
     ChipLogDetail(CASESessionManager, "FindOrEstablishSession: PeerId = [%d:" ChipLogFormatX64 "]", peerId.GetFabricIndex(),
                   ChipLogValueX64(peerId.GetNodeId()));
 
     bool forAddressUpdate             = false;
+    bool isNewSessionSetup            = false;
     OperationalSessionSetup * session = FindExistingSessionSetup(peerId, forAddressUpdate);
     if (session == nullptr)
     {
         ChipLogDetail(CASESessionManager, "FindOrEstablishSession: No existing OperationalSessionSetup instance found");
+        isNewSessionSetup = true;
         session = mConfig.sessionSetupPool->Allocate(mConfig.sessionInitParams, mConfig.clientPool, peerId, this);
 
         if (session == nullptr)
@@ -112,6 +128,8 @@ void CASESessionManager::FindOrEstablishSessionHelper(const ScopedNodeId & peerI
         }
     }
 
+    session->RaisePriority(priority);
+
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
     session->UpdateAttemptCount(attemptCount);
     if (onRetry)
@@ -120,20 +138,40 @@ void CASESessionManager::FindOrEstablishSessionHelper(const ScopedNodeId & peerI
     }
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
 
-    if (onFailure != nullptr)
+    session->QueueConnect(onConnection, onFailure, onSetupFailure, transportPayloadCapability);
+
+    if (mQueuedSessionSetups.Contains(session))
     {
-        session->Connect(onConnection, onFailure, transportPayloadCapability);
+        // The callbacks will be called once the session setup is admitted and completes.
+        return;
     }
 
-    if (onSetupFailure != nullptr)
+    // Joining a session setup in progress, or attaching to an existing session, is not subject to admission.
+    if (isNewSessionSetup && !FindExistingSession(peerId, transportPayloadCapability).HasValue())
     {
-        session->Connect(onConnection, onSetupFailure, transportPayloadCapability);
+        System::Clock::Timestamp retryTime;
+        if (!mQueuedSessionSetups.Empty() || !HasSessionSetupCapacity() ||
+            IsBackingOff(peerId, System::SystemClock().GetMonotonicTimestamp(), retryTime))
+        {
+            ChipLogProgress(CASESessionManager, "FindOrEstablishSession: Queueing session setup with [%u:" ChipLogFormatX64 "]",
+                            peerId.GetFabricIndex(), ChipLogValueX64(peerId.GetNodeId()));
+            mQueuedSessionSetups.PushBack(session);
+            ScheduleSessionSetupAdmission();
+            return;
+        }
+
+        mActiveSessionSetups.PushBack(session);
     }
+
+    StartSessionSetup(session);
 }
 
 void CASESessionManager::ReleaseSessionsForFabric(FabricIndex fabricIndex)
 {
     mConfig.sessionSetupPool->ReleaseAllSessionSetupsForFabric(fabricIndex);
+
+    // Released session setups free their slots for queued ones.
+    ScheduleSessionSetupAdmission();
 }
 
 void CASESessionManager::ReleaseAllSessions()
@@ -188,12 +226,180 @@ Optional<SessionHandle> CASESessionManager::FindExistingSession(const ScopedNode
         peerId, MakeOptional(Transport::SecureSession::Type::kCASE), transportPayloadCapability);
 }
 
-void CASESessionManager::ReleaseSession(OperationalSessionSetup * session)
+void CASESessionManager::ReleaseSession(OperationalSessionSetup * session, CHIP_ERROR error)
 {
     if (session != nullptr)
     {
+        if (mActiveSessionSetups.Contains(session))
+        {
+            RecordSessionSetupResult(session->GetPeerId(), error == CHIP_NO_ERROR);
+
+            // Releasing the session setup frees its slot for a queued one.
+            ScheduleSessionSetupAdmission();
+        }
         mConfig.sessionSetupPool->Release(session);
     }
 }
 
+void CASESessionManager::StartSessionSetup(OperationalSessionSetup * session)
+{
+    session->ConnectQueued();
+}
+
+CASESessionManager::SessionSetupCounters CASESessionManager::GetSessionSetupCounters() const
+{
+    SessionSetupCounters counters;
+    counters.queued = CountSessionSetups(mQueuedSessionSetups);
+    counters.active = CountSessionSetups(mActiveSessionSetups);
+    counters.failed = mFailedSessionSetups;
+    return counters;
+}
+
+size_t CASESessionManager::CountSessionSetups(const SessionSetupList & list)
+{
+    size_t count = 0;
+    for (auto it = list.begin(); it != list.end(); ++it)
+    {
+        count++;
+    }
+    return count;
+}
+
+bool CASESessionManager::HasSessionSetupCapacity() const
+{
+    return mConfig.maxConcurrentSessionSetups == 0 ||
+        CountSessionSetups(mActiveSessionSetups) < mConfig.maxConcurrentSessionSetups;
+}
+
+bool CASESessionManager::IsBackingOff(const ScopedNodeId & peerId, System::Clock::Timestamp now,
+                                      System::Clock::Timestamp & retryTime) const
+{
+    for (const auto & backoff : mSessionSetupBackoffs)
+    {
+        if (backoff.failureCount > 0 && backoff.peerId == peerId)
+        {
+            retryTime = backoff.retryTime;
+            return retryTime > now;
+        }
+    }
+    return false;
+}
+
+void CASESessionManager::RecordSessionSetupResult(const ScopedNodeId & peerId, bool succeeded)
+{
+    SessionSetupBackoff * entry = nullptr;
+    for (auto & backoff : mSessionSetupBackoffs)
+    {
+        if (backoff.failureCount > 0 && backoff.peerId == peerId)
+        {
+            entry = &backoff;
+            break;
+        }
+    }
+
+    if (succeeded)
+    {
+        if (entry != nullptr)
+        {
+            entry->failureCount = 0;
+        }
+        return;
+    }
+
+    mFailedSessionSetups++;
+    VerifyOrReturn(mConfig.sessionSetupBackoffInitialDelay != System::Clock::kZero);
+
+    if (entry == nullptr)
+    {
+        // Take an unused entry, or else forget the node whose backoff ends first.
+        entry = &mSessionSetupBackoffs[0];
+        for (auto & backoff : mSessionSetupBackoffs)
+        {
+            if (backoff.failureCount == 0)
+            {
+                entry = &backoff;
+                break;
+            }
+            if (backoff.retryTime < entry->retryTime)
+            {
+                entry = &backoff;
+            }
+        }
+        entry->peerId       = peerId;
+        entry->failureCount = 0;
+    }
+
+    if (entry->failureCount < UINT8_MAX)
+    {
+        entry->failureCount++;
+    }
+
+    unsigned shift = std::min<unsigned>(entry->failureCount - 1u, CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT);
+    System::Clock::Timestamp delay = System::Clock::Timestamp(mConfig.sessionSetupBackoffInitialDelay) * (1u << shift);
+    entry->retryTime               = System::SystemClock().GetMonotonicTimestamp() + delay;
+
+    ChipLogProgress(CASESessionManager, "Backing off from session setup with [%u:" ChipLogFormatX64 "] for %" PRIu32 "ms",
+                    peerId.GetFabricIndex(), ChipLogValueX64(peerId.GetNodeId()), static_cast<uint32_t>(delay.count()));
+}
+
+void CASESessionManager::ScheduleSessionSetupAdmission()
+{
+    VerifyOrReturn(mSystemLayer != nullptr && !mQueuedSessionSetups.Empty());
+
+    // Admit from the event loop, so that no session setup is started from within the callbacks of another one.
+    LogErrorOnFailure(mSystemLayer->StartTimer(System::Clock::kZero, HandleSessionSetupAdmissionTimer, this));
+}
+
+void CASESessionManager::HandleSessionSetupAdmissionTimer(System::Layer * systemLayer, void * appState)
+{
+    static_cast<CASESessionManager *>(appState)->AdmitQueuedSessionSetups();
+}
+
+void CASESessionManager::AdmitQueuedSessionSetups()
+{
+    System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    while (HasSessionSetupCapacity())
+    {
+        OperationalSessionSetup * next = nullptr;
+        Optional<System::Clock::Timestamp> nextRetryTime;
+
+        for (auto & setup : mQueuedSessionSetups)
+        {
+            System::Clock::Timestamp retryTime;
+            if (IsBackingOff(setup.GetPeerId(), now, retryTime))
+            {
+                if (!nextRetryTime.HasValue() || retryTime < nextRetryTime.Value())
+                {
+                    nextRetryTime.SetValue(retryTime);
+                }
+                continue;
+            }
+
+            // The queue is in FIFO order, so only a setup with a higher priority overtakes the first one found.
+            if (next == nullptr || setup.GetPriority() > next->GetPriority())
+            {
+                next = &setup;
+            }
+        }
+
+        if (next == nullptr)
+        {
+            if (nextRetryTime.HasValue())
+            {
+                auto delay = std::chrono::duration_cast<System::Clock::Timeout>(nextRetryTime.Value() - now);
+                LogErrorOnFailure(mSystemLayer->StartTimer(delay, HandleSessionSetupAdmissionTimer, this));
+            }
+            return;
+        }
+
+        ChipLogProgress(CASESessionManager, "Admitting queued session setup with [%u:" ChipLogFormatX64 "]", next->GetFabricIndex(),
+                        ChipLogValueX64(next->GetPeerId().GetNodeId()));
+        mQueuedSessionSetups.Remove(next);
+        mActiveSessionSetups.PushBack(next);
+        StartSessionSetup(next);
+        // Do not touch `next` anymore; it may have completed, and been released, already.
+    }
+}
+
 } // namespace chip
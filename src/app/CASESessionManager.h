@@ -23,6 +23,7 @@
 #include <app/OperationalSessionSetupPool.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPCore.h>
+#include <lib/support/IntrusiveList.h>
 #include <lib/support/Pool.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <transport/SessionDelegate.h>
@@ -36,6 +37,13 @@ struct CASESessionManagerConfig
     CASEClientInitParams sessionInitParams;
     CASEClientPoolDelegate * clientPool                    = nullptr;
     OperationalSessionSetupPoolDelegate * sessionSetupPool = nullptr;
+
+    // Number of session setups run at once; further ones are queued until one completes.  0 means no limit.
+    uint16_t maxConcurrentSessionSetups = 0;
+
+    // Time to wait before setting up a session with a node again after a failed session setup, doubled with every further
+    // failure.  0 disables the backoff.
+    System::Clock::Milliseconds32 sessionSetupBackoffInitialDelay = System::Clock::kZero;
 };
 
 /**
@@ -45,10 +53,20 @@ struct CASESessionManagerConfig
  * 3. API to lookup an existing proxy object, or allocate a new one by triggering session establishment with the peer node.
  * 4. During session establishment, trigger node ID resolution (if needed), and update the DNS-SD cache (if resolution is
  * successful)
+ * 5. Admission of new session setups: at most maxConcurrentSessionSetups of them run at once, the others are queued and
+ * started by priority as running ones complete.  After a failed session setup with a node, new session setups with that
+ * node are held back, for a delay growing exponentially with the number of consecutive failures.
  */
 class CASESessionManager : public OperationalSessionReleaseDelegate, public SessionUpdateDelegate
 {
 public:
+    struct SessionSetupCounters
+    {
+        size_t queued   = 0; // Session setups waiting to be admitted.
+        size_t active   = 0; // Session setups admitted and not completed yet.
+        uint32_t failed = 0; // Admitted session setups that failed, in total.
+    };
+
     CASESessionManager() = default;
     virtual ~CASESessionManager()
     {
@@ -56,6 +74,8 @@ public:
         {
             mConfig.sessionInitParams.exchangeMgr->GetReliableMessageMgr()->RegisterSessionUpdateDelegate(nullptr);
         }
+        mQueuedSessionSetups.Clear();
+        mActiveSessionSetups.Clear();
     }
 
     CHIP_ERROR Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params);
@@ -77,13 +97,17 @@ public:
      *
      * attemptCount can be used to automatically retry multiple times if session
      * setup is not successful.
+     *
+     * priority decides which queued session setup is started first, when the
+     * number of concurrent session setups is limited.
      */
     void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
                                 Callback::Callback<OnDeviceConnectionFailure> * onFailure,
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                 uint8_t attemptCount = 1, Callback::Callback<OnDeviceConnectionRetry> * onRetry = nullptr,
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
-                                TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload);
+                                TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload,
+                                SessionSetupPriority priority                         = SessionSetupPriority::kNormal);
 
     /**
      * Find an existing session for the given node ID or trigger a new session request.
@@ -107,13 +131,15 @@ public:
      * @param attemptCount The number of retry attempts if session setup fails (default is 1).
      * @param onRetry A callback to be called on a retry attempt (enabled by a config flag).
      * @param transportPayloadCapability An indicator of what payload types the session needs to be able to transport.
+     * @param priority The priority of the session setup, if it needs to be queued.
      */
     void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
                                 Callback::Callback<OperationalSessionSetup::OnSetupFailure> * onSetupFailure,
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                 uint8_t attemptCount = 1, Callback::Callback<OnDeviceConnectionRetry> * onRetry = nullptr,
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
-                                TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload);
+                                TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload,
+                                SessionSetupPriority priority                         = SessionSetupPriority::kNormal);
 
     /**
      * Find an existing session for the given node ID or trigger a new session request.
@@ -135,12 +161,14 @@ public:
      * @param attemptCount The number of retry attempts if session setup fails (default is 1).
      * @param onRetry A callback to be called on a retry attempt (enabled by a config flag).
      * @param transportPayloadCapability An indicator of what payload types the session needs to be able to transport.
+     * @param priority The priority of the session setup, if it needs to be queued.
      */
     void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection, std::nullptr_t,
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                 uint8_t attemptCount = 1, Callback::Callback<OnDeviceConnectionRetry> * onRetry = nullptr,
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
-                                TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload);
+                                TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload,
+                                SessionSetupPriority priority                         = SessionSetupPriority::kNormal);
 
     void ReleaseSessionsForFabric(FabricIndex fabricIndex);
 
@@ -157,12 +185,19 @@ public:
     CHIP_ERROR GetPeerAddress(const ScopedNodeId & peerId, Transport::PeerAddress & addr,
                               TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload);
 
+    SessionSetupCounters GetSessionSetupCounters() const;
+
     //////////// OperationalSessionReleaseDelegate Implementation ///////////////
-    void ReleaseSession(OperationalSessionSetup * device) override;
+    void ReleaseSession(OperationalSessionSetup * device, CHIP_ERROR error) override;
 
     //////////// SessionUpdateDelegate Implementation ///////////////
     void UpdatePeerAddress(ScopedNodeId peerId) override;
 
+protected:
+    // Starts the session setup with the callbacks queued on it, or joins them to it if it is already in progress.  Tests
+    // override this to complete session setups themselves.
+    virtual void StartSessionSetup(OperationalSessionSetup * session);
+
 private:
     OperationalSessionSetup * FindExistingSessionSetup(const ScopedNodeId & peerId, bool forAddressUpdate = false) const;
 
@@ -176,9 +211,36 @@ private:
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
                                       uint8_t attemptCount, Callback::Callback<OnDeviceConnectionRetry> * onRetry,
 #endif
-                                      TransportPayloadCapability transportPayloadCapability);
+                                      TransportPayloadCapability transportPayloadCapability, SessionSetupPriority priority);
+
+    using SessionSetupList = IntrusiveList<OperationalSessionSetup, IntrusiveMode::AutoUnlink>;
+
+    struct SessionSetupBackoff
+    {
+        ScopedNodeId peerId;
+        System::Clock::Timestamp retryTime;
+        uint8_t failureCount = 0; // Consecutive failures; 0 if the entry is unused.
+    };
+
+    static size_t CountSessionSetups(const SessionSetupList & list);
+    static void HandleSessionSetupAdmissionTimer(System::Layer * systemLayer, void * appState);
+
+    bool HasSessionSetupCapacity() const;
+    bool IsBackingOff(const ScopedNodeId & peerId, System::Clock::Timestamp now, System::Clock::Timestamp & retryTime) const;
+    void RecordSessionSetupResult(const ScopedNodeId & peerId, bool succeeded);
+    void ScheduleSessionSetupAdmission();
+    void AdmitQueuedSessionSetups();
 
     CASESessionManagerConfig mConfig;
+    System::Layer * mSystemLayer = nullptr;
+
+    // Session setups waiting to be admitted, in the order they were queued, and the admitted ones not completed yet.
+    // Released session setups unlink themselves.
+    SessionSetupList mQueuedSessionSetups;
+    SessionSetupList mActiveSessionSetups;
+
+    SessionSetupBackoff mSessionSetupBackoffs[CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_TABLE_SIZE];
+    uint32_t mFailedSessionSetups = 0;
 };
 
 } // namespace chip
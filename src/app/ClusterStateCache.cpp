@@ -172,7 +172,11 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
 
     if (mCacheData)
     {
+#if CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+        mChangedAttributeSet.push_back(aPath);
+#else
         mChangedAttributeSet.insert(aPath);
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
     }
 
     return CHIP_NO_ERROR;
@@ -259,6 +263,12 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     std::set<std::tuple<EndpointId, ClusterId>> changedClusters;
 
+#if CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+    // Match the ordering and uniqueness of the std::set this replaces.
+    std::sort(mChangedAttributeSet.begin(), mChangedAttributeSet.end());
+    mChangedAttributeSet.erase(std::unique(mChangedAttributeSet.begin(), mChangedAttributeSet.end()), mChangedAttributeSet.end());
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+
     //
     // Add the EndpointId and ClusterId into a set so that we only
     // convey unique combinations in the subsequent OnClusterChanged callback.
@@ -27,7 +27,9 @@
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
+#include <lib/core/CHIPConfig.h>
 #include <lib/support/Variant.h>
+#include <algorithm>
 #include <list>
 #include <map>
 #include <queue>
@@ -438,7 +440,7 @@ public:
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
         auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        if (endpointIter != mCache.end())
         {
             for (auto & clusterIter : endpointIter->second)
             {
@@ -534,6 +536,8 @@ public:
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
 private:
+    friend class TestClusterStateCacheStorage;
+
     // An attribute state can be one of three things:
     // * If we got a path-specific error for the attribute, the corresponding
     //   status.
@@ -548,6 +552,83 @@ private:
     // quite a bit of space.
     using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
     using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
+
+#if CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+    // Provides the subset of the std::map interface used by the cache on top of a vector of entries sorted by key.
+    // Each level of the cache is then a single allocation that can be binary searched, instead of a tree node per
+    // entry.  Entries move on insertion, so references into a FlatMap must not be held across insertions; attribute
+    // data itself lives in separately allocated buffers and is not affected.
+    template <typename Key, typename Value>
+    class FlatMap
+    {
+    public:
+        struct Entry
+        {
+            explicit Entry(Key key) : first(key) {}
+
+            // Our values are only nothrow-movable in practice (Variant does not declare it), so say so explicitly to
+            // keep std::vector from falling back to copying entries when it grows.
+            Entry(Entry && other) noexcept : first(other.first), second(std::move(other.second)) {}
+            Entry & operator=(Entry && other) noexcept
+            {
+                first  = other.first;
+                second = std::move(other.second);
+                return *this;
+            }
+
+            Entry(const Entry &)             = delete;
+            Entry & operator=(const Entry &) = delete;
+
+            Key first;
+            Value second;
+        };
+
+        using iterator       = typename std::vector<Entry>::iterator;
+        using const_iterator = typename std::vector<Entry>::const_iterator;
+
+        iterator begin() { return mEntries.begin(); }
+        iterator end() { return mEntries.end(); }
+        const_iterator begin() const { return mEntries.begin(); }
+        const_iterator end() const { return mEntries.end(); }
+
+        iterator find(Key key) { return Find(mEntries, key); }
+        const_iterator find(Key key) const { return Find(mEntries, key); }
+
+        Value & operator[](Key key)
+        {
+            auto iter = LowerBound(mEntries, key);
+            if (iter == mEntries.end() || iter->first != key)
+            {
+                iter = mEntries.emplace(iter, key);
+            }
+            return iter->second;
+        }
+
+    private:
+        template <typename Entries>
+        static auto LowerBound(Entries & entries, Key key)
+        {
+            return std::lower_bound(entries.begin(), entries.end(), key,
+                                    [](const Entry & entry, Key value) { return entry.first < value; });
+        }
+
+        template <typename Entries>
+        static auto Find(Entries & entries, Key key)
+        {
+            auto iter = LowerBound(entries, key);
+            return (iter != entries.end() && iter->first == key) ? iter : entries.end();
+        }
+
+        std::vector<Entry> mEntries;
+    };
+
+    template <typename Key, typename Value>
+    using StateMap = FlatMap<Key, Value>;
+#else
+    template <typename Key, typename Value>
+    using StateMap = std::map<Key, Value>;
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+
     // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
     //
     // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
@@ -555,12 +636,12 @@ private:
     // and we must not be in the middle of receiving reports for that cluster.
     struct ClusterState
     {
-        std::map<AttributeId, AttributeState> mAttributes;
+        StateMap<AttributeId, AttributeState> mAttributes;
         Optional<DataVersion> mPendingDataVersion;
         Optional<DataVersion> mCommittedDataVersion;
     };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    using EndpointState = StateMap<ClusterId, ClusterState>;
+    using NodeState     = StateMap<EndpointId, EndpointState>;
 
     struct Comparator
     {
@@ -675,7 +756,12 @@ private:
 
     Callback & mCallback;
     NodeState mCache;
+#if CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+    // May contain duplicates until it is sorted and deduplicated in OnReportEnd().
+    std::vector<ConcreteAttributePath> mChangedAttributeSet;
+#else
     std::set<ConcreteAttributePath> mChangedAttributeSet;
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
 
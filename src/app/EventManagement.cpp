@@ -66,6 +66,7 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventNumber mEventNumber            = 0;
 };
 
 /**
@@ -108,7 +109,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
 
         current = &apCircularEventBuffer[bufferIndex];
         current->Init(apLogStorageResources[bufferIndex].mpBuffer, apLogStorageResources[bufferIndex].mBufferSize, prev, next,
-                      apLogStorageResources[bufferIndex].mPriority);
+                      apLogStorageResources[bufferIndex].mPriority, apLogStorageResources[bufferIndex].mpPersistedState);
 
         prev = current;
 
@@ -124,9 +125,84 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mBytesWritten = 0;
 
     mMonotonicStartupTime = aMonotonicStartupTime;
+
+    RestoreEvents();
+}
+
+CHIP_ERROR EventManagement::GetEventNumber(const TLVReader & aReader, EventNumber & aEventNumber)
+{
+    TLVReader reader;
+    TLVType containerType;
+    TLVType containerType1;
+    EventEnvelopeContext event;
+
+    reader.Init(aReader);
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    ReturnErrorOnFailure(reader.Next(TLV::ContextTag(EventReportIB::Tag::kEventData)));
+    ReturnErrorOnFailure(reader.EnterContainer(containerType1));
+    CHIP_ERROR err = TLV::Utilities::Iterate(reader, FetchEventParameters, &event, false /*recurse*/);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+    VerifyOrReturnError(event.mFieldsToRead == kRequiredEventField, CHIP_ERROR_INVALID_ARGUMENT);
+
+    aEventNumber = event.mEventNumber;
+    return CHIP_NO_ERROR;
+}
+
+void EventManagement::RestoreEvents()
+{
+    bool hasPreviousEvent        = false;
+    EventNumber previousEvent    = 0;
+    CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical);
+
+    // Buffers are walked from the most important one, which holds the oldest events, to the least important one, so the
+    // event numbers must increase all along.
+    for (; buffer != nullptr; buffer = buffer->GetPreviousCircularEventBuffer())
+    {
+        CircularTLVReader reader;
+        EventNumber eventNumber;
+        uint32_t validLength = 0;
+
+        // Moving an event to the next buffer copies it before evicting it; if the process stopped in between, the head of
+        // this buffer still holds the moved event.
+        while (hasPreviousEvent && buffer->DataLength() != 0)
+        {
+            reader.Init(*buffer);
+            if (reader.Next() != CHIP_NO_ERROR || GetEventNumber(reader, eventNumber) != CHIP_NO_ERROR ||
+                eventNumber > previousEvent || buffer->EvictHead() != CHIP_NO_ERROR)
+            {
+                break;
+            }
+        }
+
+        reader.Init(*buffer);
+        while (reader.Next() == CHIP_NO_ERROR && GetEventNumber(reader, eventNumber) == CHIP_NO_ERROR &&
+               (!hasPreviousEvent || eventNumber > previousEvent) && eventNumber < mLastEventNumber &&
+               reader.Skip() == CHIP_NO_ERROR)
+        {
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+            buffer->IndexEvent(eventNumber, reader.GetLengthRead() - validLength);
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+            validLength      = reader.GetLengthRead();
+            previousEvent    = eventNumber;
+            hasPreviousEvent = true;
+        }
+
+        if (validLength != buffer->DataLength())
+        {
+            ChipLogError(EventLogging, "Dropped %" PRIu32 " bytes of invalid events from buffer with priority %u",
+                         buffer->DataLength() - validLength, static_cast<unsigned>(buffer->GetPriority()));
+            buffer->TruncateData(validLength);
+        }
+        else if (validLength != 0)
+        {
+            ChipLogProgress(EventLogging, "Restored %" PRIu32 " bytes of events in buffer with priority %u", validLength,
+                            static_cast<unsigned>(buffer->GetPriority()));
+        }
+        buffer->PersistState();
+    }
 }
 
-CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
+CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer, EventNumber aEventNumber)
 {
     CircularTLVWriter writer;
     CircularTLVReader reader;
@@ -155,6 +231,11 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = writer.Finalize();
     SuccessOrExit(err);
 
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    nextBuffer->IndexEvent(aEventNumber, writer.GetLengthWritten());
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    nextBuffer->PersistState();
+
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
     if (err != CHIP_NO_ERROR)
@@ -217,7 +298,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    err = CopyToNextBuffer(eventBuffer, ctx.mEventNumber);
                     SuccessOrExit(err);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
@@ -228,6 +309,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->PersistState();
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -244,6 +326,10 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                 VerifyOrExit(eventBuffer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
                 requiredSpace = ctx.mSpaceNeededForMovedEvent;
             }
+            else
+            {
+                eventBuffer->PersistState();
+            }
         }
         else
         {
@@ -380,14 +466,18 @@ CHIP_ERROR EventManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, si
         // Does not go on the wire.
         return CHIP_NO_ERROR;
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    // Timestamps can go backwards, e.g. system timestamps of events restored from a persisted buffer are relative to an
+    // earlier boot; such events keep their absolute timestamp.
+    const bool useDeltaTime = !(ctx->mpContext->mFirst) &&
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue);
+
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && useDeltaTime)
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && useDeltaTime)
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
@@ -468,6 +558,11 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    mpEventBuffer->IndexEvent(ctxt.mCurrentEventNumber, writer.GetLengthWritten());
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    mpEventBuffer->PersistState();
+
     mBytesWritten += writer.GetLengthWritten();
 
 exit:
@@ -652,7 +747,28 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    // The reader walks the buffers from the most important one, which holds the oldest events, to the least important one.
+    // Seek past the events the index knows to be older than aEventMin instead of parsing them.
+    for (auto * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer        = buffer->GetPreviousCircularEventBuffer())
+    {
+        const uint32_t skipLength = buffer->GetIndexedSkipLength(aEventMin);
+        bufWrapper.mSkipLength += skipLength;
+        if (skipLength < buffer->DataLength())
+        {
+            break;
+        }
+        if (skipLength != 0)
+        {
+            // Report the skipped events as seen, like the full walk would have.
+            context.mCurrentEventNumber = buffer->GetNewestEventNumber();
+        }
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+
+    err = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
@@ -841,6 +957,7 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     // event is not getting dropped. Note how much space it requires, and return.
     ctx->mSpaceNeededForMovedEvent = aReader.GetLengthRead();
+    ctx->mEventNumber              = context.mEventNumber;
     return CHIP_END_OF_TLV;
 }
 
@@ -851,12 +968,114 @@ void EventManagement::SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t
 }
 
 void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, CircularEventBuffer * apPrev,
-                               CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
+                               CircularEventBuffer * apNext, PriorityLevel aPriorityLevel,
+                               PersistedEventBufferState * apPersistedState)
 {
     TLVCircularBuffer::Init(apBuffer, aBufferLength);
-    mpPrev    = apPrev;
-    mpNext    = apNext;
-    mPriority = aPriorityLevel;
+    mpPrev           = apPrev;
+    mpNext           = apNext;
+    mPriority        = aPriorityLevel;
+    mpPersistedState = apPersistedState;
+
+    if (mpPersistedState != nullptr)
+    {
+        // The events are validated by EventManagement::Init; only make sure the state fits in the buffer.
+        const uint64_t state      = mpPersistedState->load();
+        const uint32_t headOffset = static_cast<uint32_t>(state >> 32);
+        const uint32_t dataLength = static_cast<uint32_t>(state);
+        if (headOffset < aBufferLength && dataLength <= aBufferLength)
+        {
+            SetQueueState(headOffset, dataLength);
+        }
+    }
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    mEventNumberIndexFirst = 0;
+    mEventNumberIndexCount = 0;
+    mTailPosition          = 0;
+    mNewestEventNumber     = 0;
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+}
+
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+void CircularEventBuffer::IndexEvent(EventNumber aEventNumber, uint32_t aEventLength)
+{
+    constexpr size_t kIndexSize = CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE;
+    const uint32_t position     = mTailPosition;
+
+    mTailPosition += aEventLength;
+    mNewestEventNumber = aEventNumber;
+
+    PruneEventNumberIndex();
+
+    // Keep the entries spread over the whole buffer.
+    if (mEventNumberIndexCount != 0)
+    {
+        const auto & newest = mEventNumberIndex[(mEventNumberIndexFirst + mEventNumberIndexCount - 1) % kIndexSize];
+        if (position - newest.mPosition < GetTotalDataLength() / kIndexSize)
+        {
+            return;
+        }
+    }
+
+    if (mEventNumberIndexCount == kIndexSize)
+    {
+        mEventNumberIndexFirst = (mEventNumberIndexFirst + 1) % kIndexSize;
+        mEventNumberIndexCount--;
+    }
+    mEventNumberIndex[(mEventNumberIndexFirst + mEventNumberIndexCount) % kIndexSize] = { aEventNumber, position };
+    mEventNumberIndexCount++;
+}
+
+uint32_t CircularEventBuffer::GetIndexedSkipLength(EventNumber aEventMin)
+{
+    PruneEventNumberIndex();
+
+    if (DataLength() == 0 || mNewestEventNumber < aEventMin)
+    {
+        return DataLength();
+    }
+
+    // Events are stored in increasing event number order, so everything before the last indexed event numbered at most
+    // aEventMin is older than aEventMin.
+    uint32_t skipLength = 0;
+    for (size_t i = 0; i < mEventNumberIndexCount; i++)
+    {
+        const auto & entry = mEventNumberIndex[(mEventNumberIndexFirst + i) % CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE];
+        if (entry.mEventNumber > aEventMin)
+        {
+            break;
+        }
+        skipLength = entry.mPosition - GetHeadPosition();
+    }
+    return skipLength;
+}
+
+void CircularEventBuffer::PruneEventNumberIndex()
+{
+    // Drop the entries of events that have been evicted from the head of the buffer.  An evicted event has a position below
+    // the head, which wraps around to a distance larger than the data length.
+    while (mEventNumberIndexCount != 0 &&
+           mEventNumberIndex[mEventNumberIndexFirst].mPosition - GetHeadPosition() >= DataLength())
+    {
+        mEventNumberIndexFirst = (mEventNumberIndexFirst + 1) % CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE;
+        mEventNumberIndexCount--;
+    }
+}
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+
+void CircularEventBuffer::PersistState()
+{
+    if (mpPersistedState != nullptr)
+    {
+        const uint32_t headOffset = static_cast<uint32_t>(QueueHead() - GetQueue());
+        mpPersistedState->store((static_cast<uint64_t>(headOffset) << 32) | DataLength());
+    }
+}
+
+void CircularEventBuffer::TruncateData(uint32_t aDataLength)
+{
+    VerifyOrReturn(aDataLength < DataLength());
+    SetQueueState(static_cast<uint32_t>(QueueHead() - GetQueue()), aDataLength);
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -905,6 +1124,17 @@ CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const
         aBufStart = nullptr;
         err       = GetNextBuffer(aReader, aBufStart, aBufLen);
     }
+    else if ((mSkipLength != 0) && (aBufLen != 0))
+    {
+        const uint32_t skipLength = (mSkipLength < aBufLen) ? mSkipLength : aBufLen;
+        mSkipLength -= skipLength;
+        aBufStart += skipLength;
+        aBufLen -= skipLength;
+        if (aBufLen == 0)
+        {
+            err = GetNextBuffer(aReader, aBufStart, aBufLen);
+        }
+    }
 
 exit:
     return err;
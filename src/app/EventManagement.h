@@ -39,6 +39,8 @@
 #include <platform/CHIPDeviceConfig.h>
 #include <system/SystemClock.h>
 
+#include <atomic>
+
 /**
  * Events are stored in the LogStorageResources provided to
  * EventManagement::Init.
@@ -76,6 +78,15 @@ inline constexpr size_t kMaxEventSizeReserve            = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   Where the position of the events in an event buffer that outlives the process, e.g. a memory-mapped file, is recorded.
+ *
+ * The head offset (upper 32 bits) and the data length (lower 32 bits) are packed in a single word, so that it always
+ * describes a consistent run of complete events, whenever the process stops.
+ */
+using PersistedEventBufferState = std::atomic<uint64_t>;
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -105,9 +116,12 @@ public:
      *                           events of greater priority.
      *
      * @param[in] aPriorityLevel CircularEventBuffer priority level
+     *
+     * @param[in] apPersistedState Optional persisted state of \c apBuffer.  When provided, the events it describes are kept and
+     *                             the state is updated whenever the buffer changes.
      */
     void Init(uint8_t * apBuffer, uint32_t aBufferLength, CircularEventBuffer * apPrev, CircularEventBuffer * apNext,
-              PriorityLevel aPriorityLevel);
+              PriorityLevel aPriorityLevel, PersistedEventBufferState * apPersistedState = nullptr);
 
     /**
      * @brief
@@ -128,6 +142,44 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Record the current head and length of the buffer in its persisted state, if it has one.  Must only be called while the
+     *   buffer holds complete events.
+     */
+    void PersistState();
+
+    /**
+     * @brief
+     *   Drop the data past the first aDataLength bytes, e.g. a partial event at the end of restored data.
+     */
+    void TruncateData(uint32_t aDataLength);
+
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    /**
+     * @brief
+     *   Account for an event that has just been appended to this buffer, and add it to the event number index if it is far
+     *   enough from the last indexed event.  Every event appended to the buffer must be reported here, in order.
+     *
+     * @param[in] aEventNumber  The number of the appended event.
+     * @param[in] aEventLength  The encoded length of the appended event, in bytes.
+     */
+    void IndexEvent(EventNumber aEventNumber, uint32_t aEventLength);
+
+    /**
+     * @brief
+     *   Use the event number index to find how many bytes at the head of this buffer only hold events numbered below
+     *   aEventMin.  The returned length always ends on an event boundary, and is DataLength() if every stored event is older.
+     */
+    uint32_t GetIndexedSkipLength(EventNumber aEventMin);
+
+    /**
+     * @brief
+     *   The number of the newest event in this buffer.  Only meaningful when the buffer is not empty.
+     */
+    EventNumber GetNewestEventNumber() const { return mNewestEventNumber; }
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+
     ~CircularEventBuffer() override = default;
 
 private:
@@ -139,6 +191,26 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    PersistedEventBufferState * mpPersistedState = nullptr;
+
+#if CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+    struct EventNumberIndexEntry
+    {
+        EventNumber mEventNumber;
+        uint32_t mPosition; ///< Position of the event in the stream of bytes ever appended to the buffer
+    };
+
+    void PruneEventNumberIndex();
+    uint32_t GetHeadPosition() const { return mTailPosition - DataLength(); }
+
+    // Ring of index entries, oldest first.  Positions wrap modulo 2^32, which is fine since the buffer is much smaller.
+    EventNumberIndexEntry mEventNumberIndex[CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE];
+    size_t mEventNumberIndexFirst  = 0;
+    size_t mEventNumberIndexCount  = 0;
+    uint32_t mTailPosition         = 0; ///< Number of bytes ever appended to the buffer
+    EventNumber mNewestEventNumber = 0;
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
@@ -155,6 +227,7 @@ class CircularEventBufferWrapper : public TLV::TLVCircularBuffer
 public:
     CircularEventBufferWrapper() : TLVCircularBuffer(nullptr, 0), mpCurrent(nullptr){};
     CircularEventBuffer * mpCurrent;
+    uint32_t mSkipLength = 0; ///< Number of bytes to skip before handing data to the reader
 
 private:
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
@@ -187,6 +260,9 @@ struct LogStorageResources
     uint32_t mBufferSize = 0; ///< The size, in bytes, of the `mBuffer`.
     PriorityLevel mPriority =
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
+    // Optional.  When set, `mpBuffer` outlives the process: the events recorded in this state are restored on Init, and the
+    // state is kept up to date as events are logged and evicted.
+    PersistedEventBufferState * mpPersistedState = nullptr;
 };
 
 /**
@@ -437,8 +513,10 @@ private:
      *
      * @param[in] apEventBuffer  CircularEventBuffer
      *
+     * @param[in] aEventNumber   Event number of the head event of apEventBuffer
+     *
      */
-    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
+    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer, EventNumber aEventNumber);
 
     /**
      * @brief Ensure that:
@@ -535,6 +613,17 @@ private:
      */
     static CHIP_ERROR CopyEvent(const TLV::TLVReader & aReader, TLV::TLVWriter & aWriter, EventLoadOutContext * apContext);
 
+    /**
+     * @brief Read the number of the event the reader is positioned on, checking that the event is well formed.
+     */
+    static CHIP_ERROR GetEventNumber(const TLV::TLVReader & aReader, EventNumber & aEventNumber);
+
+    /**
+     * @brief Validate the events restored from persisted buffers on Init.  Only the well formed events numbered in increasing
+     * order, below the next event number, are kept.
+     */
+    void RestoreEvents();
+
     /**
      * @brief
      *   A function to get the circular buffer for particular priority
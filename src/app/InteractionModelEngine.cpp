@@ -1541,12 +1541,14 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
 void InteractionModelEngine::ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList)
 {
     ReleasePool(aAttributePathList, mAttributePathPool);
+    mReportingEngine.OnAttributePathListChanged();
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
                                                               AttributePathParams & aAttributePath)
 {
     CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool);
+    mReportingEngine.OnAttributePathListChanged();
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "AttributePath pool full");
@@ -1607,6 +1609,7 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedLi
             mAttributePathPool.ReleaseObject(path1);
             path1 = prev->mpNext;
         }
+        mReportingEngine.OnAttributePathListChanged();
     }
 }
 
@@ -413,6 +413,7 @@ public:
 
 private:
     friend class reporting::Engine;
+    friend class reporting::TestReportingEngine;
     friend class TestCommandInteraction;
     friend class TestInteractionModelEngine;
     friend class SubscriptionResumptionSessionEstablisher;
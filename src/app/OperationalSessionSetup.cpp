@@ -183,6 +183,15 @@ void OperationalSessionSetup::Connect(Callback::Callback<OnDeviceConnected> * on
     }
 }
 
+void OperationalSessionSetup::QueueConnect(Callback::Callback<OnDeviceConnected> * onConnection,
+                                           Callback::Callback<OnDeviceConnectionFailure> * onFailure,
+                                           Callback::Callback<OnSetupFailure> * onSetupFailure,
+                                           TransportPayloadCapability transportPayloadCapability)
+{
+    mTransportPayloadCapability = transportPayloadCapability;
+    EnqueueConnectionCallbacks(onConnection, onFailure, onSetupFailure);
+}
+
 void OperationalSessionSetup::Connect(Callback::Callback<OnDeviceConnected> * onConnection,
                                       Callback::Callback<OnDeviceConnectionFailure> * onFailure,
                                       TransportPayloadCapability transportPayloadCapability)
@@ -379,7 +388,7 @@ void OperationalSessionSetup::DequeueConnectionCallbacks(CHIP_ERROR error, Sessi
     if (releaseBehavior == ReleaseBehavior::Release)
     {
         VerifyOrDie(mReleaseDelegate != nullptr);
-        mReleaseDelegate->ReleaseSession(this);
+        mReleaseDelegate->ReleaseSession(this, error);
     }
 
     // DO NOT touch any members of this object after this point.  It's dead.
@@ -457,6 +466,13 @@ void OperationalSessionSetup::OnSessionEstablishmentError(CHIP_ERROR error, Sess
     VerifyOrReturn(mState == State::Connecting,
                    ChipLogError(Discovery, "OnSessionEstablishmentError was called while we were not connecting"));
 
+    // A busy peer was reached at the address we have; anything else may mean the address is stale, and a retry (or a
+    // later session setup) must not be handed the same one from a DNS-SD cache.
+    if (CHIP_ERROR_BUSY != error)
+    {
+        ForgetPeerAddress();
+    }
+
     // If this condition ever changes, we may need to store the error in a
     // member instead of having a boolean
     // mTryingNextResultDueToSessionEstablishmentError, so we can recover the
@@ -633,6 +649,14 @@ CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
     return Resolver::Instance().LookupNode(request, mAddressLookupHandle);
 }
 
+void OperationalSessionSetup::ForgetPeerAddress()
+{
+    auto const * fabricInfo = mInitParams.fabricTable->FindFabricWithIndex(mPeerId.GetFabricIndex());
+    VerifyOrReturn(fabricInfo != nullptr);
+
+    Dnssd::Resolver::Instance().ForgetNodeId(PeerId(fabricInfo->GetCompressedFabricId(), mPeerId.GetNodeId()));
+}
+
 void OperationalSessionSetup::PerformAddressUpdate()
 {
     if (mPerformingAddressUpdate)
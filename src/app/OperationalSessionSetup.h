@@ -33,6 +33,7 @@
 #include <app/util/basic-types.h>
 #include <credentials/GroupDataProvider.h>
 #include <lib/address_resolve/AddressResolve.h>
+#include <lib/support/IntrusiveList.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeDelegate.h>
 #include <messaging/ExchangeMgr.h>
@@ -61,8 +62,13 @@ class OperationalSessionSetup;
 class OperationalSessionReleaseDelegate
 {
 public:
-    virtual ~OperationalSessionReleaseDelegate()                        = default;
-    virtual void ReleaseSession(OperationalSessionSetup * sessionSetup) = 0;
+    virtual ~OperationalSessionReleaseDelegate() = default;
+
+    /**
+     * Releases a session setup once it has completed.  error is CHIP_NO_ERROR if the session setup established a session, and
+     * the reason it failed otherwise.
+     */
+    virtual void ReleaseSession(OperationalSessionSetup * sessionSetup, CHIP_ERROR error) = 0;
 };
 
 /**
@@ -132,6 +138,17 @@ typedef void (*OnDeviceConnectionFailure)(void * context, const ScopedNodeId & p
 typedef void (*OnDeviceConnectionRetry)(void * context, const ScopedNodeId & peerId, CHIP_ERROR error,
                                         System::Clock::Seconds16 retryTimeout);
 
+/**
+ * Priority of a session setup.  When CASESessionManager limits the number of session setups in progress at once,
+ * queued setups are started in order of priority, and in the order they were queued within a priority.
+ */
+enum class SessionSetupPriority : uint8_t
+{
+    kLow,
+    kNormal,
+    kHigh,
+};
+
 /**
  * Object used to either establish a connection to peer or performing address lookup to a peer.
  *
@@ -152,8 +169,12 @@ typedef void (*OnDeviceConnectionRetry)(void * context, const ScopedNodeId & pee
  *
  * It is possible to determine which of the two purposes the OperationalSessionSetup is for by calling
  * IsForAddressUpdate().
+ *
+ * The list node is used by CASESessionManager to keep track of the session setups it has queued or started.
  */
-class DLL_EXPORT OperationalSessionSetup : public SessionEstablishmentDelegate, public AddressResolve::NodeListener
+class DLL_EXPORT OperationalSessionSetup : public SessionEstablishmentDelegate,
+                                           public AddressResolve::NodeListener,
+                                           public IntrusiveListNodeBase<IntrusiveMode::AutoUnlink>
 {
 public:
     struct ConnnectionFailureInfo
@@ -238,8 +259,33 @@ public:
     void Connect(Callback::Callback<OnDeviceConnected> * onConnection, Callback::Callback<OnSetupFailure> * onSetupFailure,
                  TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload);
 
+    /*
+     * Queues the given callbacks like Connect does, but without starting session setup; it is started by a later call to
+     * ConnectQueued.  This lets CASESessionManager hold back session setups until it admits them.
+     */
+    void QueueConnect(Callback::Callback<OnDeviceConnected> * onConnection,
+                      Callback::Callback<OnDeviceConnectionFailure> * onFailure,
+                      Callback::Callback<OnSetupFailure> * onSetupFailure,
+                      TransportPayloadCapability transportPayloadCapability = TransportPayloadCapability::kMRPPayload);
+
+    /*
+     * Starts the session setup for the callbacks queued by QueueConnect.
+     */
+    void ConnectQueued() { Connect(nullptr, nullptr, nullptr, mTransportPayloadCapability); }
+
     bool IsForAddressUpdate() const { return mPerformingAddressUpdate; }
 
+    SessionSetupPriority GetPriority() const { return mPriority; }
+
+    // Raises our priority to at least the given one, e.g. when another consumer with a higher priority joins us.
+    void RaisePriority(SessionSetupPriority priority)
+    {
+        if (priority > mPriority)
+        {
+            mPriority = priority;
+        }
+    }
+
     //////////// SessionEstablishmentDelegate Implementation ///////////////
     void OnSessionEstablished(const SessionHandle & session) override;
     void OnSessionEstablishmentError(CHIP_ERROR error, SessionEstablishmentStage stage) override;
@@ -328,6 +374,9 @@ private:
 
     TransportPayloadCapability mTransportPayloadCapability = TransportPayloadCapability::kMRPPayload;
 
+    // The lowest priority, so that the priority of our first consumer, passed to RaisePriority, is the one we get.
+    SessionSetupPriority mPriority = SessionSetupPriority::kLow;
+
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
     // When we TryNextResult on the resolver, it will synchronously call back
     // into our OnNodeAddressResolved when it succeeds.  We need to track
@@ -418,6 +467,12 @@ private:
      */
     CHIP_ERROR LookupPeerAddress();
 
+    /**
+     * Tells DNS-SD that the address we resolved for the peer did not work out, so that
+     * later lookups do not get it from a cache.
+     */
+    void ForgetPeerAddress();
+
     /**
      * This function will set new IP address, port and MRP retransmission intervals of the device.
      */
@@ -15,10 +15,13 @@
  *    limitations under the License.
  */
 
+#include <algorithm>
 #include <app/icd/client/DefaultICDClientStorage.h>
 #include <iterator>
+#include <lib/core/CHIPEncoding.h>
 #include <lib/core/Global.h>
 #include <lib/support/Base64.h>
+#include <lib/support/BufferWriter.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/SafeInt.h>
@@ -50,6 +53,8 @@ CHIP_ERROR DefaultICDClientStorage::UpdateFabricList(FabricIndex fabricIndex)
     }
 
     mFabricList.push_back(fabricIndex);
+    // The new fabric may already have clientInfos in storage.
+    InvalidateCheckInIndex();
 
     Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
     size_t counter = mFabricList.size();
@@ -334,6 +339,10 @@ CHIP_ERROR DefaultICDClientStorage::SerializeToTlv(TLV::TLVWriter & writer, cons
 
 CHIP_ERROR DefaultICDClientStorage::StoreEntry(const ICDClientInfo & clientInfo)
 {
+    // Storage may be left partially updated on failure, in which case the check-in index is rebuilt when next used.
+    const bool checkInIndexValid = mCheckInIndexValid;
+    mCheckInIndexValid           = false;
+
     std::vector<ICDClientInfo> clientInfoVector;
     size_t clientInfoSize = MaxICDClientInfoSize();
     ReturnErrorOnFailure(Load(clientInfo.peer_node.GetFabricIndex(), clientInfoVector, clientInfoSize));
@@ -364,7 +373,15 @@ CHIP_ERROR DefaultICDClientStorage::StoreEntry(const ICDClientInfo & clientInfo)
         DefaultStorageKeyAllocator::ICDClientInfoKey(clientInfo.peer_node.GetFabricIndex()).KeyName(), backingBuffer.Get(),
         static_cast<uint16_t>(len)));
 
-    return IncreaseEntryCountForFabric(clientInfo.peer_node.GetFabricIndex());
+    ReturnErrorOnFailure(IncreaseEntryCountForFabric(clientInfo.peer_node.GetFabricIndex()));
+
+    if (checkInIndexValid)
+    {
+        RemoveCheckInKey(clientInfo.peer_node);
+        AddCheckInKey(clientInfo);
+        mCheckInIndexValid = true;
+    }
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DefaultICDClientStorage::IncreaseEntryCountForFabric(FabricIndex fabricIndex)
@@ -412,6 +429,10 @@ CHIP_ERROR DefaultICDClientStorage::UpdateEntryCountForFabric(FabricIndex fabric
 
 CHIP_ERROR DefaultICDClientStorage::DeleteEntry(const ScopedNodeId & peerNode)
 {
+    // Storage may be left partially updated on failure, in which case the check-in index is rebuilt when next used.
+    const bool checkInIndexValid = mCheckInIndexValid;
+    mCheckInIndexValid           = false;
+
     size_t clientInfoSize = 0;
     std::vector<ICDClientInfo> clientInfoVector;
     ReturnErrorOnFailure(Load(peerNode.GetFabricIndex(), clientInfoVector, clientInfoSize));
@@ -444,11 +465,20 @@ CHIP_ERROR DefaultICDClientStorage::DeleteEntry(const ScopedNodeId & peerNode)
         mpClientInfoStore->SyncSetKeyValue(DefaultStorageKeyAllocator::ICDClientInfoKey(peerNode.GetFabricIndex()).KeyName(),
                                            backingBuffer.Get(), static_cast<uint16_t>(len)));
 
-    return DecreaseEntryCountForFabric(peerNode.GetFabricIndex());
+    ReturnErrorOnFailure(DecreaseEntryCountForFabric(peerNode.GetFabricIndex()));
+
+    if (checkInIndexValid)
+    {
+        RemoveCheckInKey(peerNode);
+        mCheckInIndexValid = true;
+    }
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DefaultICDClientStorage::DeleteAllEntries(FabricIndex fabricIndex)
 {
+    InvalidateCheckInIndex();
+
     size_t clientInfoSize = 0;
     std::vector<ICDClientInfo> clientInfoVector;
     ReturnErrorOnFailure(Load(fabricIndex, clientInfoVector, clientInfoSize));
@@ -464,23 +494,160 @@ CHIP_ERROR DefaultICDClientStorage::DeleteAllEntries(FabricIndex fabricIndex)
 
 CHIP_ERROR DefaultICDClientStorage::ProcessCheckInPayload(const ByteSpan & payload, ICDClientInfo & clientInfo,
                                                           Protocols::SecureChannel::CounterType & counter)
+{
+    if (!mCheckInIndexValid)
+    {
+        ReturnErrorOnFailure(BuildCheckInIndex());
+    }
+
+    // Try the ICDs that are expected to send this nonce first.
+    if (payload.size() >= sizeof(uint64_t))
+    {
+        auto candidates = mCheckInNonceIndex.equal_range(Encoding::LittleEndian::Get64(payload.data()));
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            if (TryCheckInKey(it->second, payload, clientInfo, counter) == CHIP_NO_ERROR)
+            {
+                return CHIP_NO_ERROR;
+            }
+        }
+    }
+
+    // The sender may have skipped past the precomputed nonces, e.g. after check-in messages were missed.
+    for (size_t keyIndex = 0; keyIndex < mCheckInKeys.size(); keyIndex++)
+    {
+        if (TryCheckInKey(keyIndex, payload, clientInfo, counter) == CHIP_NO_ERROR)
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+CHIP_ERROR DefaultICDClientStorage::TryCheckInKey(size_t keyIndex, const ByteSpan & payload, ICDClientInfo & clientInfo,
+                                                  Protocols::SecureChannel::CounterType & counter)
 {
     uint8_t appDataBuffer[kAppDataLength];
     MutableByteSpan appData(appDataBuffer);
+    CheckInKey & key = mCheckInKeys[keyIndex];
+    ReturnErrorOnFailure(chip::Protocols::SecureChannel::CheckinMessage::ParseCheckinMessagePayload(
+        key.clientInfo.aes_key_handle, key.clientInfo.hmac_key_handle, payload, counter, appData));
+    clientInfo = key.clientInfo;
+
+    // Move the precomputed nonces up to the received counter, unless this is an older message being replayed.
+    if (static_cast<int32_t>(counter - key.firstCounter) > 0)
+    {
+        EraseCheckInNonceTags(keyIndex);
+        IndexCheckInNonces(keyIndex, counter);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DefaultICDClientStorage::BuildCheckInIndex()
+{
+    InvalidateCheckInIndex();
+
     auto * iterator = IterateICDClientInfo();
     VerifyOrReturnError(iterator != nullptr, CHIP_ERROR_NO_MEMORY);
+    ICDClientInfoIteratorWrapper iteratorWrapper(iterator);
+
+    ICDClientInfo clientInfo;
     while (iterator->Next(clientInfo))
     {
-        CHIP_ERROR err = chip::Protocols::SecureChannel::CheckinMessage::ParseCheckinMessagePayload(
-            clientInfo.aes_key_handle, clientInfo.hmac_key_handle, payload, counter, appData);
-        if (CHIP_NO_ERROR == err)
+        AddCheckInKey(clientInfo);
+    }
+    mCheckInIndexValid = true;
+    return CHIP_NO_ERROR;
+}
+
+void DefaultICDClientStorage::InvalidateCheckInIndex()
+{
+    mCheckInIndexValid = false;
+    mCheckInKeys.clear();
+    mCheckInNonceIndex.clear();
+}
+
+void DefaultICDClientStorage::AddCheckInKey(const ICDClientInfo & clientInfo)
+{
+    if (std::find(mFabricList.begin(), mFabricList.end(), clientInfo.peer_node.GetFabricIndex()) == mFabricList.end())
+    {
+        // Only the clientInfos of the fabrics in the fabric list are checked against check-in messages.
+        return;
+    }
+
+    mCheckInKeys.emplace_back();
+    mCheckInKeys.back().clientInfo = clientInfo;
+    IndexCheckInNonces(mCheckInKeys.size() - 1, clientInfo.start_icd_counter + clientInfo.offset);
+}
+
+void DefaultICDClientStorage::RemoveCheckInKey(const ScopedNodeId & peerNode)
+{
+    for (size_t keyIndex = 0; keyIndex < mCheckInKeys.size(); keyIndex++)
+    {
+        if (mCheckInKeys[keyIndex].clientInfo.peer_node != peerNode)
         {
-            iterator->Release();
-            return CHIP_NO_ERROR;
+            continue;
+        }
+
+        // Move the last key into the freed slot, so that the indices of the other keys do not change.
+        const size_t lastIndex = mCheckInKeys.size() - 1;
+        EraseCheckInNonceTags(keyIndex);
+        if (keyIndex != lastIndex)
+        {
+            EraseCheckInNonceTags(lastIndex);
+            mCheckInKeys[keyIndex] = mCheckInKeys[lastIndex];
+            InsertCheckInNonceTags(keyIndex);
+        }
+        mCheckInKeys.pop_back();
+        return;
+    }
+}
+
+void DefaultICDClientStorage::IndexCheckInNonces(size_t keyIndex, Protocols::SecureChannel::CounterType firstCounter)
+{
+    CheckInKey & key  = mCheckInKeys[keyIndex];
+    key.firstCounter  = firstCounter;
+    key.nonceTagCount = 0;
+
+    for (uint32_t i = 0; i < kCheckInNonceWindow; i++)
+    {
+        uint8_t nonce[Crypto::CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES];
+        Encoding::LittleEndian::BufferWriter writer(nonce, sizeof(nonce));
+        if (chip::Protocols::SecureChannel::CheckinMessage::GenerateCheckInMessageNonce(key.clientInfo.hmac_key_handle,
+                                                                                         firstCounter + i, writer) != CHIP_NO_ERROR)
+        {
+            // Check-in messages from this ICD are still found by trying every key.
+            break;
+        }
+        key.nonceTags[key.nonceTagCount++] = Encoding::LittleEndian::Get64(nonce);
+    }
+    InsertCheckInNonceTags(keyIndex);
+}
+
+void DefaultICDClientStorage::InsertCheckInNonceTags(size_t keyIndex)
+{
+    const CheckInKey & key = mCheckInKeys[keyIndex];
+    for (uint32_t i = 0; i < key.nonceTagCount; i++)
+    {
+        mCheckInNonceIndex.emplace(key.nonceTags[i], keyIndex);
+    }
+}
+
+void DefaultICDClientStorage::EraseCheckInNonceTags(size_t keyIndex)
+{
+    const CheckInKey & key = mCheckInKeys[keyIndex];
+    for (uint32_t i = 0; i < key.nonceTagCount; i++)
+    {
+        auto candidates = mCheckInNonceIndex.equal_range(key.nonceTags[i]);
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            if (it->second == keyIndex)
+            {
+                mCheckInNonceIndex.erase(it);
+                break;
+            }
         }
     }
-    iterator->Release();
-    return CHIP_ERROR_NOT_FOUND;
 }
 } // namespace app
 } // namespace chip
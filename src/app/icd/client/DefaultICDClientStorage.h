@@ -33,6 +33,7 @@
 #include <lib/core/TLV.h>
 #include <lib/support/CommonIterator.h>
 #include <lib/support/Pool.h>
+#include <unordered_map>
 #include <vector>
 
 // TODO: SymmetricKeystore is an alias for SessionKeystore, replace the below when sdk supports SymmetricKeystore
@@ -77,6 +78,13 @@ public:
 
     static constexpr size_t kIteratorsMax = CHIP_CONFIG_MAX_ICD_CLIENTS_INFO_STORAGE_CONCURRENT_ITERATORS;
 
+    /**
+     * Number of check-in counter values of each ICD for which the expected check-in nonce is precomputed.
+     * A check-in message whose nonce matches one of them is resolved with a single decryption; any other message
+     * falls back to trying the key of every ICD.
+     */
+    static constexpr uint32_t kCheckInNonceWindow = 4;
+
     CHIP_ERROR Init(PersistentStorageDelegate * clientInfoStore, Crypto::SymmetricKeystore * keyStore);
 
     /**
@@ -117,6 +125,14 @@ public:
      */
     CHIP_ERROR DeleteAllEntries(FabricIndex fabricIndex);
 
+    /**
+     * Find the ICD that sent a check-in message and decrypt it.
+     *
+     * The key handles of all the ICD clientInfos are kept in memory, indexed by the nonces expected in their next
+     * check-in messages, so that the sender of a check-in message can usually be found without loading the clientInfos
+     * from storage or trying the keys of the other ICDs. The index is built by the first call and kept up to date by
+     * StoreEntry and DeleteEntry.
+     */
     CHIP_ERROR ProcessCheckInPayload(const ByteSpan & payload, ICDClientInfo & clientInfo,
                                      Protocols::SecureChannel::CounterType & counter) override;
 
@@ -180,11 +196,38 @@ private:
     CHIP_ERROR SerializeToTlv(TLV::TLVWriter & writer, const std::vector<ICDClientInfo> & clientInfoVector);
     CHIP_ERROR Load(FabricIndex fabricIndex, std::vector<ICDClientInfo> & clientInfoVector, size_t & clientInfoSize);
 
+    struct CheckInKey
+    {
+        ICDClientInfo clientInfo;
+        // Counter of the last check-in message received from the ICD, or of its registration if none was received yet.
+        Protocols::SecureChannel::CounterType firstCounter = 0;
+        // First bytes of the check-in nonces for the kCheckInNonceWindow counter values starting at firstCounter, so that
+        // both the next check-in messages and a retransmission of the last one are matched.
+        uint64_t nonceTags[kCheckInNonceWindow];
+        uint32_t nonceTagCount = 0;
+    };
+
+    CHIP_ERROR BuildCheckInIndex();
+    void InvalidateCheckInIndex();
+    void AddCheckInKey(const ICDClientInfo & clientInfo);
+    void RemoveCheckInKey(const ScopedNodeId & peerNode);
+    CHIP_ERROR TryCheckInKey(size_t keyIndex, const ByteSpan & payload, ICDClientInfo & clientInfo,
+                             Protocols::SecureChannel::CounterType & counter);
+    void IndexCheckInNonces(size_t keyIndex, Protocols::SecureChannel::CounterType firstCounter);
+    void InsertCheckInNonceTags(size_t keyIndex);
+    void EraseCheckInNonceTags(size_t keyIndex);
+
     ObjectPool<ICDClientInfoIteratorImpl, kIteratorsMax> mICDClientInfoIterators;
 
     PersistentStorageDelegate * mpClientInfoStore = nullptr;
     Crypto::SymmetricKeystore * mpKeyStore        = nullptr;
     std::vector<FabricIndex> mFabricList;
+
+    // In-memory copy of the ICD clientInfos of the fabrics in mFabricList, used to match check-in messages.
+    std::vector<CheckInKey> mCheckInKeys;
+    // Maps the first bytes of an expected check-in nonce to the index of its key in mCheckInKeys.
+    std::unordered_multimap<uint64_t, size_t> mCheckInNonceIndex;
+    bool mCheckInIndexValid = false;
 };
 } // namespace app
 } // namespace chip
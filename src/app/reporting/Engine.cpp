@@ -32,8 +32,11 @@
 #include <app/RequiredPrivilege.h>
 #include <app/reporting/Engine.h>
 #include <app/util/MatterCallbacks.h>
+#include <app/util/attribute-storage.h>
 #include <app/util/ember-compatibility-functions.h>
 
+#include <algorithm>
+
 using namespace chip::Access;
 
 namespace chip {
@@ -57,6 +60,17 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    ClearReportEncodingCache();
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    mInterestIndex.Free();
+    mInterestEntryCount         = 0;
+    mWildcardInterestEntryCount = 0;
+    mInterestIndexStale         = true;
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -98,6 +112,124 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool a
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+static_assert(CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE <= UINT16_MAX,
+              "ReportEncodingCacheEntry offsets do not fit in the report encoding cache");
+
+CHIP_ERROR Engine::RetrieveClusterDataFromCache(const ReadHandler & aReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                                const ConcreteReadAttributePath & aPath, bool & aIsEncoded)
+{
+    aIsEncoded = false;
+
+    const SubjectDescriptor subjectDescriptor = aReadHandler.GetSubjectDescriptor();
+
+    // The cached encoding is shared between subjects, so the access check that ReadSingleClusterData would have done for
+    // this subject has to happen here.  Denied reads take the uncached path, which reports them as appropriate.
+    Access::RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+    ReturnErrorOnFailure(
+        Access::GetAccessControl().Check(subjectDescriptor, requestPath, RequiredPrivilege::ForReadAttribute(aPath)));
+
+    const DataVersion * dataVersion = emberAfDataVersionStorage(aPath);
+    VerifyOrReturnError(dataVersion != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    // Fabric-scoped attributes are encoded differently depending on the accessing fabric and on fabric filtering.
+    ReportEncodingCacheEntry * entry = nullptr;
+    for (size_t i = 0; i < mReportEncodingCacheEntryCount; i++)
+    {
+        ReportEncodingCacheEntry & candidate = mReportEncodingCacheEntries[i];
+        if (candidate.mPath == aPath && candidate.mPath.mExpanded == aPath.mExpanded && candidate.mDataVersion == *dataVersion &&
+            candidate.mAccessingFabricIndex == subjectDescriptor.fabricIndex &&
+            candidate.mIsFabricFiltered == aReadHandler.IsFabricFiltered())
+        {
+            entry = &candidate;
+            break;
+        }
+    }
+
+    const bool isCacheHit = (entry != nullptr);
+    if (!isCacheHit)
+    {
+        VerifyOrReturnError(mReportEncodingCacheEntryCount < kReportEncodingCacheMaxEntries, CHIP_ERROR_NO_MEMORY);
+
+        entry                        = &mReportEncodingCacheEntries[mReportEncodingCacheEntryCount++];
+        entry->mPath                 = aPath;
+        entry->mDataVersion          = *dataVersion;
+        entry->mAccessingFabricIndex = subjectDescriptor.fabricIndex;
+        entry->mIsFabricFiltered     = aReadHandler.IsFabricFiltered();
+        entry->mOffset               = static_cast<uint16_t>(mReportEncodingCacheUsed);
+        entry->mLength               = 0;
+
+        // Encode the attribute as a whole into the free part of the cache.  If it does not fit, or anything else goes
+        // wrong, the entry stays empty so that the other read handlers go straight to the uncached path.
+        TLV::TLVWriter writer;
+        writer.Init(&mReportEncodingCache[mReportEncodingCacheUsed], sizeof(mReportEncodingCache) - mReportEncodingCacheUsed);
+
+        AttributeReportIBs::Builder attributeReportIBs;
+        AttributeEncodeState encodeState;
+        ReturnErrorOnFailure(attributeReportIBs.Init(&writer));
+        ReturnErrorOnFailure(RetrieveClusterData(subjectDescriptor, aReadHandler.IsFabricFiltered(), attributeReportIBs, aPath,
+                                                 &encodeState));
+        ReturnErrorOnFailure(attributeReportIBs.EndOfAttributeReportIBs());
+        ReturnErrorOnFailure(writer.Finalize());
+
+        entry->mLength = static_cast<uint16_t>(writer.GetLengthWritten());
+        mReportEncodingCacheUsed += entry->mLength;
+    }
+
+    VerifyOrReturnError(entry->mLength > 0, CHIP_ERROR_NO_MEMORY);
+    aIsEncoded = true;
+
+    TLV::TLVReader reader;
+    TLV::TLVType containerType;
+    reader.Init(&mReportEncodingCache[entry->mOffset], entry->mLength);
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    if (isCacheHit)
+    {
+        // A cache hit stands in for a read of the attribute, so the data model gets the same callbacks around it as around the
+        // read in RetrieveClusterData.  Make sure first that the encoding fits, so that the read is not reported again by the
+        // uncached path.
+        VerifyOrReturnError(aAttributeReportIBs.GetWriter()->GetRemainingFreeLength() >= entry->mLength, CHIP_ERROR_NO_MEMORY);
+        DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
+                                                              DataModelCallbacks::OperationOrder::Pre, aPath);
+    }
+
+    TLV::TLVWriter backup;
+    aAttributeReportIBs.Checkpoint(backup);
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        err = aAttributeReportIBs.GetWriter()->CopyElement(reader);
+        if (err != CHIP_NO_ERROR)
+        {
+            break;
+        }
+    }
+
+    if (err != CHIP_END_OF_TLV)
+    {
+        aAttributeReportIBs.Rollback(backup);
+        return err;
+    }
+
+    if (isCacheHit)
+    {
+        DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
+                                                              DataModelCallbacks::OperationOrder::Post, aPath);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void Engine::ClearReportEncodingCache()
+{
+    mReportEncodingCacheEntryCount = 0;
+    mReportEncodingCacheUsed       = 0;
+}
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
 static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
 {
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
@@ -200,6 +332,33 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+            // Attributes that are not in the middle of being chunked can be shared with other read handlers.
+            if (encodeState.CurrentEncodingListIndex() == kInvalidListIndex)
+            {
+                bool isEncodedInCache = false;
+                err = RetrieveClusterDataFromCache(*apReadHandler, attributeReportIBs, pathForRetrieval, isEncodedInCache);
+                if (err == CHIP_NO_ERROR)
+                {
+                    apReadHandler->SetAttributeEncodeState(AttributeEncodeState());
+                    continue;
+                }
+
+                // The cached encoding does not fit in what is left of this chunk.  Reading the attribute again would not make
+                // it any smaller, so leave it for the next chunk, unless this one has nothing else in it: then only list
+                // chunking on the uncached path can make progress.
+                if (isEncodedInCache && IsOutOfWriterSpaceError(err) &&
+                    attributeReportIBs.GetWriter()->GetLengthWritten() != emptyReportDataLength)
+                {
+                    ChipLogDetail(DataManagement,
+                                  "Next cached attribute value does not fit in packet, roll back on clusterId: " ChipLogFormatMEI
+                                  ", attributeId: " ChipLogFormatMEI,
+                                  ChipLogValueMEI(pathForRetrieval.mClusterId), ChipLogValueMEI(pathForRetrieval.mAttributeId));
+                    apReadHandler->SetAttributeEncodeState(AttributeEncodeState());
+                    ExitNow();
+                }
+            }
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
             err = RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(), attributeReportIBs,
                                       pathForRetrieval, &encodeState);
             if (err != CHIP_NO_ERROR)
@@ -663,6 +822,10 @@ void Engine::Run()
 {
     uint32_t numReadHandled = 0;
 
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    ClearReportEncodingCache();
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = mpImEngine->mReadHandlers.Allocated();
@@ -861,25 +1024,35 @@ CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
     BumpDirtySetGeneration();
 
     bool intersectsInterestPath = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
-        // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
-        // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
-        // waiting for a response to the last message chunk for read interactions.
-        if (handler->CanStartReporting() || handler->IsAwaitingReportResponse())
-        {
-            for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    // Changes to a whole endpoint or cluster are rare, so they just take the slow path below.
+    if (!aAttributePath.HasWildcardEndpointId() && !aAttributePath.HasWildcardClusterId() && UpdateInterestIndex() == CHIP_NO_ERROR)
+    {
+        intersectsInterestPath = MarkInterestedReadHandlersDirty(aAttributePath);
+    }
+    else
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    {
+        mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
+            // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
+            // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
+            // waiting for a response to the last message chunk for read interactions.
+            if (handler->CanStartReporting() || handler->IsAwaitingReportResponse())
             {
-                if (object->mValue.Intersects(aAttributePath))
+                for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
                 {
-                    handler->AttributePathIsDirty(aAttributePath);
-                    intersectsInterestPath = true;
-                    break;
+                    if (object->mValue.Intersects(aAttributePath))
+                    {
+                        handler->AttributePathIsDirty(aAttributePath);
+                        intersectsInterestPath = true;
+                        break;
+                    }
                 }
             }
-        }
 
-        return Loop::Continue;
-    });
+            return Loop::Continue;
+        });
+    }
 
     if (!intersectsInterestPath)
     {
@@ -890,6 +1063,103 @@ CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+bool Engine::IsInterestEntryClusterLess(const InterestEntry & a, const InterestEntry & b)
+{
+    return (a.mEndpointId < b.mEndpointId) || (a.mEndpointId == b.mEndpointId && a.mClusterId < b.mClusterId);
+}
+
+CHIP_ERROR Engine::UpdateInterestIndex()
+{
+    VerifyOrReturnError(mInterestIndexStale, CHIP_NO_ERROR);
+
+    size_t pathCount = 0;
+    mpImEngine->mReadHandlers.ForEachActiveObject([&pathCount](ReadHandler * handler) {
+        pathCount += handler->GetAttributePathCount();
+        return Loop::Continue;
+    });
+
+    if (pathCount > mInterestIndex.AllocatedSize())
+    {
+        // Leave some headroom so that a few more paths do not force another allocation.
+        mInterestIndex.Free();
+        mInterestIndex.Calloc(pathCount + pathCount / 2);
+        if (mInterestIndex.Get() == nullptr)
+        {
+            mInterestEntryCount         = 0;
+            mWildcardInterestEntryCount = 0;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+    }
+
+    size_t entryCount    = 0;
+    size_t wildcardCount = 0;
+    mpImEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+        {
+            InterestEntry & entry = mInterestIndex[entryCount++];
+            entry.mEndpointId     = object->mValue.mEndpointId;
+            entry.mClusterId      = object->mValue.mClusterId;
+            entry.mIsWildcard     = object->mValue.HasWildcardEndpointId() || object->mValue.HasWildcardClusterId();
+            entry.mpReadHandler   = handler;
+            entry.mpAttributePath = &object->mValue;
+            wildcardCount += entry.mIsWildcard ? 1 : 0;
+        }
+        return Loop::Continue;
+    });
+
+    std::sort(mInterestIndex.Get(), mInterestIndex.Get() + entryCount, [](const InterestEntry & a, const InterestEntry & b) {
+        return (a.mIsWildcard != b.mIsWildcard) ? a.mIsWildcard : IsInterestEntryClusterLess(a, b);
+    });
+
+    mInterestEntryCount         = entryCount;
+    mWildcardInterestEntryCount = wildcardCount;
+    mInterestIndexStale         = false;
+    return CHIP_NO_ERROR;
+}
+
+bool Engine::MarkInterestedReadHandlersDirty(const AttributePathParams & aAttributePath)
+{
+    bool intersectsInterestPath = false;
+
+    auto markDirty = [&](const InterestEntry & entry) {
+        ReadHandler * handler = entry.mpReadHandler;
+
+        // A read handler shows up once per path, so skip it if one of its other paths already marked it dirty for
+        // this change.  SetDirty bumped the generation, so the handler cannot hold it from an earlier change.
+        if (handler->mDirtyGeneration == mDirtyGeneration)
+        {
+            return;
+        }
+
+        // See the comment on the unindexed loop in SetDirty.
+        if ((handler->CanStartReporting() || handler->IsAwaitingReportResponse()) &&
+            entry.mpAttributePath->Intersects(aAttributePath))
+        {
+            handler->AttributePathIsDirty(aAttributePath);
+            intersectsInterestPath = true;
+        }
+    };
+
+    const InterestEntry * const begin = mInterestIndex.Get();
+    const InterestEntry * const end   = begin + mInterestEntryCount;
+
+    for (const InterestEntry * entry = begin; entry != begin + mWildcardInterestEntryCount; ++entry)
+    {
+        markDirty(*entry);
+    }
+
+    const InterestEntry key = { aAttributePath.mEndpointId, aAttributePath.mClusterId, false, nullptr, nullptr };
+    auto range = std::equal_range(begin + mWildcardInterestEntryCount, end, key, IsInterestEntryClusterLess);
+    for (const InterestEntry * entry = range.first; entry != range.second; ++entry)
+    {
+        markDirty(*entry);
+    }
+
+    return intersectsInterestPath;
+}
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
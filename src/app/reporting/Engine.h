@@ -30,6 +30,7 @@
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeMgr.h>
@@ -128,6 +129,17 @@ public:
 
     uint64_t GetDirtySetGeneration() const { return mDirtyGeneration; }
 
+    /**
+     * Should be invoked whenever the attribute path list of a read handler changes, so that
+     * the index used to find the read handlers interested in a dirty path gets rebuilt.
+     */
+    void OnAttributePathListChanged()
+    {
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+        mInterestIndexStale = true;
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    }
+
     /**
      * Schedule event delivery to happen immediately and run reporting to get
      * those reports into messages and on the wire.  This can be done either for
@@ -173,6 +185,21 @@ private:
                                    const ConcreteReadAttributePath & aClusterInfo, AttributeEncodeState * apEncoderState);
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    /**
+     * Encodes the AttributeReportIBs for the given path by copying them from the report encoding cache, reading and
+     * encoding the attribute into the cache first if no other read handler has done so during this run.
+     *
+     * On any error nothing is written.  aIsEncoded tells whether the cache holds an encoding for the path: if it does
+     * and the error is an out of writer space error, the encoding does not fit in what is left of the report, and the
+     * caller should end the chunk rather than read the attribute again.  Otherwise the caller is expected to fall back to
+     * RetrieveClusterData, which takes care of access denials, encoding errors and list chunking.
+     */
+    CHIP_ERROR RetrieveClusterDataFromCache(const ReadHandler & aReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                            const ConcreteReadAttributePath & aPath, bool & aIsEncoded);
+    void ClearReportEncodingCache();
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
     // If version match, it means don't send, if version mismatch, it means send.
     // If client sends the same path with multiple data versions, client will get the data back per the spec, because at least one
     // of those will fail to match.  This function should return false if either nothing in the list matches the given
@@ -231,6 +258,35 @@ private:
 
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    /**
+     * An attribute path that a read handler is interested in.  Paths with a wildcard endpoint or cluster are
+     * kept at the front of the index; the rest are sorted by endpoint and cluster.
+     */
+    struct InterestEntry
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        bool mIsWildcard;
+        ReadHandler * mpReadHandler;
+        const AttributePathParams * mpAttributePath;
+    };
+
+    static bool IsInterestEntryClusterLess(const InterestEntry & a, const InterestEntry & b);
+
+    /**
+     * Rebuilds the interest index from the attribute path lists of all read handlers if any of them changed
+     * since the last rebuild.
+     */
+    CHIP_ERROR UpdateInterestIndex();
+
+    /**
+     * Calls AttributePathIsDirty on every read handler with an indexed path that intersects the given concrete
+     * cluster path.  Returns whether there was any such handler.
+     */
+    bool MarkInterestedReadHandlersDirty(const AttributePathParams & aAttributePath);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
     /**
      * Boolean to indicate if ScheduleRun is pending. This flag is used to prevent calling ScheduleRun multiple times
      * within the same execution context to avoid applying too much pressure on platforms that use small, fixed size event queues.
@@ -280,6 +336,37 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    /**
+     * The encoded AttributeReportIBs of an attribute, stored as an anonymous array in mReportEncodingCache.  An entry
+     * with mLength == 0 records that the attribute could not be encoded into the cache.
+     */
+    struct ReportEncodingCacheEntry
+    {
+        ConcreteAttributePath mPath;
+        DataVersion mDataVersion;
+        FabricIndex mAccessingFabricIndex;
+        bool mIsFabricFiltered;
+        uint16_t mOffset;
+        uint16_t mLength;
+    };
+
+    static constexpr size_t kReportEncodingCacheMaxEntries = 16;
+
+    // Cleared at the start of every run, so that entries never outlive the attribute values they were read from.
+    uint8_t mReportEncodingCache[CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE];
+    ReportEncodingCacheEntry mReportEncodingCacheEntries[kReportEncodingCacheMaxEntries];
+    size_t mReportEncodingCacheEntryCount = 0;
+    size_t mReportEncodingCacheUsed       = 0;
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    Platform::ScopedMemoryBufferWithSize<InterestEntry> mInterestIndex;
+    size_t mInterestEntryCount         = 0;
+    size_t mWildcardInterestEntryCount = 0;
+    bool mInterestIndexStale           = true;
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
@@ -25,6 +25,7 @@
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
 #include <app/DefaultAttributePersistenceProvider.h>
+#include <app/EventManagement.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
@@ -164,6 +165,9 @@ struct ServerInitParams
     Credentials::OperationalCertificateStore * opCertStore = nullptr;
     // Required, if not provided, the Server::Init() WILL fail.
     app::reporting::ReportScheduler * reportScheduler = nullptr;
+    // Event log storage: Optional. When provided, it MUST hold one entry per priority level, ordered Debug, Info, Critical, and
+    // is used instead of the statically allocated event buffers, e.g. to keep events in storage that outlives the process.
+    const app::LogStorageResources * eventLogStorageResources = nullptr;
 };
 
 /**
@@ -0,0 +1,378 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the admission of session setups by CASESessionManager.
+ */
+
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/OperationalSessionSetupPool.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <messaging/tests/MessagingContext.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+
+using namespace chip;
+
+namespace {
+
+constexpr FabricIndex kFabric1 = 1;
+constexpr FabricIndex kFabric2 = 2;
+constexpr size_t kPoolSize     = 8;
+
+const ScopedNodeId kNodeA(0x1001, kFabric1);
+const ScopedNodeId kNodeB(0x1002, kFabric1);
+const ScopedNodeId kNodeC(0x1003, kFabric1);
+const ScopedNodeId kNodeD(0x1004, kFabric1);
+const ScopedNodeId kNodeE(0x1005, kFabric1);
+const ScopedNodeId kNodeF(0x2001, kFabric2);
+
+System::Clock::Internal::MockClock gMockClock;
+System::Clock::ClockBase * gRealClock;
+
+// Only needs to be valid for CASEClientInitParams; the session setups of these tests never use it.
+Credentials::GroupDataProviderImpl gGroupDataProvider;
+
+class TestContext : public Test::LoopbackMessagingContext
+{
+public:
+    // Performs shared setup for all tests in the test suite
+    static void SetUpTestSuite()
+    {
+        Test::LoopbackMessagingContext::SetUpTestSuite();
+        gRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&gMockClock);
+    }
+
+    // Performs shared teardown for all tests in the test suite
+    static void TearDownTestSuite()
+    {
+        System::Clock::Internal::SetSystemClockForTesting(gRealClock);
+        Test::LoopbackMessagingContext::TearDownTestSuite();
+    }
+};
+
+// Session setup pool that counts the session setups it allocates and releases.
+class CountingSessionSetupPool : public OperationalSessionSetupPool<kPoolSize>
+{
+public:
+    OperationalSessionSetup * Allocate(const CASEClientInitParams & params, CASEClientPoolDelegate * clientPool,
+                                       ScopedNodeId peerId, OperationalSessionReleaseDelegate * releaseDelegate) override
+    {
+        mAllocated++;
+        return OperationalSessionSetupPool<kPoolSize>::Allocate(params, clientPool, peerId, releaseDelegate);
+    }
+
+    void Release(OperationalSessionSetup * sessionSetup) override
+    {
+        mReleased++;
+        OperationalSessionSetupPool<kPoolSize>::Release(sessionSetup);
+    }
+
+    size_t mAllocated = 0;
+    size_t mReleased  = 0;
+};
+
+// CASESessionManager whose session setups do not resolve addresses or run CASE; the tests complete them instead.
+class ManualCASESessionManager : public CASESessionManager
+{
+public:
+    CHIP_ERROR Init(TestContext & ctx, uint16_t maxConcurrentSessionSetups, System::Clock::Milliseconds32 backoffInitialDelay)
+    {
+        CASESessionManagerConfig config;
+        config.sessionInitParams.sessionManager    = &ctx.GetSecureSessionManager();
+        config.sessionInitParams.exchangeMgr       = &ctx.GetExchangeManager();
+        config.sessionInitParams.fabricTable       = &ctx.GetFabricTable();
+        config.sessionInitParams.groupDataProvider = &gGroupDataProvider;
+        config.clientPool                          = &mClientPool;
+        config.sessionSetupPool                    = &mSessionSetupPool;
+        config.maxConcurrentSessionSetups          = maxConcurrentSessionSetups;
+        config.sessionSetupBackoffInitialDelay     = backoffInitialDelay;
+        return CASESessionManager::Init(&ctx.GetSystemLayer(), config);
+    }
+
+    void FindOrEstablish(const ScopedNodeId & peerId, SessionSetupPriority priority = SessionSetupPriority::kNormal)
+    {
+        FindOrEstablishSession(peerId, nullptr, nullptr,
+#if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
+                               1, nullptr,
+#endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
+                               TransportPayloadCapability::kMRPPayload, priority);
+    }
+
+    // Completes the session setup with the given node, the way OperationalSessionSetup does once CASE is over.
+    bool Complete(const ScopedNodeId & peerId, CHIP_ERROR error)
+    {
+        OperationalSessionSetup * sessionSetup = mSessionSetupPool.FindSessionSetup(peerId, false);
+        if (sessionSetup == nullptr)
+        {
+            return false;
+        }
+        ReleaseSession(sessionSetup, error);
+        return true;
+    }
+
+    bool WasStarted(size_t index, const ScopedNodeId & peerId) const { return index < mStartedCount && mStarted[index] == peerId; }
+
+    CountingSessionSetupPool mSessionSetupPool;
+    CASEClientPool<kPoolSize> mClientPool;
+
+    ScopedNodeId mStarted[16];
+    size_t mStartedCount = 0;
+
+protected:
+    void StartSessionSetup(OperationalSessionSetup * session) override
+    {
+        VerifyOrDie(mStartedCount < ArraySize(mStarted));
+        mStarted[mStartedCount++] = session->GetPeerId();
+    }
+};
+
+bool CountersAre(const ManualCASESessionManager & manager, size_t queued, size_t active, uint32_t failed)
+{
+    CASESessionManager::SessionSetupCounters counters = manager.GetSessionSetupCounters();
+    return counters.queued == queued && counters.active == active && counters.failed == failed;
+}
+
+void TestConcurrencyLimit(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    ManualCASESessionManager manager;
+    NL_TEST_ASSERT(apSuite, manager.Init(ctx, 2, System::Clock::kZero) == CHIP_NO_ERROR);
+
+    manager.FindOrEstablish(kNodeA);
+    manager.FindOrEstablish(kNodeB);
+    manager.FindOrEstablish(kNodeC);
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mAllocated == 3);
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 2);
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(0, kNodeA));
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(1, kNodeB));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 1, 2, 0));
+
+    // The queued session setup is admitted from the event loop, not from within the completion of another one.
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeA, CHIP_NO_ERROR));
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 2);
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 1, 1, 0));
+
+    ctx.GetIOContext().DriveIO();
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 3);
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(2, kNodeC));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 2, 0));
+
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeB, CHIP_ERROR_TIMEOUT));
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeC, CHIP_NO_ERROR));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 0, 1));
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mReleased == 3);
+
+    manager.Shutdown();
+}
+
+void TestAdmissionOrder(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    ManualCASESessionManager manager;
+    NL_TEST_ASSERT(apSuite, manager.Init(ctx, 1, System::Clock::kZero) == CHIP_NO_ERROR);
+
+    manager.FindOrEstablish(kNodeA);
+    manager.FindOrEstablish(kNodeB, SessionSetupPriority::kLow);
+    manager.FindOrEstablish(kNodeC);
+    manager.FindOrEstablish(kNodeD, SessionSetupPriority::kHigh);
+    manager.FindOrEstablish(kNodeE);
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 4, 1, 0));
+
+    // By priority first, then in the order they were queued.
+    const ScopedNodeId expectedOrder[] = { kNodeA, kNodeD, kNodeC, kNodeE, kNodeB };
+    for (size_t i = 1; i < ArraySize(expectedOrder); i++)
+    {
+        NL_TEST_ASSERT(apSuite, manager.Complete(expectedOrder[i - 1], CHIP_NO_ERROR));
+        ctx.GetIOContext().DriveIO();
+        NL_TEST_ASSERT(apSuite, manager.mStartedCount == i + 1);
+        NL_TEST_ASSERT(apSuite, manager.WasStarted(i, expectedOrder[i]));
+        NL_TEST_ASSERT(apSuite, CountersAre(manager, ArraySize(expectedOrder) - i - 1, 1, 0));
+    }
+
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeB, CHIP_NO_ERROR));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 0, 0));
+
+    manager.Shutdown();
+}
+
+void TestJoinRaisesPriority(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    ManualCASESessionManager manager;
+    NL_TEST_ASSERT(apSuite, manager.Init(ctx, 1, System::Clock::kZero) == CHIP_NO_ERROR);
+
+    manager.FindOrEstablish(kNodeA);
+    manager.FindOrEstablish(kNodeB, SessionSetupPriority::kLow);
+    manager.FindOrEstablish(kNodeC);
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mAllocated == 3);
+
+    // A second caller for B joins its queued session setup, and its higher priority lets B overtake C.
+    manager.FindOrEstablish(kNodeB, SessionSetupPriority::kHigh);
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mAllocated == 3);
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 1);
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 2, 1, 0));
+
+    // A caller with a lower priority does not lower it again.
+    manager.FindOrEstablish(kNodeB, SessionSetupPriority::kLow);
+
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeA, CHIP_NO_ERROR));
+    ctx.GetIOContext().DriveIO();
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 2);
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(1, kNodeB));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 1, 1, 0));
+
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeB, CHIP_NO_ERROR));
+    ctx.GetIOContext().DriveIO();
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(2, kNodeC));
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeC, CHIP_NO_ERROR));
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mAllocated == 3);
+
+    manager.Shutdown();
+}
+
+void TestBackoff(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    ManualCASESessionManager manager;
+    constexpr System::Clock::Milliseconds32 kInitialDelay(100);
+    NL_TEST_ASSERT(apSuite, manager.Init(ctx, 0, kInitialDelay) == CHIP_NO_ERROR);
+
+    manager.FindOrEstablish(kNodeA);
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 1);
+
+    // The delay doubles with every consecutive failure, up to CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT times.
+    constexpr uint32_t kFailures = CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT + 2;
+    for (uint32_t failures = 1; failures <= kFailures; failures++)
+    {
+        NL_TEST_ASSERT(apSuite, manager.Complete(kNodeA, CHIP_ERROR_TIMEOUT));
+        NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 0, failures));
+
+        uint32_t shift = std::min<uint32_t>(failures - 1, CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT);
+        System::Clock::Milliseconds64 delay(kInitialDelay.count() << shift);
+
+        size_t startedCount = manager.mStartedCount;
+        manager.FindOrEstablish(kNodeA);
+        ctx.GetIOContext().DriveIO();
+        NL_TEST_ASSERT(apSuite, manager.mStartedCount == startedCount);
+        NL_TEST_ASSERT(apSuite, CountersAre(manager, 1, 0, failures));
+
+        gMockClock.AdvanceMonotonic(delay / 2);
+        ctx.GetIOContext().DriveIO();
+        NL_TEST_ASSERT(apSuite, manager.mStartedCount == startedCount);
+
+        gMockClock.AdvanceMonotonic(delay - delay / 2);
+        ctx.GetIOContext().DriveIO();
+        NL_TEST_ASSERT(apSuite, manager.mStartedCount == startedCount + 1);
+        NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 1, failures));
+    }
+
+    // Another node is not held back by the backoff of A, even when queued behind it.
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeA, CHIP_ERROR_TIMEOUT));
+    manager.FindOrEstablish(kNodeA);
+    manager.FindOrEstablish(kNodeB);
+    ctx.GetIOContext().DriveIO();
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(manager.mStartedCount - 1, kNodeB));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 1, 1, kFailures + 1));
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeB, CHIP_NO_ERROR));
+
+    // A success clears the backoff.
+    gMockClock.AdvanceMonotonic(
+        System::Clock::Milliseconds64(kInitialDelay.count() << CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT));
+    ctx.GetIOContext().DriveIO();
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 1, kFailures + 1));
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeA, CHIP_NO_ERROR));
+
+    size_t startedCount = manager.mStartedCount;
+    manager.FindOrEstablish(kNodeA);
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == startedCount + 1);
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 1, kFailures + 1));
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeA, CHIP_NO_ERROR));
+
+    manager.Shutdown();
+}
+
+void TestReleaseFabricWhileQueued(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    ManualCASESessionManager manager;
+    NL_TEST_ASSERT(apSuite, manager.Init(ctx, 1, System::Clock::kZero) == CHIP_NO_ERROR);
+
+    manager.FindOrEstablish(kNodeA);
+    manager.FindOrEstablish(kNodeF);
+    manager.FindOrEstablish(kNodeB);
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 2, 1, 0));
+
+    // The running and queued session setups of the fabric go away without counting as failures, and free their slot.
+    manager.ReleaseSessionsForFabric(kFabric1);
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mReleased == 2);
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 1, 0, 0));
+
+    ctx.GetIOContext().DriveIO();
+    NL_TEST_ASSERT(apSuite, manager.mStartedCount == 2);
+    NL_TEST_ASSERT(apSuite, manager.WasStarted(1, kNodeF));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 1, 0));
+
+    NL_TEST_ASSERT(apSuite, manager.Complete(kNodeF, CHIP_NO_ERROR));
+    NL_TEST_ASSERT(apSuite, CountersAre(manager, 0, 0, 0));
+    NL_TEST_ASSERT(apSuite, manager.mSessionSetupPool.mReleased == 3);
+
+    manager.Shutdown();
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestConcurrencyLimit", TestConcurrencyLimit),
+    NL_TEST_DEF("TestAdmissionOrder", TestAdmissionOrder),
+    NL_TEST_DEF("TestJoinRaisesPriority", TestJoinRaisesPriority),
+    NL_TEST_DEF("TestBackoff", TestBackoff),
+    NL_TEST_DEF("TestReleaseFabricWhileQueued", TestReleaseFabricWhileQueued),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "TestCASESessionManager",
+    &sTests[0],
+    NL_TEST_WRAP_FUNCTION(TestContext::SetUpTestSuite),
+    NL_TEST_WRAP_FUNCTION(TestContext::TearDownTestSuite),
+    NL_TEST_WRAP_METHOD(TestContext, SetUp),
+    NL_TEST_WRAP_METHOD(TestContext, TearDown),
+};
+// clang-format on
+
+} // namespace
+
+int TestCASESessionManager()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCASESessionManager)
@@ -684,10 +684,192 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+class NullCacheCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+void ReportInt16u(ReadClient::Callback & callback, const ConcreteAttributePath & path, uint16_t value)
+{
+    uint8_t buffer[16];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+
+    ConcreteDataAttributePath dataPath(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    dataPath.mDataVersion.SetValue(1);
+    callback.OnAttributeData(dataPath, &reader, StatusIB());
+}
+
+uint16_t ExpectedInt16u(const ConcreteAttributePath & path)
+{
+    return static_cast<uint16_t>((path.mEndpointId << 8) | (path.mClusterId == Clusters::OnOff::Id ? 0x80 : 0) | path.mAttributeId);
+}
+
+/*
+ * A reader returned by Get() stays valid while other paths are added to the cache.  With flat storage, the entries for
+ * those paths are inserted before the ones of the read attribute at every level of the cache, which moves them.
+ */
+void TestGetReaderAcrossInsertions(nlTestSuite * apSuite, void * apContext)
+{
+    NullCacheCallback nullCallback;
+    ClusterStateCache cache(nullCallback);
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    const ConcreteAttributePath heldPath(5, Clusters::UnitTesting::Id, 0x10);
+    callback.OnReportBegin();
+    ReportInt16u(callback, heldPath, ExpectedInt16u(heldPath));
+    callback.OnReportEnd();
+
+    TLV::TLVReader heldReader;
+    NL_TEST_ASSERT(apSuite, cache.Get(heldPath, heldReader) == CHIP_NO_ERROR);
+
+    std::vector<ConcreteAttributePath> paths;
+    for (EndpointId endpoint = 0; endpoint <= heldPath.mEndpointId; endpoint++)
+    {
+        for (ClusterId cluster : { Clusters::OnOff::Id, Clusters::UnitTesting::Id })
+        {
+            for (AttributeId attribute = 0; attribute < heldPath.mAttributeId; attribute++)
+            {
+                paths.emplace_back(endpoint, cluster, attribute);
+            }
+        }
+    }
+
+    callback.OnReportBegin();
+    for (auto & path : paths)
+    {
+        ReportInt16u(callback, path, ExpectedInt16u(path));
+    }
+    callback.OnReportEnd();
+
+    uint16_t value = 0;
+    NL_TEST_ASSERT(apSuite, DataModel::Decode(heldReader, value) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, value == ExpectedInt16u(heldPath));
+
+    paths.push_back(heldPath);
+    for (auto & path : paths)
+    {
+        TLV::TLVReader reader;
+        NL_TEST_ASSERT(apSuite, cache.Get(path, reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, DataModel::Decode(reader, value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, value == ExpectedInt16u(path));
+    }
+
+    TLV::TLVReader reader;
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get(ConcreteAttributePath(heldPath.mEndpointId + 1, Clusters::UnitTesting::Id, 0), reader) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+} // namespace
+
+#if CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+namespace chip {
+namespace app {
+
+class TestClusterStateCacheStorage
+{
+public:
+    static void TestFlatMapLookupAndIteration(nlTestSuite * apSuite, void * apContext);
+    static void TestFlatMapInsertWhileHoldingReference(nlTestSuite * apSuite, void * apContext);
+};
+
+void TestClusterStateCacheStorage::TestFlatMapLookupAndIteration(nlTestSuite * apSuite, void * apContext)
+{
+    ClusterStateCache::FlatMap<uint32_t, uint32_t> map;
+    NL_TEST_ASSERT(apSuite, map.begin() == map.end());
+    NL_TEST_ASSERT(apSuite, map.find(1) == map.end());
+
+    for (uint32_t key : { 5, 1, 9, 3, 7 })
+    {
+        map[key] = key * 10;
+    }
+
+    // Looking up an existing key does not add an entry.
+    map[5] += 1;
+    NL_TEST_ASSERT(apSuite, std::distance(map.begin(), map.end()) == 5);
+
+    // Entries are iterated in key order.
+    const uint32_t expectedKeys[] = { 1, 3, 5, 7, 9 };
+    size_t index                  = 0;
+    for (auto & entry : map)
+    {
+        NL_TEST_ASSERT(apSuite, entry.first == expectedKeys[index]);
+        NL_TEST_ASSERT(apSuite, entry.second == entry.first * 10 + (entry.first == 5 ? 1 : 0));
+        index++;
+    }
+
+    const auto & constMap = map;
+    for (uint32_t key : expectedKeys)
+    {
+        auto iter = constMap.find(key);
+        NL_TEST_ASSERT(apSuite, iter != constMap.end());
+        NL_TEST_ASSERT(apSuite, iter->first == key);
+    }
+    for (uint32_t key : { 0, 4, 10 })
+    {
+        NL_TEST_ASSERT(apSuite, map.find(key) == map.end());
+        NL_TEST_ASSERT(apSuite, constMap.find(key) == constMap.end());
+    }
+}
+
+void TestClusterStateCacheStorage::TestFlatMapInsertWhileHoldingReference(nlTestSuite * apSuite, void * apContext)
+{
+    ClusterStateCache::FlatMap<AttributeId, ClusterStateCache::AttributeData> map;
+
+    const uint8_t kData[] = { 'a', 'b', 'c', 'd' };
+    auto & heldValue      = map[100];
+    heldValue.Alloc(sizeof(kData));
+    NL_TEST_ASSERT(apSuite, heldValue.Get() != nullptr);
+    memcpy(heldValue.Get(), kData, sizeof(kData));
+    const uint8_t * heldData = heldValue.Get();
+
+    // Unlike with std::map, heldValue may refer to another entry, or to freed memory, once keys are inserted before
+    // it: it must be looked up again.  The data buffer it owned does not move with it.
+    for (AttributeId key = 0; key < 100; key++)
+    {
+        auto & value = map[key];
+        value.Alloc(1);
+        NL_TEST_ASSERT(apSuite, value.Get() != nullptr);
+        value[0] = static_cast<uint8_t>(key);
+    }
+
+    auto iter = map.find(100);
+    NL_TEST_ASSERT(apSuite, iter != map.end());
+    NL_TEST_ASSERT(apSuite, iter->second.Get() == heldData);
+    NL_TEST_ASSERT(apSuite, iter->second.AllocatedSize() == sizeof(kData));
+    NL_TEST_ASSERT(apSuite, memcmp(iter->second.Get(), kData, sizeof(kData)) == 0);
+
+    for (AttributeId key = 0; key < 100; key++)
+    {
+        iter = map.find(key);
+        NL_TEST_ASSERT(apSuite, iter != map.end());
+        NL_TEST_ASSERT(apSuite, iter->second[0] == key);
+    }
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+
+namespace {
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestGetReaderAcrossInsertions", TestGetReaderAcrossInsertions),
+#if CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+    NL_TEST_DEF("TestFlatMapLookupAndIteration", chip::app::TestClusterStateCacheStorage::TestFlatMapLookupAndIteration),
+    NL_TEST_DEF("TestFlatMapInsertWhileHoldingReference",
+                chip::app::TestClusterStateCacheStorage::TestFlatMapInsertWhileHoldingReference),
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
     NL_TEST_SENTINEL()
 };
 
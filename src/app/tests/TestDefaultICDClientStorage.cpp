@@ -251,6 +251,91 @@ void TestProcessCheckInPayload(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_NOT_FOUND);
 }
 
+CHIP_ERROR ProcessCheckIn(DefaultICDClientStorage & manager, const ICDClientInfo & sender, uint32_t counter,
+                          ICDClientInfo & decodeClientInfo, uint32_t & checkInCounter)
+{
+    uint8_t buffer[chip::Protocols::SecureChannel::CheckinMessage::kMinPayloadSize];
+    MutableByteSpan output(buffer);
+    ReturnErrorOnFailure(chip::Protocols::SecureChannel::CheckinMessage::GenerateCheckinMessagePayload(
+        sender.aes_key_handle, sender.hmac_key_handle, counter, ByteSpan(), output));
+    return manager.ProcessCheckInPayload(output, decodeClientInfo, checkInCounter);
+}
+
+void TestProcessCheckInPayloadManyClients(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr size_t kClientCount = 20;
+    FabricIndex fabricId          = 1;
+    TestPersistentStorageDelegate clientInfoStorage;
+    TestSessionKeystoreImpl keystore;
+
+    DefaultICDClientStorage manager;
+    NL_TEST_ASSERT(apSuite, manager.Init(&clientInfoStorage, &keystore) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, manager.UpdateFabricList(fabricId) == CHIP_NO_ERROR);
+
+    ICDClientInfo clientInfos[kClientCount];
+    for (size_t i = 0; i < kClientCount; i++)
+    {
+        uint8_t key[sizeof(kKeyBuffer1)];
+        memcpy(key, kKeyBuffer1, sizeof(key));
+        key[0] = static_cast<uint8_t>(i);
+
+        clientInfos[i].peer_node         = ScopedNodeId(static_cast<NodeId>(1000 + i), fabricId);
+        clientInfos[i].start_icd_counter = static_cast<uint32_t>(100 * i);
+        NL_TEST_ASSERT(apSuite, manager.SetKey(clientInfos[i], ByteSpan(key)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, manager.StoreEntry(clientInfos[i]) == CHIP_NO_ERROR);
+    }
+
+    ICDClientInfo decodeClientInfo;
+    uint32_t checkInCounter = 0;
+
+    // Each sender is found from its next check-in message, a retransmission of it, and a message sent after missing
+    // more check-ins than the precomputed nonces cover.
+    const uint32_t counterSteps[] = { 1, 0, DefaultICDClientStorage::kCheckInNonceWindow + 10, 1 };
+    for (auto & clientInfo : clientInfos)
+    {
+        uint32_t counter = clientInfo.start_icd_counter;
+        for (uint32_t step : counterSteps)
+        {
+            counter += step;
+            NL_TEST_ASSERT(apSuite,
+                           ProcessCheckIn(manager, clientInfo, counter, decodeClientInfo, checkInCounter) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, decodeClientInfo.peer_node == clientInfo.peer_node);
+            NL_TEST_ASSERT(apSuite, checkInCounter == counter);
+        }
+    }
+
+    // A deleted client is no longer found, and the others still are.
+    NL_TEST_ASSERT(apSuite, manager.DeleteEntry(clientInfos[0].peer_node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   ProcessCheckIn(manager, clientInfos[0], clientInfos[0].start_icd_counter + 1, decodeClientInfo,
+                                  checkInCounter) == CHIP_ERROR_NOT_FOUND);
+    for (size_t i = 1; i < kClientCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       ProcessCheckIn(manager, clientInfos[i], clientInfos[i].start_icd_counter + 1, decodeClientInfo,
+                                      checkInCounter) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, decodeClientInfo.peer_node == clientInfos[i].peer_node);
+    }
+
+    // A client stored again with a new key is only found with the new key.
+    ICDClientInfo refreshedClientInfo = clientInfos[1];
+    NL_TEST_ASSERT(apSuite, manager.SetKey(refreshedClientInfo, ByteSpan(kKeyBuffer2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, manager.StoreEntry(refreshedClientInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   ProcessCheckIn(manager, clientInfos[1], clientInfos[1].start_icd_counter + 2, decodeClientInfo,
+                                  checkInCounter) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite,
+                   ProcessCheckIn(manager, refreshedClientInfo, refreshedClientInfo.start_icd_counter + 2, decodeClientInfo,
+                                  checkInCounter) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, decodeClientInfo.peer_node == refreshedClientInfo.peer_node);
+
+    // Clients of a removed fabric are no longer found.
+    NL_TEST_ASSERT(apSuite, manager.DeleteAllEntries(fabricId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   ProcessCheckIn(manager, clientInfos[2], clientInfos[2].start_icd_counter + 1, decodeClientInfo,
+                                  checkInCounter) == CHIP_ERROR_NOT_FOUND);
+}
+
 /**
  *  Set up the test suite.
  */
@@ -281,6 +366,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("TestClientInfoCount", TestClientInfoCount),
     NL_TEST_DEF("TestClientInfoCountMultipleFabric", TestClientInfoCountMultipleFabric),
     NL_TEST_DEF("TestProcessCheckInPayload", TestProcessCheckInPayload),
+    NL_TEST_DEF("TestProcessCheckInPayloadManyClients", TestProcessCheckInPayloadManyClients),
 
     NL_TEST_SENTINEL()
 };
@@ -309,9 +309,110 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+static size_t FetchEventCount(nlTestSuite * apSuite, chip::app::EventManagement & aLogMgmt, chip::EventNumber aStartingEventNumber)
+{
+    chip::SingleLinkedListNode<chip::app::EventPathParams> wildcardPath;
+    chip::TLV::TLVWriter writer;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> backingStore;
+    size_t eventCount = 0;
+    VerifyOrDie(backingStore.Alloc(1024));
+
+    writer.Init(backingStore.Get(), 1024);
+    CHIP_ERROR err =
+        aLogMgmt.FetchEventsSince(writer, &wildcardPath, aStartingEventNumber, eventCount, chip::Access::SubjectDescriptor{});
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV);
+    return eventCount;
+}
+
+static void CheckFetchEventsSinceAfterWrap(nlTestSuite * apSuite, void * apContext)
+{
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Critical;
+    TestEventGenerator testEventGenerator;
+    chip::EventNumber lastEventNumber = 0;
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // Wrap every buffer several times, so that events get moved to more important buffers and eventually dropped.
+    for (int32_t i = 0; i < 40; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, lastEventNumber) == CHIP_NO_ERROR);
+    }
+
+    // Only critical events are logged, so the stored events have consecutive numbers ending at lastEventNumber.
+    const size_t storedEventCount = FetchEventCount(apSuite, logMgmt, 0);
+    NL_TEST_ASSERT(apSuite, storedEventCount > 0 && storedEventCount < 40);
+
+    for (chip::EventNumber eventMin = 0; eventMin <= lastEventNumber + 1; eventMin++)
+    {
+        const size_t expectedEventCount = std::min(storedEventCount, static_cast<size_t>(lastEventNumber + 1 - eventMin));
+        NL_TEST_ASSERT(apSuite, FetchEventCount(apSuite, logMgmt, eventMin) == expectedEventCount);
+    }
+}
+
+static void CheckRestoreEventsFromPersistedState(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    // Outlive the test, as the event management is only destroyed on teardown.
+    static chip::app::PersistedEventBufferState states[3];
+    static chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    const chip::app::LogStorageResources logStorageResources[] = {
+        { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), chip::app::PriorityLevel::Debug, &states[0] },
+        { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), chip::app::PriorityLevel::Info, &states[1] },
+        { &gCritEventBuffer[0], sizeof(gCritEventBuffer), chip::app::PriorityLevel::Critical, &states[2] },
+    };
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Info;
+    TestEventGenerator testEventGenerator;
+    chip::EventNumber lastEventNumber = 0;
+
+    for (auto & state : states)
+    {
+        state.store(0);
+    }
+
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(0) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (int32_t i = 0; i < 6; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, lastEventNumber) == CHIP_NO_ERROR);
+    }
+    const size_t storedEventCount = FetchEventCount(apSuite, logMgmt, 0);
+    NL_TEST_ASSERT(apSuite, storedEventCount > 0);
+
+    // Events logged before a restart are kept as long as the event numbers keep increasing.
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(lastEventNumber + 1) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+    NL_TEST_ASSERT(apSuite, FetchEventCount(apSuite, logMgmt, 0) == storedEventCount);
+    NL_TEST_ASSERT(apSuite, FetchEventCount(apSuite, logMgmt, lastEventNumber) == 1);
+
+    testEventGenerator.SetStatus(6);
+    NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, lastEventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, FetchEventCount(apSuite, logMgmt, lastEventNumber) == 1);
+
+    // Events numbered at or past the next event number cannot be trusted and are dropped.
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(0) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+    NL_TEST_ASSERT(apSuite, FetchEventCount(apSuite, logMgmt, 0) == 0);
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
     NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+    NL_TEST_DEF("CheckFetchEventsSinceAfterWrap", CheckFetchEventsSinceAfterWrap),
+    NL_TEST_DEF("CheckRestoreEventsFromPersistedState", CheckRestoreEventsFromPersistedState),
     NL_TEST_SENTINEL(),
 };
 
@@ -32,6 +32,7 @@
 #include <app/icd/server/ICDServerConfig.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
+#include <app/util/MatterCallbacks.h>
 #include <app/util/basic-types.h>
 #include <app/util/mock/Constants.h>
 #include <app/util/mock/Functions.h>
@@ -67,6 +68,9 @@ chip::EndpointId kInvalidTestEndpointId = 3;
 chip::DataVersion kTestDataVersion1     = 3;
 chip::DataVersion kTestDataVersion2     = 5;
 
+// Reads as the accessing fabric index, like a fabric-scoped attribute that has different data for every fabric.
+chip::AttributeId kTestFabricScopedAttributeId = 0x10;
+
 // Number of items in the list for MockAttributeId(4).
 constexpr int kMockAttribute4ListLength = 6;
 
@@ -292,6 +296,47 @@ public:
     }
 };
 
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+// Counts the data model callbacks around attribute reads.
+class CountingDataModelCallbacks : public chip::DataModelCallbacks
+{
+public:
+    void AttributeOperation(OperationType operation, OperationOrder order, const chip::app::ConcreteAttributePath & path) override
+    {
+        if (operation == OperationType::Read)
+        {
+            (order == OperationOrder::Pre ? mPreReads : mPostReads)++;
+        }
+    }
+
+    int mPreReads  = 0;
+    int mPostReads = 0;
+};
+
+// Denies everything to a single fabric.
+class DenyFabricAccessControlDelegate : public chip::Access::AccessControl::Delegate
+{
+public:
+    CHIP_ERROR Check(const chip::Access::SubjectDescriptor & subjectDescriptor, const chip::Access::RequestPath & requestPath,
+                     chip::Access::Privilege requestPrivilege) override
+    {
+        return subjectDescriptor.fabricIndex == mDeniedFabricIndex ? CHIP_ERROR_ACCESS_DENIED : CHIP_NO_ERROR;
+    }
+
+    chip::FabricIndex mDeniedFabricIndex = chip::kUndefinedFabricIndex;
+};
+
+class NoDeviceTypeResolver : public chip::Access::AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(chip::DeviceTypeId deviceType, chip::EndpointId endpoint) override { return false; }
+};
+
+// Outlive the tests that install them, as the access control is only reset by the test context teardown.
+DenyFabricAccessControlDelegate gDenyFabricAccessControlDelegate;
+NoDeviceTypeResolver gNoDeviceTypeResolver;
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
 } // namespace
 
 using ReportScheduler     = chip::app::reporting::ReportScheduler;
@@ -310,6 +355,13 @@ CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescr
         return Test::ReadSingleMockClusterData(aSubjectDescriptor.fabricIndex, aPath, aAttributeReports, apEncoderState);
     }
 
+    if (aPath.mClusterId == kTestClusterId && aPath.mEndpointId == kTestEndpointId &&
+        aPath.mAttributeId == kTestFabricScopedAttributeId)
+    {
+        return AttributeValueEncoder(aAttributeReports, aSubjectDescriptor, aPath, Test::GetVersion(), aIsFabricFiltered)
+            .Encode(aSubjectDescriptor.fabricIndex);
+    }
+
     if (!(aPath.mClusterId == kTestClusterId && aPath.mEndpointId == kTestEndpointId))
     {
         AttributeReportIB::Builder & attributeReport = aAttributeReports.CreateAttributeReport();
@@ -419,6 +471,12 @@ public:
     static void TestShutdownSubscription(nlTestSuite * apSuite, void * apContext);
     static void TestSubscriptionReportWithDefunctSession(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandlerMalformedSubscribeRequest(nlTestSuite * apSuite, void * apContext);
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    static void TestReportEncodingCacheFabricScopedAttribute(nlTestSuite * apSuite, void * apContext);
+    static void TestReportEncodingCacheAccessDenied(nlTestSuite * apSuite, void * apContext);
+    static void TestReportEncodingCacheDataVersionChange(nlTestSuite * apSuite, void * apContext);
+    static void TestReportEncodingCacheOutOfSpace(nlTestSuite * apSuite, void * apContext);
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
 
 private:
     enum class ReportType : uint8_t
@@ -430,6 +488,13 @@ private:
 
     static void GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
                                    ReportType aReportType, bool aSuppressResponse, bool aHasSubscriptionId);
+
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    // Encodes kTestFabricScopedAttributeId for the read handler through the report encoding cache, and decodes the value and
+    // data version it reports.
+    static CHIP_ERROR ReadThroughReportEncodingCache(ReadHandler & aReadHandler, uint8_t & aValue, DataVersion & aDataVersion,
+                                                     uint32_t & aLengthWritten);
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
 };
 
 void TestReadInteraction::GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
@@ -5055,6 +5120,235 @@ void TestReadInteraction::TestSubscriptionReportWithDefunctSession(nlTestSuite *
     ctx.CreateSessionAliceToBob();
 }
 
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+CHIP_ERROR TestReadInteraction::ReadThroughReportEncodingCache(ReadHandler & aReadHandler, uint8_t & aValue,
+                                                               DataVersion & aDataVersion, uint32_t & aLengthWritten)
+{
+    uint8_t buffer[128];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    aLengthWritten = 0;
+
+    AttributeReportIBs::Builder attributeReportIBs;
+    ReturnErrorOnFailure(attributeReportIBs.Init(&writer));
+    uint32_t emptyLength = writer.GetLengthWritten();
+    ConcreteReadAttributePath path(kTestEndpointId, kTestClusterId, kTestFabricScopedAttributeId);
+    bool isEncoded = false;
+    CHIP_ERROR err = InteractionModelEngine::GetInstance()->GetReportingEngine().RetrieveClusterDataFromCache(
+        aReadHandler, attributeReportIBs, path, isEncoded);
+    aLengthWritten = writer.GetLengthWritten() - emptyLength;
+    ReturnErrorOnFailure(err);
+    ReturnErrorOnFailure(attributeReportIBs.EndOfAttributeReportIBs());
+    ReturnErrorOnFailure(writer.Finalize());
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    ReturnErrorOnFailure(reader.Next());
+
+    AttributeReportIBs::Parser attributeReportIBsParser;
+    ReturnErrorOnFailure(attributeReportIBsParser.Init(reader));
+    TLV::TLVReader reportsReader;
+    attributeReportIBsParser.GetReader(&reportsReader);
+    ReturnErrorOnFailure(reportsReader.Next());
+
+    AttributeReportIB::Parser attributeReportParser;
+    ReturnErrorOnFailure(attributeReportParser.Init(reportsReader));
+    AttributeDataIB::Parser attributeDataParser;
+    ReturnErrorOnFailure(attributeReportParser.GetAttributeData(&attributeDataParser));
+    ReturnErrorOnFailure(attributeDataParser.GetDataVersion(&aDataVersion));
+    TLV::TLVReader dataReader;
+    ReturnErrorOnFailure(attributeDataParser.GetData(&dataReader));
+    return dataReader.Get(aValue);
+}
+
+void TestReadInteraction::TestReportEncodingCacheFabricScopedAttribute(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    NullReadHandlerCallback nullCallback;
+    CountingDataModelCallbacks callbacks;
+    DataModelCallbacks * previousCallbacks = DataModelCallbacks::SetInstance(&callbacks);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite, engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler) == CHIP_NO_ERROR);
+    engine->GetReportingEngine().ClearReportEncodingCache();
+
+    {
+        // Subscribers on Bob's fabric, then on Alice's, then on Bob's again.
+        ReadHandler bobHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                               gReportScheduler);
+        ReadHandler aliceHandler(nullCallback, ctx.NewExchangeToBob(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                 gReportScheduler);
+        ReadHandler otherBobHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                    gReportScheduler);
+        bobHandler.SetStateFlag(ReadHandler::ReadHandlerFlags::FabricFiltered);
+        aliceHandler.SetStateFlag(ReadHandler::ReadHandlerFlags::FabricFiltered);
+        otherBobHandler.SetStateFlag(ReadHandler::ReadHandlerFlags::FabricFiltered);
+
+        uint8_t value           = 0;
+        DataVersion dataVersion = 0;
+        uint32_t lengthWritten  = 0;
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(bobHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, value == ctx.GetBobFabricIndex());
+
+        // The encoding for Bob's fabric is not handed to Alice's.
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(aliceHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, value == ctx.GetAliceFabricIndex());
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 2);
+
+        // But it is shared with the other subscriber on Bob's fabric, which still gets the read callbacks.
+        NL_TEST_ASSERT(apSuite,
+                       ReadThroughReportEncodingCache(otherBobHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, value == ctx.GetBobFabricIndex());
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 2);
+        NL_TEST_ASSERT(apSuite, callbacks.mPreReads == 3);
+        NL_TEST_ASSERT(apSuite, callbacks.mPostReads == 3);
+    }
+
+    engine->Shutdown();
+    DataModelCallbacks::SetInstance(previousCallbacks);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestReadInteraction::TestReportEncodingCacheAccessDenied(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    NullReadHandlerCallback nullCallback;
+
+    gDenyFabricAccessControlDelegate.mDeniedFabricIndex = kUndefinedFabricIndex;
+    Access::GetAccessControl().Finish();
+    NL_TEST_ASSERT(apSuite,
+                   Access::GetAccessControl().Init(&gDenyFabricAccessControlDelegate, gNoDeviceTypeResolver) == CHIP_NO_ERROR);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite, engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler) == CHIP_NO_ERROR);
+    engine->GetReportingEngine().ClearReportEncodingCache();
+
+    {
+        ReadHandler allowedHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                   gReportScheduler);
+        ReadHandler deniedHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                  gReportScheduler);
+
+        uint8_t value           = 0;
+        DataVersion dataVersion = 0;
+        uint32_t lengthWritten  = 0;
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(allowedHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, lengthWritten > 0);
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 1);
+
+        // The second subscriber would hit the cached encoding, but is denied access by the time it reports: it gets nothing from
+        // the cache, and is left to the uncached path to report the denial.
+        gDenyFabricAccessControlDelegate.mDeniedFabricIndex = ctx.GetBobFabricIndex();
+        NL_TEST_ASSERT(apSuite,
+                       ReadThroughReportEncodingCache(deniedHandler, value, dataVersion, lengthWritten) ==
+                           CHIP_ERROR_ACCESS_DENIED);
+        NL_TEST_ASSERT(apSuite, lengthWritten == 0);
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 1);
+    }
+
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestReadInteraction::TestReportEncodingCacheDataVersionChange(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    NullReadHandlerCallback nullCallback;
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite, engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler) == CHIP_NO_ERROR);
+    engine->GetReportingEngine().ClearReportEncodingCache();
+
+    {
+        ReadHandler firstHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                 gReportScheduler);
+        ReadHandler secondHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                  gReportScheduler);
+
+        uint8_t value                  = 0;
+        DataVersion dataVersion        = 0;
+        uint32_t lengthWritten         = 0;
+        DataVersion initialDataVersion = Test::GetVersion();
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(firstHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, dataVersion == initialDataVersion);
+
+        // The attribute changes between the two handlers of the same run: the second one must not get the stale encoding.
+        Test::BumpVersion();
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(secondHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, dataVersion == initialDataVersion + 1);
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 2);
+
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(firstHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, dataVersion == initialDataVersion + 1);
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 2);
+    }
+
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestReadInteraction::TestReportEncodingCacheOutOfSpace(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    NullReadHandlerCallback nullCallback;
+    CountingDataModelCallbacks callbacks;
+    DataModelCallbacks * previousCallbacks = DataModelCallbacks::SetInstance(&callbacks);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite, engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler) == CHIP_NO_ERROR);
+    engine->GetReportingEngine().ClearReportEncodingCache();
+
+    {
+        ReadHandler readHandler(nullCallback, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                gReportScheduler);
+        readHandler.SetStateFlag(ReadHandler::ReadHandlerFlags::FabricFiltered);
+        ConcreteReadAttributePath path(kTestEndpointId, kTestClusterId, kTestFabricScopedAttributeId);
+
+        // Room for the AttributeReportIBs container, but not for the report in it.
+        uint8_t buffer[8];
+        TLV::TLVWriter writer;
+        writer.Init(buffer);
+        AttributeReportIBs::Builder attributeReportIBs;
+        NL_TEST_ASSERT(apSuite, attributeReportIBs.Init(&writer) == CHIP_NO_ERROR);
+        uint32_t emptyLength = writer.GetLengthWritten();
+
+        // The attribute is read into the cache, but does not fit in the report.  The caller is told that it has an encoding,
+        // so that it ends the chunk instead of reading the attribute again.
+        bool isEncoded = false;
+        CHIP_ERROR err =
+            engine->GetReportingEngine().RetrieveClusterDataFromCache(readHandler, attributeReportIBs, path, isEncoded);
+        NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY);
+        NL_TEST_ASSERT(apSuite, isEncoded);
+        NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == emptyLength);
+        NL_TEST_ASSERT(apSuite, callbacks.mPreReads == 1);
+        NL_TEST_ASSERT(apSuite, callbacks.mPostReads == 1);
+
+        // On a cache hit that does not fit, the data model is not told about a read at all.
+        isEncoded = false;
+        err       = engine->GetReportingEngine().RetrieveClusterDataFromCache(readHandler, attributeReportIBs, path, isEncoded);
+        NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY);
+        NL_TEST_ASSERT(apSuite, isEncoded);
+        NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == emptyLength);
+        NL_TEST_ASSERT(apSuite, callbacks.mPreReads == 1);
+        NL_TEST_ASSERT(apSuite, callbacks.mPostReads == 1);
+
+        // The next chunk has room for it, and gets it from the cache.
+        uint8_t value           = 0;
+        DataVersion dataVersion = 0;
+        uint32_t lengthWritten  = 0;
+        NL_TEST_ASSERT(apSuite, ReadThroughReportEncodingCache(readHandler, value, dataVersion, lengthWritten) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, value == ctx.GetBobFabricIndex());
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mReportEncodingCacheEntryCount == 1);
+        NL_TEST_ASSERT(apSuite, callbacks.mPreReads == 2);
+        NL_TEST_ASSERT(apSuite, callbacks.mPostReads == 2);
+    }
+
+    engine->Shutdown();
+    DataModelCallbacks::SetInstance(previousCallbacks);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
 } // namespace app
 } // namespace chip
 
@@ -5146,6 +5440,14 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestReadShutdown", chip::app::TestReadInteraction::TestReadShutdown),
     NL_TEST_DEF("TestSubscriptionReportWithDefunctSession",
                 chip::app::TestReadInteraction::TestSubscriptionReportWithDefunctSession),
+#if CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE > 0
+    NL_TEST_DEF("TestReportEncodingCacheFabricScopedAttribute",
+                chip::app::TestReadInteraction::TestReportEncodingCacheFabricScopedAttribute),
+    NL_TEST_DEF("TestReportEncodingCacheAccessDenied", chip::app::TestReadInteraction::TestReportEncodingCacheAccessDenied),
+    NL_TEST_DEF("TestReportEncodingCacheDataVersionChange",
+                chip::app::TestReadInteraction::TestReportEncodingCacheDataVersionChange),
+    NL_TEST_DEF("TestReportEncodingCacheOutOfSpace", chip::app::TestReadInteraction::TestReportEncodingCacheOutOfSpace),
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
     NL_TEST_SENTINEL(),
 };
 
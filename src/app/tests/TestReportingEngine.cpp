@@ -27,6 +27,7 @@
 #include <app/reporting/Engine.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
 #include <lib/core/TLV.h>
@@ -45,7 +46,9 @@ using TestContext = chip::Test::AppContext;
 namespace chip {
 
 constexpr ClusterId kTestClusterId        = 6;
+constexpr ClusterId kTestClusterId2       = 7;
 constexpr EndpointId kTestEndpointId      = 1;
+constexpr EndpointId kTestEndpointId2     = 2;
 constexpr chip::AttributeId kTestFieldId1 = 1;
 constexpr chip::AttributeId kTestFieldId2 = 2;
 
@@ -57,10 +60,18 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestSetDirtyAfterAttributePathListChange(nlTestSuite * apSuite, void * apContext);
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
 
+    // Whether the read handler was marked dirty by the last SetDirty call.
+    static bool IsDirtyForLastChange(const ReadHandler * apReadHandler)
+    {
+        return apReadHandler->mDirtyGeneration ==
+            InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
+    }
+
     struct ExpectedDirtySetContent : public AttributePathParams
     {
         ExpectedDirtySetContent(const AttributePathParams & path) : AttributePathParams(path) {}
@@ -330,6 +341,130 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestSetDirtyAfterAttributePathListChange(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    DummyDelegate dummy;
+    auto * imEngine = InteractionModelEngine::GetInstance();
+    Engine & engine = imEngine->GetReportingEngine();
+
+    CHIP_ERROR err = imEngine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // The handlers are allocated by the interaction model engine, like those of real reads and subscriptions, so that the
+    // reporting engine sees them.
+    ReadHandler * concreteHandler = imEngine->mReadHandlers.CreateObject(dummy, app::reporting::GetDefaultReportScheduler());
+    ReadHandler * clusterHandler  = imEngine->mReadHandlers.CreateObject(dummy, app::reporting::GetDefaultReportScheduler());
+    ReadHandler * wildcardHandler = imEngine->mReadHandlers.CreateObject(dummy, app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, concreteHandler != nullptr && clusterHandler != nullptr && wildcardHandler != nullptr);
+
+    concreteHandler->mState = ReadHandler::HandlerState::CanStartReporting;
+    clusterHandler->mState  = ReadHandler::HandlerState::CanStartReporting;
+    wildcardHandler->mState = ReadHandler::HandlerState::CanStartReporting;
+
+    AttributePathParams concretePath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    AttributePathParams otherClusterPath(kTestEndpointId, kTestClusterId2);
+    AttributePathParams wildcardEndpointPath;
+    wildcardEndpointPath.mClusterId = kTestClusterId;
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->PushFrontAttributePathList(concreteHandler->mpAttributePathList, concretePath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->PushFrontAttributePathList(clusterHandler->mpAttributePathList, otherClusterPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->PushFrontAttributePathList(wildcardHandler->mpAttributePathList, wildcardEndpointPath) ==
+                       CHIP_NO_ERROR);
+
+    // Builds the index.
+    AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(clusterHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(wildcardHandler));
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, !engine.mInterestIndexStale);
+    NL_TEST_ASSERT(apSuite, engine.mInterestEntryCount == 3);
+    NL_TEST_ASSERT(apSuite, engine.mWildcardInterestEntryCount == 1);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+    // A path added to a handler after the index was built is found.
+    AttributePathParams addedPath(kTestEndpointId2, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, imEngine->PushFrontAttributePathList(clusterHandler->mpAttributePathList, addedPath) == CHIP_NO_ERROR);
+    dirtyPath = AttributePathParams(kTestEndpointId2, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(clusterHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(wildcardHandler));
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.mInterestEntryCount == 4);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+    // A released path list is no longer matched.
+    imEngine->ReleaseAttributePathList(concreteHandler->mpAttributePathList);
+    dirtyPath = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(clusterHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(wildcardHandler));
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.mInterestEntryCount == 3);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+    // Paths dropped as duplicates are no longer indexed; the path that covers them still is.  Only paths to attributes that
+    // exist are dropped, so these are in the mock data model.
+    AttributePathParams duplicatePath(Test::kMockEndpoint3, Test::MockClusterId(2), Test::MockAttributeId(1));
+    AttributePathParams coveringPath(Test::kMockEndpoint3, Test::MockClusterId(2));
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->PushFrontAttributePathList(concreteHandler->mpAttributePathList, duplicatePath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->PushFrontAttributePathList(concreteHandler->mpAttributePathList, coveringPath) == CHIP_NO_ERROR);
+    dirtyPath = AttributePathParams(Test::kMockEndpoint3, Test::MockClusterId(2), Test::MockAttributeId(1));
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(concreteHandler));
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.mInterestEntryCount == 5);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+    imEngine->RemoveDuplicateConcreteAttributePath(concreteHandler->mpAttributePathList);
+    NL_TEST_ASSERT(apSuite, concreteHandler->GetAttributePathCount() == 1);
+    dirtyPath = AttributePathParams(Test::kMockEndpoint3, Test::MockClusterId(2), Test::MockAttributeId(2));
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(clusterHandler));
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(wildcardHandler));
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.mInterestEntryCount == 4);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+    // Dirty paths with a wildcard endpoint or cluster are matched against the updated path lists as well.
+    dirtyPath            = AttributePathParams();
+    dirtyPath.mClusterId = kTestClusterId;
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(clusterHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(wildcardHandler));
+
+    dirtyPath             = AttributePathParams();
+    dirtyPath.mEndpointId = Test::kMockEndpoint3;
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(clusterHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(wildcardHandler));
+
+    // Releasing a handler drops its paths as well.
+    imEngine->mReadHandlers.ReleaseObject(clusterHandler);
+    dirtyPath = AttributePathParams(kTestEndpointId2, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !IsDirtyForLastChange(concreteHandler));
+    NL_TEST_ASSERT(apSuite, IsDirtyForLastChange(wildcardHandler));
+#if CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.mInterestEntryCount == 2);
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+    imEngine->mReadHandlers.ReleaseObject(concreteHandler);
+    imEngine->mReadHandlers.ReleaseObject(wildcardHandler);
+    engine.Shutdown();
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -341,6 +476,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestSetDirtyAfterAttributePathListChange", chip::app::reporting::TestReportingEngine::TestSetDirtyAfterAttributePathListChange),
     NL_TEST_SENTINEL()
 };
 // clang-format on
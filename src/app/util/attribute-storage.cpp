@@ -92,6 +92,21 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Indices into emAfEndpoints for every configured endpoint, sorted by endpoint
+// id (and by index for equal ids), so that endpoint lookups are a binary search
+// instead of a scan over all endpoints.  Nodes such as bridges can expose
+// hundreds of dynamic endpoints, and every attribute read/write starts with
+// this lookup.  Kept up to date by emberAfEndpointConfigure,
+// emberAfSetDynamicEndpoint and emberAfClearDynamicEndpoint.
+uint16_t sortedEndpointIndices[MAX_ENDPOINT_COUNT];
+uint16_t sortedEndpointIndexCount = 0;
+
+#if FIXED_ENDPOINT_COUNT > 0
+// Offset into attributeData of the storage for each fixed endpoint.  Dynamic
+// endpoints only use external storage, so they do not need an entry.
+uint16_t fixedEndpointStorageOffsets[FIXED_ENDPOINT_COUNT];
+#endif // FIXED_ENDPOINT_COUNT > 0
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -145,6 +160,71 @@ bool emberAfIsThisDataTypeAListType(EmberAfAttributeType dataType)
     return dataType == ZCL_ARRAY_ATTRIBUTE_TYPE;
 }
 
+// Returns true if the endpoint at index a sorts before the endpoint at index b
+// in sortedEndpointIndices.
+bool endpointIndexLess(uint16_t a, uint16_t b)
+{
+    if (emAfEndpoints[a].endpoint != emAfEndpoints[b].endpoint)
+    {
+        return emAfEndpoints[a].endpoint < emAfEndpoints[b].endpoint;
+    }
+    return a < b;
+}
+
+// Returns the position in sortedEndpointIndices of the first entry whose
+// endpoint id is not less than the given one.
+uint16_t lowerBoundSortedEndpoint(EndpointId endpoint)
+{
+    uint16_t low  = 0;
+    uint16_t high = sortedEndpointIndexCount;
+    while (low < high)
+    {
+        uint16_t mid = static_cast<uint16_t>(low + (high - low) / 2);
+        if (emAfEndpoints[sortedEndpointIndices[mid]].endpoint < endpoint)
+        {
+            low = static_cast<uint16_t>(mid + 1);
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Adds the endpoint at the given index to sortedEndpointIndices.  The endpoint
+// id at that index must already be set.
+void addSortedEndpointIndex(uint16_t index)
+{
+    VerifyOrReturn(emAfEndpoints[index].endpoint != kInvalidEndpointId);
+    VerifyOrReturn(sortedEndpointIndexCount < MAX_ENDPOINT_COUNT);
+
+    uint16_t pos = sortedEndpointIndexCount;
+    while (pos > 0 && endpointIndexLess(index, sortedEndpointIndices[pos - 1]))
+    {
+        sortedEndpointIndices[pos] = sortedEndpointIndices[pos - 1];
+        pos--;
+    }
+    sortedEndpointIndices[pos] = index;
+    sortedEndpointIndexCount++;
+}
+
+// Removes the endpoint at the given index from sortedEndpointIndices.  Must be
+// called before the endpoint id at that index is changed.
+void removeSortedEndpointIndex(uint16_t index)
+{
+    for (uint16_t pos = lowerBoundSortedEndpoint(emAfEndpoints[index].endpoint); pos < sortedEndpointIndexCount; pos++)
+    {
+        if (sortedEndpointIndices[pos] == index)
+        {
+            memmove(&sortedEndpointIndices[pos], &sortedEndpointIndices[pos + 1],
+                    sizeof(sortedEndpointIndices[0]) * static_cast<size_t>(sortedEndpointIndexCount - pos - 1));
+            sortedEndpointIndexCount--;
+            return;
+        }
+    }
+}
+
 uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
     if (endpoint == kInvalidEndpointId)
@@ -152,10 +232,14 @@ uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
+    for (uint16_t pos = lowerBoundSortedEndpoint(endpoint); pos < sortedEndpointIndexCount; pos++)
     {
-        if (emAfEndpoints[epi].endpoint == endpoint &&
+        uint16_t epi = sortedEndpointIndices[pos];
+        if (emAfEndpoints[epi].endpoint != endpoint)
+        {
+            break;
+        }
+        if (epi < emberAfEndpointCount() &&
             (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
         {
             return epi;
@@ -180,7 +264,8 @@ void emberAfEndpointConfigure()
     static_assert(FIXED_ENDPOINT_COUNT <= std::numeric_limits<decltype(ep)>::max(),
                   "FIXED_ENDPOINT_COUNT must not exceed the size of the endpoint data type");
 
-    emberEndpointCount = FIXED_ENDPOINT_COUNT;
+    emberEndpointCount       = FIXED_ENDPOINT_COUNT;
+    sortedEndpointIndexCount = 0;
 
 #if FIXED_ENDPOINT_COUNT > 0
 
@@ -204,6 +289,7 @@ void emberAfEndpointConfigure()
 #endif // ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT > 0
 
     DataVersion * currentDataVersions = fixedEndpointDataVersions;
+    uint16_t currentStorageOffset     = 0;
     for (ep = 0; ep < FIXED_ENDPOINT_COUNT; ep++)
     {
         emAfEndpoints[ep].endpoint = fixedEndpoints[ep];
@@ -219,6 +305,13 @@ void emberAfEndpointConfigure()
         // Increment currentDataVersions by 1 (slot) for every server cluster
         // this endpoint has.
         currentDataVersions += emberAfClusterCountByIndex(ep, /* server = */ true);
+
+        // Storage for fixed endpoints is laid out back to back in attributeData.
+        fixedEndpointStorageOffsets[ep] = currentStorageOffset;
+        // Advance past this endpoint's storage for the next one.
+        currentStorageOffset = static_cast<uint16_t>(currentStorageOffset + emAfEndpoints[ep].endpointType->endpointSize);
+
+        addSortedEndpointIndex(ep);
     }
 
 #endif // FIXED_ENDPOINT_COUNT > 0
@@ -249,10 +342,14 @@ uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t index;
-    for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT; index++)
+    for (uint16_t pos = lowerBoundSortedEndpoint(id); pos < sortedEndpointIndexCount; pos++)
     {
-        if (emAfEndpoints[index].endpoint == id)
+        uint16_t index = sortedEndpointIndices[pos];
+        if (emAfEndpoints[index].endpoint != id)
+        {
+            break;
+        }
+        if (index >= FIXED_ENDPOINT_COUNT)
         {
             return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
         }
@@ -282,14 +379,15 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     }
 
     index = static_cast<uint16_t>(realIndex);
-    for (uint16_t i = FIXED_ENDPOINT_COUNT; i < MAX_ENDPOINT_COUNT; i++)
+    if (emberAfGetDynamicIndexFromEndpoint(id) != kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[i].endpoint == id)
-        {
-            return CHIP_ERROR_ENDPOINT_EXISTS;
-        }
+        return CHIP_ERROR_ENDPOINT_EXISTS;
     }
 
+    // The slot may still hold a cleared endpoint's data; make sure it is not
+    // indexed under its old id.
+    removeSortedEndpointIndex(index);
+
     emAfEndpoints[index].endpoint       = id;
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
     emAfEndpoints[index].endpointType   = ep;
@@ -298,6 +396,8 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
 
+    addSortedEndpointIndex(index);
+
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
     // Initialize the data versions.
@@ -328,6 +428,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
     {
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
+        removeSortedEndpointIndex(index);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
     }
 
@@ -441,19 +542,62 @@ void emAfCallInits()
     }
 }
 
+// Returns the attribute of the cluster with the given id, or null if there is
+// none.  Generated and dynamic attribute lists are normally sorted by id, so a
+// binary search finds the attribute; only if it does not, because the list is
+// not sorted or the attribute is not there, is the whole list scanned.
+static const EmberAfAttributeMetadata * findAttributeInCluster(const EmberAfCluster * cluster, AttributeId attributeId)
+{
+    uint16_t low  = 0;
+    uint16_t high = cluster->attributeCount;
+    while (low < high)
+    {
+        uint16_t mid                        = static_cast<uint16_t>(low + (high - low) / 2);
+        const EmberAfAttributeMetadata * am = &(cluster->attributes[mid]);
+        if (am->attributeId == attributeId)
+        {
+            return am;
+        }
+        if (am->attributeId < attributeId)
+        {
+            low = static_cast<uint16_t>(mid + 1);
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    for (uint16_t attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+    {
+        if (cluster->attributes[attrIndex].attributeId == attributeId)
+        {
+            return &(cluster->attributes[attrIndex]);
+        }
+    }
+    return nullptr;
+}
+
 // Returns the pointer to metadata, or null if it is not found
 const EmberAfAttributeMetadata * emberAfLocateAttributeMetadata(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
 {
-    const EmberAfAttributeMetadata * metadata = nullptr;
-    EmberAfAttributeSearchRecord record;
-    record.endpoint    = endpoint;
-    record.clusterId   = clusterId;
-    record.attributeId = attributeId;
-    emAfReadOrWriteAttribute(&record, &metadata,
-                             nullptr, // buffer
-                             0,       // buffer size
-                             false);  // write?
-    return metadata;
+    assertChipStackLockedByCurrentThread();
+
+    // Unlike emAfReadOrWriteAttribute, this does not need the storage offset of
+    // the attribute, so it does not have to walk the attributes before it.
+    uint16_t ep = findIndexFromEndpoint(endpoint, true /* ignoreDisabledEndpoints */);
+    if (ep == kEmberInvalidEndpointIndex)
+    {
+        return nullptr;
+    }
+
+    const EmberAfCluster * cluster = emberAfFindClusterInType(emAfEndpoints[ep].endpointType, clusterId, CLUSTER_MASK_SERVER);
+    if (cluster == nullptr)
+    {
+        return nullptr;
+    }
+
+    return findAttributeInCluster(cluster, attributeId);
 }
 
 static uint8_t * singletonAttributeLocation(const EmberAfAttributeMetadata * am)
@@ -575,117 +719,110 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
-    uint16_t attributeOffsetIndex = 0;
+    uint16_t ep = findIndexFromEndpoint(attRecord->endpoint, true /* ignoreDisabledEndpoints */);
+    if (ep == kEmberInvalidEndpointIndex)
+    {
+        return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+    }
 
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    // Is this a dynamic endpoint?
+    bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+
+    // Dynamic endpoints are external and don't factor into storage size
+    uint16_t attributeOffsetIndex = 0;
+#if FIXED_ENDPOINT_COUNT > 0
+    if (!isDynamicEndpoint)
     {
-        // Is this a dynamic endpoint?
-        bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+        attributeOffsetIndex = fixedEndpointStorageOffsets[ep];
+    }
+#endif // FIXED_ENDPOINT_COUNT > 0
 
-        if (emAfEndpoints[ep].endpoint == attRecord->endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(ep))
-            {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+    uint8_t clusterIndex;
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+        if (emAfMatchCluster(cluster, attRecord))
+        { // Got the cluster
+            uint16_t attrIndex;
+            for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
             {
-                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+                const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                if (emAfMatchAttribute(cluster, am, attRecord))
+                { // Got the attribute
+                    // If passed metadata location is not null, populate
+                    if (metadata != nullptr)
                     {
-                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
+                        *metadata = am;
+                    }
 
+                    {
+                        uint8_t * attributeLocation =
+                            (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
+                                                                 : attributeData + attributeOffsetIndex);
+                        uint8_t *src, *dst;
+                        if (write)
+                        {
+                            src = buffer;
+                            dst = attributeLocation;
+                            if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
                             {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return Status::Success;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return Status::Failure;
+                                return Status::UnsupportedAccess;
                             }
                         }
                         else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                        {
+                            if (buffer == nullptr)
+                            {
+                                return Status::Success;
+                            }
+
+                            src = attributeLocation;
+                            dst = buffer;
+                            if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
                             {
-                                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+                                return Status::UnsupportedAccess;
                             }
                         }
-                    }
 
-                    // Attribute is not in the cluster.
-                    return Status::UnsupportedAttribute;
-                }
+                        // Is the attribute externally stored?
+                        if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+                        {
+                            return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                                  buffer)
+                                          : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                                 buffer, emberAfAttributeSize(am)));
+                        }
 
-                // Not the cluster we are looking for
-                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
+                        // Internal storage is only supported for fixed endpoints
+                        if (!isDynamicEndpoint)
+                        {
+                            return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+                        }
+
+                        return Status::Failure;
+                    }
+                }
+                else
+                { // Not the attribute we are looking for
+                    // Increase the index if attribute is not externally stored
+                    if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                    {
+                        attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+                    }
+                }
             }
 
-            // Cluster is not in the endpoint.
-            return Status::UnsupportedCluster;
+            // Attribute is not in the cluster.
+            return Status::UnsupportedAttribute;
         }
 
-        // Not the endpoint we are looking for
-        // Dynamic endpoints are external and don't factor into storage size
-        if (!isDynamicEndpoint)
-        {
-            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[ep].endpointType->endpointSize);
-        }
+        // Not the cluster we are looking for
+        attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
     }
-    return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+
+    // Cluster is not in the endpoint.
+    return Status::UnsupportedCluster;
 }
 
 const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId)
@@ -729,18 +866,25 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    // Endpoints sharing an id are sorted by index, so they are visited in the
+    // same order as a scan over all endpoints would.
+    for (uint16_t pos = lowerBoundSortedEndpoint(endpoint); pos < sortedEndpointIndexCount; pos++)
     {
-        // Check the endpoint id first, because that way we avoid examining the
-        // endpoint type for endpoints that are not actually defined.
-        if (emAfEndpoints[ep].endpoint == endpoint)
+        uint16_t ep = sortedEndpointIndices[pos];
+        if (emAfEndpoints[ep].endpoint != endpoint)
         {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t index                            = 0xFF;
-            if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
-            {
-                return index;
-            }
+            break;
+        }
+        if (ep >= emberAfEndpointCount())
+        {
+            continue;
+        }
+
+        const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+        uint8_t index                            = 0xFF;
+        if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
+        {
+            return index;
         }
     }
     return 0xFF;
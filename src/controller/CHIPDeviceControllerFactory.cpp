@@ -38,7 +38,7 @@
 
 #include <app/server/Dnssd.h>
 #include <protocols/secure_channel/CASEServer.h>
-#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <protocols/secure_channel/IndexedSessionResumptionStorage.h>
 
 using namespace chip::Inet;
 using namespace chip::System;
@@ -204,7 +204,7 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
     SessionResumptionStorage * sessionResumptionStorage;
     if (params.sessionResumptionStorage == nullptr)
     {
-        auto ownedSessionResumptionStorage = chip::Platform::MakeUnique<SimpleSessionResumptionStorage>();
+        auto ownedSessionResumptionStorage = chip::Platform::MakeUnique<IndexedSessionResumptionStorage>();
         ReturnErrorOnFailure(ownedSessionResumptionStorage->Init(params.fabricIndependentStorage));
         stateParams.ownedSessionResumptionStorage    = std::move(ownedSessionResumptionStorage);
         stateParams.externalSessionResumptionStorage = nullptr;
@@ -279,9 +279,12 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
     };
 
     CASESessionManagerConfig sessionManagerConfig = {
-        .sessionInitParams = sessionInitParams,
-        .clientPool        = stateParams.caseClientPool,
-        .sessionSetupPool  = stateParams.sessionSetupPool,
+        .sessionInitParams               = sessionInitParams,
+        .clientPool                      = stateParams.caseClientPool,
+        .sessionSetupPool                = stateParams.sessionSetupPool,
+        .maxConcurrentSessionSetups      = CHIP_CONFIG_CONTROLLER_MAX_CONCURRENT_CASE_SESSION_SETUPS,
+        .sessionSetupBackoffInitialDelay =
+            System::Clock::Milliseconds32(CHIP_CONFIG_CONTROLLER_CASE_SESSION_SETUP_BACKOFF_INITIAL_DELAY_MS),
     };
 
     // TODO: Need to be able to create a CASESessionManagerConfig here!
@@ -38,8 +38,8 @@
 #include <lib/core/CHIPConfig.h>
 #include <protocols/bdx/BdxTransferServer.h>
 #include <protocols/secure_channel/CASEServer.h>
+#include <protocols/secure_channel/IndexedSessionResumptionStorage.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
-#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
 #include <protocols/secure_channel/UnsolicitedStatusHandler.h>
 
 #include <transport/TransportMgr.h>
@@ -108,7 +108,7 @@ struct DeviceControllerSystemStateParams
     // NOTE: Exactly one of externalSessionResumptionStorage (externally provided,
     // externally owned) or ownedSessionResumptionStorage (managed by the system
     // state) must be non-null.
-    Platform::UniquePtr<SimpleSessionResumptionStorage> ownedSessionResumptionStorage;
+    Platform::UniquePtr<IndexedSessionResumptionStorage> ownedSessionResumptionStorage;
     Credentials::CertificateValidityPolicy * certificateValidityPolicy            = nullptr;
     SessionManager * sessionMgr                                                   = nullptr;
     Protocols::SecureChannel::UnsolicitedStatusHandler * unsolicitedStatusHandler = nullptr;
@@ -259,7 +259,7 @@ private:
     Crypto::SessionKeystore * mSessionKeystore                                     = nullptr;
     FabricTable::Delegate * mFabricTableDelegate                                   = nullptr;
     SessionResumptionStorage * mSessionResumptionStorage                           = nullptr;
-    Platform::UniquePtr<SimpleSessionResumptionStorage> mOwnedSessionResumptionStorage;
+    Platform::UniquePtr<IndexedSessionResumptionStorage> mOwnedSessionResumptionStorage;
 
     // If mTempFabricTable is not null, it was created during
     // DeviceControllerFactory::InitSystemState and needs to be
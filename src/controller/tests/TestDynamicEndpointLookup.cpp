@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for endpoint lookups in the attribute storage as dynamic endpoints are added and removed.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "app-common/zap-generated/ids/Attributes.h"
+#include "app-common/zap-generated/ids/Clusters.h"
+#include <app/tests/AppTestContext.h>
+#include <app/util/attribute-storage-detail.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <lib/support/CodeUtils.h>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+constexpr EndpointId kDynamicEndpointId      = 0x10;
+constexpr EndpointId kOtherDynamicEndpointId = 0xFFF0;
+
+static const int kDescriptorAttributeArraySize = 254;
+
+// Declare Descriptor cluster attributes
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(descriptorAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::DeviceTypeList::Id, ARRAY, kDescriptorAttributeArraySize, 0), /* device list */
+    DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::ServerList::Id, ARRAY, kDescriptorAttributeArraySize, 0), /* server list */
+    DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::ClientList::Id, ARRAY, kDescriptorAttributeArraySize, 0), /* client list */
+    DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::PartsList::Id, ARRAY, kDescriptorAttributeArraySize, 0),  /* parts list */
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Not sorted by attribute id.
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(testClusterAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(UnitTesting::Attributes::Int8u::Id, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(UnitTesting::Attributes::Boolean::Id, BOOLEAN, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(UnitTesting::Attributes::Bitmap8::Id, BITMAP8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(testEndpointClusters)
+DECLARE_DYNAMIC_CLUSTER(UnitTesting::Id, testClusterAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(testEndpoint, testEndpointClusters);
+
+class TestDynamicEndpointLookup : public ::testing::Test
+{
+public:
+    // Performs shared setup for all tests in the test suite
+    static void SetUpTestSuite()
+    {
+        if (mpContext == nullptr)
+        {
+            mpContext = new TestContext();
+            ASSERT_NE(mpContext, nullptr);
+        }
+        mpContext->SetUpTestSuite();
+    }
+
+    // Performs shared teardown for all tests in the test suite
+    static void TearDownTestSuite()
+    {
+        mpContext->TearDownTestSuite();
+        if (mpContext != nullptr)
+        {
+            delete mpContext;
+            mpContext = nullptr;
+        }
+    }
+
+protected:
+    // Performs setup for each test in the suite
+    void SetUp()
+    {
+        mpContext->SetUp();
+        emberAfEndpointConfigure();
+    }
+
+    // Performs teardown for each test in the suite
+    void TearDown()
+    {
+        emberAfClearDynamicEndpoint(0);
+        mpContext->TearDown();
+    }
+
+    static TestContext * mpContext;
+
+    // Helpers
+
+    static void ExpectFixedEndpointsFound();
+    static void ExpectDynamicEndpointFound(EndpointId endpoint);
+    static void ExpectEndpointNotFound(EndpointId endpoint);
+    static void ExpectAttributesFound(EndpointId endpoint, ClusterId cluster, const EmberAfAttributeMetadata * attributes,
+                                      size_t attributeCount);
+
+    DataVersion mDataVersionStorage[ArraySize(testEndpointClusters)];
+};
+TestContext * TestDynamicEndpointLookup::mpContext = nullptr;
+
+void TestDynamicEndpointLookup::ExpectFixedEndpointsFound()
+{
+    for (uint16_t index = 0; index < emberAfFixedEndpointCount(); index++)
+    {
+        EndpointId endpoint = emberAfEndpointFromIndex(index);
+        EXPECT_EQ(emberAfIndexFromEndpoint(endpoint), index);
+    }
+}
+
+void TestDynamicEndpointLookup::ExpectDynamicEndpointFound(EndpointId endpoint)
+{
+    EXPECT_EQ(emberAfIndexFromEndpoint(endpoint), emberAfFixedEndpointCount());
+    EXPECT_EQ(emberAfGetDynamicIndexFromEndpoint(endpoint), 0);
+    EXPECT_EQ(emberAfFindEndpointType(endpoint), &testEndpoint);
+    EXPECT_TRUE(emberAfContainsServer(endpoint, UnitTesting::Id));
+    EXPECT_TRUE(emberAfContainsServer(endpoint, Descriptor::Id));
+    EXPECT_EQ(emberAfClusterIndex(endpoint, UnitTesting::Id, CLUSTER_MASK_SERVER), 0);
+    EXPECT_EQ(emberAfClusterIndex(endpoint, Descriptor::Id, CLUSTER_MASK_SERVER), 1);
+}
+
+void TestDynamicEndpointLookup::ExpectEndpointNotFound(EndpointId endpoint)
+{
+    EXPECT_EQ(emberAfIndexFromEndpoint(endpoint), kEmberInvalidEndpointIndex);
+    EXPECT_EQ(emberAfGetDynamicIndexFromEndpoint(endpoint), kEmberInvalidEndpointIndex);
+    EXPECT_EQ(emberAfFindEndpointType(endpoint), nullptr);
+    EXPECT_FALSE(emberAfContainsServer(endpoint, UnitTesting::Id));
+    EXPECT_EQ(emberAfClusterIndex(endpoint, UnitTesting::Id, CLUSTER_MASK_SERVER), 0xFF);
+}
+
+void TestDynamicEndpointLookup::ExpectAttributesFound(EndpointId endpoint, ClusterId cluster,
+                                                      const EmberAfAttributeMetadata * attributes, size_t attributeCount)
+{
+    for (size_t i = 0; i < attributeCount; i++)
+    {
+        EXPECT_EQ(emberAfLocateAttributeMetadata(endpoint, cluster, attributes[i].attributeId), &attributes[i]);
+    }
+}
+
+TEST_F(TestDynamicEndpointLookup, TestAddAndRemove)
+{
+    ExpectFixedEndpointsFound();
+    ExpectEndpointNotFound(kDynamicEndpointId);
+
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kDynamicEndpointId, &testEndpoint, Span<DataVersion>(mDataVersionStorage)),
+              CHIP_NO_ERROR);
+    ExpectFixedEndpointsFound();
+    ExpectDynamicEndpointFound(kDynamicEndpointId);
+
+    // An endpoint id can only be used by one dynamic endpoint.
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kDynamicEndpointId, &testEndpoint, Span<DataVersion>(mDataVersionStorage)),
+              CHIP_ERROR_ENDPOINT_EXISTS);
+    ExpectDynamicEndpointFound(kDynamicEndpointId);
+
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kDynamicEndpointId);
+    ExpectFixedEndpointsFound();
+    ExpectEndpointNotFound(kDynamicEndpointId);
+}
+
+TEST_F(TestDynamicEndpointLookup, TestReuseIndex)
+{
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kDynamicEndpointId, &testEndpoint, Span<DataVersion>(mDataVersionStorage)),
+              CHIP_NO_ERROR);
+    ExpectDynamicEndpointFound(kDynamicEndpointId);
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kDynamicEndpointId);
+
+    // The endpoint is no longer found under the id it had before the index was reused.
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kOtherDynamicEndpointId, &testEndpoint, Span<DataVersion>(mDataVersionStorage)),
+              CHIP_NO_ERROR);
+    ExpectFixedEndpointsFound();
+    ExpectDynamicEndpointFound(kOtherDynamicEndpointId);
+    ExpectEndpointNotFound(kDynamicEndpointId);
+
+    // Set it again without clearing it first.
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kDynamicEndpointId, &testEndpoint, Span<DataVersion>(mDataVersionStorage)),
+              CHIP_NO_ERROR);
+    ExpectFixedEndpointsFound();
+    ExpectDynamicEndpointFound(kDynamicEndpointId);
+    ExpectEndpointNotFound(kOtherDynamicEndpointId);
+}
+
+TEST_F(TestDynamicEndpointLookup, TestLocateAttributeMetadata)
+{
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kDynamicEndpointId, Descriptor::Id, Descriptor::Attributes::PartsList::Id), nullptr);
+
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kDynamicEndpointId, &testEndpoint, Span<DataVersion>(mDataVersionStorage)),
+              CHIP_NO_ERROR);
+    ExpectAttributesFound(kDynamicEndpointId, Descriptor::Id, descriptorAttrs, ArraySize(descriptorAttrs));
+    ExpectAttributesFound(kDynamicEndpointId, UnitTesting::Id, testClusterAttrs, ArraySize(testClusterAttrs));
+
+    // Attributes of another cluster, and clusters the endpoint does not have, are not found.
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kDynamicEndpointId, UnitTesting::Id, Descriptor::Attributes::PartsList::Id), nullptr);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kDynamicEndpointId, Descriptor::Id, UnitTesting::Attributes::Int8u::Id), nullptr);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kDynamicEndpointId, OnOff::Id, OnOff::Attributes::OnOff::Id), nullptr);
+
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kDynamicEndpointId);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kDynamicEndpointId, Descriptor::Id, Descriptor::Attributes::PartsList::Id), nullptr);
+}
+
+} // namespace
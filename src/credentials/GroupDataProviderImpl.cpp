@@ -22,6 +22,8 @@
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/PersistentData.h>
 #include <lib/support/Pool.h>
+
+#include <algorithm>
 #include <stdlib.h>
 
 namespace chip {
@@ -832,6 +834,7 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    InvalidateGroupSessionCache();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
@@ -1349,6 +1352,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1419,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1452,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1529,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1601,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1703,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionCache();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1845,6 +1855,17 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+    if (provider.LoadGroupSessionCache())
+    {
+        // Start at the first entry for the session id.
+        auto * first = std::lower_bound(
+            provider.mGroupSessionCache, provider.mGroupSessionCache + provider.mGroupSessionCacheCount, session_id,
+            [](const GroupSessionCacheEntry & entry, uint16_t id) { return entry.session_id < id; });
+        mUseCache   = true;
+        mCacheIndex = static_cast<size_t>(first - provider.mGroupSessionCache);
+        return;
+    }
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1860,6 +1881,16 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
+    if (mUseCache)
+    {
+        for (size_t i = mCacheIndex; i < mProvider.mGroupSessionCacheCount; i++)
+        {
+            VerifyOrReturnValue(mProvider.mGroupSessionCache[i].session_id == mSessionId, count);
+            count++;
+        }
+        return count;
+    }
+
     for (size_t i = 0; i < mFabricTotal; i++, fabric.fabric_index = fabric.next)
     {
         if (CHIP_NO_ERROR != fabric.Load(mProvider.mStorage))
@@ -1898,7 +1929,24 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
-    while (mFabricCount < mFabricTotal)
+    while (mUseCache && mCacheIndex < mProvider.mGroupSessionCacheCount)
+    {
+        GroupSessionCacheEntry & entry = mProvider.mGroupSessionCache[mCacheIndex++];
+        VerifyOrReturnValue(entry.session_id == mSessionId, false);
+
+        GroupKeyContext * keyContext = mProvider.GetCachedKeyContext(entry);
+        if (keyContext == nullptr)
+        {
+            continue;
+        }
+        output.fabric_index    = entry.fabric_index;
+        output.group_id        = entry.group_id;
+        output.security_policy = entry.security_policy;
+        output.keyContext      = keyContext;
+        return true;
+    }
+
+    while (!mUseCache && mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
         VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mProvider.mStorage), false);
@@ -1956,6 +2004,127 @@ void GroupDataProviderImpl::GroupSessionIteratorImpl::Release()
     mProvider.mGroupSessionsIterator.ReleaseObject(this);
 }
 
+bool GroupDataProviderImpl::LoadGroupSessionCache()
+{
+    VerifyOrReturnValue(!mGroupSessionCacheValid, true);
+    VerifyOrReturnValue(!mGroupSessionCacheOverflow, false);
+
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        // No fabric, hence no group session
+        mGroupSessionCacheValid = true;
+        return true;
+    }
+    VerifyOrReturnValue(CHIP_NO_ERROR == err, false);
+
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        VerifyOrReturnValue(CHIP_NO_ERROR == fabric.Load(mStorage), false);
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            VerifyOrReturnValue(CHIP_NO_ERROR == mapping.Load(mStorage), false);
+
+            KeySetData keyset;
+            if (!keyset.Find(mStorage, fabric, mapping.keyset_id))
+            {
+                // Mapped to a keyset that no longer exists, no keys to index
+                continue;
+            }
+
+            for (uint8_t k = 0; k < keyset.keys_count; ++k)
+            {
+                if (mGroupSessionCacheCount >= kGroupSessionCacheSize)
+                {
+                    // Too many mappings to index, fall back to looking up storage until the next change
+                    mGroupSessionCacheCount    = 0;
+                    mGroupSessionCacheOverflow = true;
+                    return false;
+                }
+
+                // Keep the entries sorted by session id, and in storage order for a given session id
+                const uint16_t session_id = keyset.operational_keys[k].hash;
+                size_t index              = mGroupSessionCacheCount;
+                for (; index > 0 && mGroupSessionCache[index - 1].session_id > session_id; index--)
+                {
+                    mGroupSessionCache[index] = mGroupSessionCache[index - 1];
+                }
+                GroupSessionCacheEntry & entry = mGroupSessionCache[index];
+                entry.session_id               = session_id;
+                entry.fabric_index             = fabric.fabric_index;
+                entry.group_id                 = mapping.group_id;
+                entry.keyset_id                = mapping.keyset_id;
+                entry.key_index                = k;
+                entry.security_policy          = keyset.policy;
+                entry.key_context              = nullptr;
+                mGroupSessionCacheCount++;
+            }
+        }
+    }
+
+    mGroupSessionCacheValid = true;
+    return true;
+}
+
+void GroupDataProviderImpl::InvalidateGroupSessionCache()
+{
+    ReleaseCachedKeyContexts();
+    mGroupSessionCacheCount    = 0;
+    mGroupSessionCacheValid    = false;
+    mGroupSessionCacheOverflow = false;
+}
+
+GroupDataProviderImpl::GroupKeyContext * GroupDataProviderImpl::GetCachedKeyContext(GroupSessionCacheEntry & entry)
+{
+    VerifyOrReturnValue(nullptr == entry.key_context, entry.key_context);
+
+    FabricData fabric(entry.fabric_index);
+    VerifyOrReturnValue(CHIP_NO_ERROR == fabric.Load(mStorage), nullptr);
+
+    KeySetData keyset;
+    VerifyOrReturnValue(keyset.Find(mStorage, fabric, entry.keyset_id), nullptr);
+    VerifyOrReturnValue(entry.key_index < keyset.keys_count, nullptr);
+
+    Crypto::GroupOperationalCredentials & creds = keyset.operational_keys[entry.key_index];
+    GroupKeyContext * context = mCachedKeyContexts.CreateObject(*this, creds.encryption_key, creds.hash, creds.privacy_key);
+    if (nullptr == context)
+    {
+        // All the key slots are taken, start over with the keys in use now
+        ReleaseCachedKeyContexts();
+        context = mCachedKeyContexts.CreateObject(*this, creds.encryption_key, creds.hash, creds.privacy_key);
+        VerifyOrReturnValue(nullptr != context, nullptr);
+    }
+
+    // Share the imported key with the other groups mapped to the same keyset
+    for (size_t i = 0; i < mGroupSessionCacheCount; i++)
+    {
+        GroupSessionCacheEntry & other = mGroupSessionCache[i];
+        if (other.fabric_index == entry.fabric_index && other.keyset_id == entry.keyset_id && other.key_index == entry.key_index)
+        {
+            other.key_context = context;
+        }
+    }
+
+    return context;
+}
+
+void GroupDataProviderImpl::ReleaseCachedKeyContexts()
+{
+    for (size_t i = 0; i < mGroupSessionCacheCount; i++)
+    {
+        mGroupSessionCache[i].key_context = nullptr;
+    }
+    mCachedKeyContexts.ForEachActiveObject([](GroupKeyContext * context) {
+        context->ReleaseKeys();
+        return Loop::Continue;
+    });
+    mCachedKeyContexts.ReleaseAll();
+}
+
 namespace {
 
 GroupDataProvider * gGroupsProvider = nullptr;
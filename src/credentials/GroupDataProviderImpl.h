@@ -27,7 +27,11 @@ namespace Credentials {
 class GroupDataProviderImpl : public GroupDataProvider
 {
 public:
-    static constexpr size_t kIteratorsMax = CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS;
+    static constexpr size_t kIteratorsMax          = CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS;
+    static constexpr size_t kGroupSessionCacheSize = CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE;
+    static constexpr size_t kGroupSessionCacheKeys = CHIP_CONFIG_GROUP_SESSION_CACHE_KEYS;
+
+    static_assert(kGroupSessionCacheSize > 0 && kGroupSessionCacheKeys > 0, "The group session cache cannot be empty");
 
     GroupDataProviderImpl() = default;
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
@@ -242,10 +246,33 @@ protected:
         uint16_t mKeyCount       = 0;
         bool mFirstMap           = true;
         GroupKeyContext mGroupKeyContext;
+        // Set when iterating over mProvider.mGroupSessionCache rather than storage.
+        bool mUseCache     = false;
+        size_t mCacheIndex = 0;
+    };
+
+    // One operational group key mapped to one group, as found in the stored
+    // keysets and group/keyset map.
+    struct GroupSessionCacheEntry
+    {
+        uint16_t session_id;
+        FabricIndex fabric_index;
+        GroupId group_id;
+        KeysetId keyset_id;
+        uint8_t key_index;
+        SecurityPolicy security_policy;
+        // Imported lazily, and shared by all the entries for the same key.
+        GroupKeyContext * key_context;
     };
+
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+    bool LoadGroupSessionCache();
+    void InvalidateGroupSessionCache();
+    GroupKeyContext * GetCachedKeyContext(GroupSessionCacheEntry & entry);
+    void ReleaseCachedKeyContexts();
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -254,6 +281,16 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+
+    // Index of the group sessions sorted by session id, so that looking up the keys
+    // of an incoming group message does not read persistent storage nor re-import the
+    // keys every time.  Invalidated by any change to the keysets or the group/keyset
+    // map, and rebuilt on the next lookup.
+    GroupSessionCacheEntry mGroupSessionCache[kGroupSessionCacheSize];
+    size_t mGroupSessionCacheCount  = 0;
+    bool mGroupSessionCacheValid    = false;
+    bool mGroupSessionCacheOverflow = false;
+    ObjectPool<GroupKeyContext, kGroupSessionCacheKeys> mCachedKeyContexts;
 };
 
 } // namespace Credentials
@@ -50,9 +50,40 @@ FileAttestationTrustStore::FileAttestationTrustStore(const char * paaTrustStoreP
         VerifyOrReturn(paaCount());
     }
 
+    BuildSkidIndex();
     mIsInitialized = true;
 }
 
+size_t FileAttestationTrustStore::SkidHash::operator()(const Skid & skid) const
+{
+    // Key identifiers are SHA-1 based, so any of their bytes are already well distributed.
+    static_assert(sizeof(size_t) <= sizeof(Skid), "SKID must be large enough to provide a hash");
+    size_t hash;
+    memcpy(&hash, skid.data(), sizeof(hash));
+    return hash;
+}
+
+void FileAttestationTrustStore::BuildSkidIndex()
+{
+    mPAASkidIndex.clear();
+    mPAASkidIndex.reserve(mPAADerCerts.size());
+
+    for (size_t i = 0; i < mPAADerCerts.size(); i++)
+    {
+        const std::vector<uint8_t> & paa = mPAADerCerts[i];
+        Skid skid;
+        MutableByteSpan skidSpan{ skid };
+        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{ paa.data(), paa.size() }, skidSpan) ||
+            skidSpan.size() != skid.size())
+        {
+            continue;
+        }
+
+        // Like a linear search would, keep the first certificate found for a given SKID.
+        mPAASkidIndex.emplace(skid, i);
+    }
+}
+
 std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePath, CertificateValidationMode validationMode)
 {
     std::vector<std::vector<uint8_t>> certs;
@@ -73,7 +104,8 @@ std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePat
             const char * fileExtension = GetFilenameExtension(entry->d_name);
             if (strncmp(fileExtension, "der", strlen("der")) == 0)
             {
-                std::vector<uint8_t> certificate(kMaxDERCertLength + 1);
+                // Read into a scratch buffer so that accepted certificates get an allocation of their exact size.
+                uint8_t certificate[kMaxDERCertLength + 1];
                 std::string filename(trustStorePath);
 
                 filename += std::string("/") + std::string(entry->d_name);
@@ -85,11 +117,10 @@ std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePat
                     continue;
                 }
 
-                size_t certificateLength = fread(certificate.data(), sizeof(uint8_t), certificate.size(), file);
+                size_t certificateLength = fread(certificate, sizeof(uint8_t), sizeof(certificate), file);
                 if ((certificateLength > 0) && (certificateLength <= kMaxDERCertLength))
                 {
-                    certificate.resize(certificateLength);
-                    ByteSpan certSpan{ certificate.data(), certificate.size() };
+                    ByteSpan certSpan{ certificate, certificateLength };
 
                     // Only accumulate certificate if it passes validation.
                     bool isValid = false;
@@ -121,7 +152,7 @@ std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePat
 
                     if (isValid)
                     {
-                        certs.push_back(certificate);
+                        certs.emplace_back(certSpan.begin(), certSpan.end());
                     }
                 }
                 fclose(file);
@@ -141,6 +172,7 @@ FileAttestationTrustStore::~FileAttestationTrustStore()
 void FileAttestationTrustStore::Cleanup()
 {
     mPAADerCerts.clear();
+    mPAASkidIndex.clear();
     mIsInitialized = false;
 }
 
@@ -158,23 +190,14 @@ CHIP_ERROR FileAttestationTrustStore::GetProductAttestationAuthorityCert(const B
     VerifyOrReturnError(!skid.empty() && (skid.data() != nullptr), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
 
-    for (auto candidate : mPAADerCerts)
-    {
-        uint8_t skidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
-        MutableByteSpan candidateSkidSpan{ skidBuf };
-        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{ candidate.data(), candidate.size() }, candidateSkidSpan))
-        {
-            continue;
-        }
+    Skid key;
+    memcpy(key.data(), skid.data(), key.size());
 
-        if (skid.data_equal(candidateSkidSpan))
-        {
-            // Found a match
-            return CopySpanToMutableSpan(ByteSpan{ candidate.data(), candidate.size() }, outPaaDerBuffer);
-        }
-    }
+    auto found = mPAASkidIndex.find(key);
+    VerifyOrReturnError(found != mPAASkidIndex.end(), CHIP_ERROR_CA_CERT_NOT_FOUND);
 
-    return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    const std::vector<uint8_t> & paa = mPAADerCerts[found->second];
+    return CopySpanToMutableSpan(ByteSpan{ paa.data(), paa.size() }, outPaaDerBuffer);
 }
 
 } // namespace Credentials
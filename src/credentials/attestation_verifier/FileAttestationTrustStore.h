@@ -20,6 +20,7 @@
 #include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
 
 #include <array>
+#include <unordered_map>
 #include <vector>
 
 namespace chip {
@@ -63,9 +64,22 @@ public:
 protected:
     std::vector<std::vector<uint8_t>> mPAADerCerts;
 
+    // Rebuilds the SKID index; to be called after changing mPAADerCerts.
+    void BuildSkidIndex();
+
 private:
+    using Skid = std::array<uint8_t, Crypto::kSubjectKeyIdentifierLength>;
+
+    struct SkidHash
+    {
+        size_t operator()(const Skid & skid) const;
+    };
+
     bool mIsInitialized = false;
 
+    // Position in mPAADerCerts of the PAA for each subject key identifier, built at load time.
+    std::unordered_map<Skid, size_t, SkidHash> mPAASkidIndex;
+
     void Cleanup();
 };
 
@@ -0,0 +1,161 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <credentials/attestation_verifier/FileAttestationTrustStore.h>
+#include <credentials/attestation_verifier/TestPAAStore.h>
+#include <crypto/CHIPCryptoPAL.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+#include "CHIPAttCert_test_vectors.h"
+
+using namespace chip;
+using namespace chip::Crypto;
+using namespace chip::Credentials;
+
+namespace {
+
+// Allows adding PAAs in a known order, which loading them from a directory does not give.
+class OrderedAttestationTrustStore : public FileAttestationTrustStore
+{
+public:
+    using FileAttestationTrustStore::FileAttestationTrustStore;
+
+    void AddPAA(const ByteSpan & paaDer)
+    {
+        mPAADerCerts.emplace_back(paaDer.begin(), paaDer.end());
+        BuildSkidIndex();
+    }
+};
+
+// Returns the path of the development PAA directory, or an empty string if it is not found.
+std::string FindPAADirectory()
+{
+    std::string dirPath("../../../../../credentials/development/paa-root-certs");
+    DIR * dir = opendir(dirPath.c_str());
+    while (dir == nullptr && (dirPath.find("../") == 0))
+    {
+        dirPath = dirPath.substr(3);
+        dir     = opendir(dirPath.c_str());
+    }
+    if (dir == nullptr)
+    {
+        return std::string();
+    }
+    closedir(dir);
+    return dirPath;
+}
+
+} // namespace
+
+struct TestFileAttestationTrustStore : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestFileAttestationTrustStore, TestLookupBySkid)
+{
+    std::string paaDirPath = FindPAADirectory();
+    if (paaDirPath.empty())
+    {
+        ChipLogError(Crypto, "Couldn't open folder with development PAA certificates.");
+        return;
+    }
+
+    FileAttestationTrustStore trustStore(paaDirPath.c_str());
+    ASSERT_TRUE(trustStore.IsInitialized());
+
+    std::vector<std::vector<uint8_t>> paaCerts = LoadAllX509DerCerts(paaDirPath.c_str());
+    ASSERT_FALSE(paaCerts.empty());
+    EXPECT_EQ(trustStore.paaCount(), paaCerts.size());
+
+    for (const std::vector<uint8_t> & paa : paaCerts)
+    {
+        ByteSpan paaSpan{ paa.data(), paa.size() };
+        uint8_t skidBuf[kSubjectKeyIdentifierLength];
+        MutableByteSpan skidSpan{ skidBuf };
+        ASSERT_EQ(ExtractSKIDFromX509Cert(paaSpan, skidSpan), CHIP_NO_ERROR);
+
+        uint8_t outBuf[kMaxDERCertLength];
+        MutableByteSpan outSpan{ outBuf };
+        EXPECT_EQ(trustStore.GetProductAttestationAuthorityCert(skidSpan, outSpan), CHIP_NO_ERROR);
+        EXPECT_TRUE(outSpan.data_equal(paaSpan));
+    }
+
+    // Key identifiers of no certificate, or of a PAA which is not in the directory, are not found.
+    const uint8_t kUnknownSkid[kSubjectKeyIdentifierLength] = { 0 };
+    uint8_t outBuf[kMaxDERCertLength];
+    MutableByteSpan outSpan{ outBuf };
+    EXPECT_EQ(trustStore.GetProductAttestationAuthorityCert(ByteSpan(kUnknownSkid), outSpan), CHIP_ERROR_CA_CERT_NOT_FOUND);
+
+    outSpan = MutableByteSpan{ outBuf };
+    EXPECT_EQ(trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAA_FFF2_ValInPast_SKID, outSpan),
+              CHIP_ERROR_CA_CERT_NOT_FOUND);
+}
+
+TEST_F(TestFileAttestationTrustStore, TestDuplicateSkidResolvesToFirstLoaded)
+{
+    // The two PAAs share a key, so they have the same subject key identifier.
+    ASSERT_FALSE(TestCerts::sTestCert_PAA_NoVID_Cert.data_equal(TestCerts::sTestCert_PAA_NoVID_ToResignPAIs_Cert));
+    ASSERT_TRUE(TestCerts::sTestCert_PAA_NoVID_SKID.data_equal(TestCerts::sTestCert_PAA_NoVID_ToResignPAIs_SKID));
+
+    // The development PAA directory has the first one.
+    std::string paaDirPath = FindPAADirectory();
+    if (!paaDirPath.empty())
+    {
+        OrderedAttestationTrustStore trustStore(paaDirPath.c_str());
+        ASSERT_TRUE(trustStore.IsInitialized());
+        trustStore.AddPAA(TestCerts::sTestCert_PAA_NoVID_ToResignPAIs_Cert);
+
+        uint8_t outBuf[kMaxDERCertLength];
+        MutableByteSpan outSpan{ outBuf };
+        EXPECT_EQ(trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAA_NoVID_SKID, outSpan), CHIP_NO_ERROR);
+        EXPECT_TRUE(outSpan.data_equal(TestCerts::sTestCert_PAA_NoVID_Cert));
+    }
+
+    {
+        OrderedAttestationTrustStore trustStore;
+        trustStore.AddPAA(TestCerts::sTestCert_PAA_NoVID_Cert);
+        trustStore.AddPAA(TestCerts::sTestCert_PAA_NoVID_ToResignPAIs_Cert);
+
+        uint8_t outBuf[kMaxDERCertLength];
+        MutableByteSpan outSpan{ outBuf };
+        EXPECT_EQ(trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAA_NoVID_SKID, outSpan), CHIP_NO_ERROR);
+        EXPECT_TRUE(outSpan.data_equal(TestCerts::sTestCert_PAA_NoVID_Cert));
+    }
+
+    {
+        OrderedAttestationTrustStore trustStore;
+        trustStore.AddPAA(TestCerts::sTestCert_PAA_NoVID_ToResignPAIs_Cert);
+        trustStore.AddPAA(TestCerts::sTestCert_PAA_NoVID_Cert);
+
+        uint8_t outBuf[kMaxDERCertLength];
+        MutableByteSpan outSpan{ outBuf };
+        EXPECT_EQ(trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAA_NoVID_SKID, outSpan), CHIP_NO_ERROR);
+        EXPECT_TRUE(outSpan.data_equal(TestCerts::sTestCert_PAA_NoVID_ToResignPAIs_Cert));
+    }
+}
@@ -1219,6 +1219,59 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+TEST_F(TestGroupDataProvider, TestGroupSessionsAfterUpdates)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    EXPECT_TRUE(provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset1), CHIP_NO_ERROR);
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric1, kGroup1);
+    ASSERT_NE(nullptr, key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    auto sessions = [&]() {
+        std::set<std::pair<FabricIndex, GroupId>> found;
+        GroupSession session;
+        auto it = provider->IterateGroupSessions(session_id);
+        if (it)
+        {
+            EXPECT_EQ(it->Count(), 1u);
+            while (it->Next(session))
+            {
+                EXPECT_NE(session.keyContext, nullptr);
+                found.insert({ session.fabric_index, session.group_id });
+            }
+            it->Release();
+        }
+        return found;
+    };
+
+    // Repeated lookups return the same session
+    const std::set<std::pair<FabricIndex, GroupId>> expected1 = { { kFabric1, kGroup1 } };
+    EXPECT_EQ(sessions(), expected1);
+    EXPECT_EQ(sessions(), expected1);
+
+    // Lookups reflect changes to the group/keyset map...
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    const std::set<std::pair<FabricIndex, GroupId>> expected2 = { { kFabric1, kGroup2 } };
+    EXPECT_EQ(sessions(), expected2);
+
+    // ...and to the keysets
+    EXPECT_EQ(provider->RemoveKeySet(kFabric1, kKeysetId1), CHIP_NO_ERROR);
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(session_id);
+    ASSERT_TRUE(it);
+    EXPECT_EQ(it->Count(), 0u);
+    EXPECT_FALSE(it->Next(session));
+    it->Release();
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
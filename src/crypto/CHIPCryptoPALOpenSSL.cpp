@@ -20,8 +20,9 @@
  *      openSSL based implementation of CHIP crypto primitives
  */
 
-#include "CHIPCryptoPAL.h"
+#include "CHIPCryptoPALOpenSSL.h"
 
+#include <mutex>
 #include <type_traits>
 
 #if CHIP_CRYPTO_BORINGSSL
@@ -146,6 +147,234 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
+#define AES_CCM_CONTEXT_CACHE_ENABLED (!CHIP_CRYPTO_BORINGSSL && CHIP_CONFIG_AES_CCM_CONTEXT_CACHE_SIZE > 0)
+
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+namespace {
+
+/**
+ * Cache of AES-CCM cipher contexts that have already been keyed, for the keys set by the session keystore.
+ *
+ * Entries are found by the address of the key handle: the session keystore registers a handle whenever it
+ * sets its key (AddKey) and removes it when the key is destroyed (RemoveKey), which frees the contexts.
+ * Handles are not always destroyed, and a later handle at the same address may be filled without the
+ * keystore, so each entry also keeps the key its contexts were set up with and drops them when the handle
+ * holds another key.  When every entry is taken, the least recently used one is given to the new handle.
+ *
+ * OpenSSL fixes the nonce and tag lengths of a CCM context when it is keyed, so those are kept with each
+ * context.  A context is keyed for one direction, so each entry has one context per direction.  A context
+ * is taken out of the cache while it is used, so that it can be shared by threads.
+ */
+class AesCcmContextCache
+{
+public:
+    enum Direction : uint8_t
+    {
+        kEncrypt,
+        kDecrypt,
+        kDirectionCount,
+    };
+
+    ~AesCcmContextCache()
+    {
+        for (Entry & entry : mEntries)
+        {
+            Clear(entry);
+        }
+    }
+
+    void AddKey(const Symmetric128BitsKeyHandle & key)
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        // The handle may be reused for a new key without having been destroyed.
+        Entry * entry = Find(&key);
+        if (entry == nullptr)
+        {
+            // Free entries are never used, so they come first.
+            entry = FindLeastRecentlyUsed();
+            VerifyOrReturn(entry != nullptr);
+        }
+        Clear(*entry);
+        entry->mKey     = &key;
+        entry->mLastUse = ++mUseCounter;
+    }
+
+    void RemoveKey(const Symmetric128BitsKeyHandle & key)
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        Entry * entry = Find(&key);
+        if (entry != nullptr)
+        {
+            Clear(*entry);
+        }
+    }
+
+    /**
+     * Returns a context for the given key and lengths, or nullptr on allocation failure.  The context must
+     * be handed back to Release() once the operation is over.
+     *
+     * @param[out] keyed  Set to true if the context is already keyed and only needs the nonce,
+     *                    false if it is a fresh context that must be fully initialized.
+     */
+    EVP_CIPHER_CTX * Acquire(const Aes128KeyHandle & key, Direction direction, size_t nonceLength, size_t tagLength, bool & keyed)
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        keyed = false;
+
+        Entry * entry = Find(&key);
+        if (entry == nullptr || entry->mInUse[direction])
+        {
+            // Not a key of the session keystore, or used by another thread right now.
+            return EVP_CIPHER_CTX_new();
+        }
+
+        // The handle may have been filled with another key since its contexts were set up.
+        const Symmetric128BitsKeyByteArray & keyBytes = key.As<Symmetric128BitsKeyByteArray>();
+        if (CRYPTO_memcmp(entry->mKeyBytes, keyBytes, sizeof(keyBytes)) != 0)
+        {
+            ClearContexts(*entry);
+            memcpy(entry->mKeyBytes, keyBytes, sizeof(keyBytes));
+        }
+        entry->mLastUse = ++mUseCounter;
+
+        EVP_CIPHER_CTX *& context = entry->mContexts[direction];
+        if (context != nullptr && entry->mNonceLength[direction] == nonceLength && entry->mTagLength[direction] == tagLength)
+        {
+            keyed = true;
+        }
+        else if (context != nullptr)
+        {
+            EVP_CIPHER_CTX_reset(context);
+        }
+        else
+        {
+            context = EVP_CIPHER_CTX_new();
+            VerifyOrReturnValue(context != nullptr, nullptr);
+        }
+
+        entry->mNonceLength[direction] = nonceLength;
+        entry->mTagLength[direction]   = tagLength;
+        entry->mInUse[direction]       = true;
+        return context;
+    }
+
+    /**
+     * Hands back a context returned by Acquire().  Unless reusable is true, as the state of a context is
+     * unknown after a failed operation, the context is freed.
+     */
+    void Release(EVP_CIPHER_CTX * context, bool reusable)
+    {
+        VerifyOrReturn(context != nullptr);
+
+        std::lock_guard<std::mutex> lock(mLock);
+
+        for (Entry & entry : mEntries)
+        {
+            for (uint8_t direction = 0; direction < kDirectionCount; direction++)
+            {
+                if (entry.mContexts[direction] == context && entry.mInUse[direction])
+                {
+                    entry.mInUse[direction] = false;
+                    if (!reusable)
+                    {
+                        EVP_CIPHER_CTX_free(context);
+                        entry.mContexts[direction] = nullptr;
+                    }
+                    return;
+                }
+            }
+        }
+
+        // Not cached, or the key was destroyed while the context was in use.
+        EVP_CIPHER_CTX_free(context);
+    }
+
+private:
+    struct Entry
+    {
+        const Symmetric128BitsKeyHandle * mKey      = nullptr;
+        Symmetric128BitsKeyByteArray mKeyBytes      = {}; // Key the contexts were set up with
+        uint32_t mLastUse                           = 0;
+        EVP_CIPHER_CTX * mContexts[kDirectionCount] = {};
+        size_t mNonceLength[kDirectionCount]        = {};
+        size_t mTagLength[kDirectionCount]          = {};
+        bool mInUse[kDirectionCount]                = {};
+    };
+
+    Entry * Find(const Symmetric128BitsKeyHandle * key)
+    {
+        for (Entry & entry : mEntries)
+        {
+            if (entry.mKey == key)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    Entry * FindLeastRecentlyUsed()
+    {
+        Entry * oldest = nullptr;
+        for (Entry & entry : mEntries)
+        {
+            if (oldest == nullptr || entry.mLastUse < oldest->mLastUse)
+            {
+                oldest = &entry;
+            }
+        }
+        return oldest;
+    }
+
+    static void ClearContexts(Entry & entry)
+    {
+        for (uint8_t direction = 0; direction < kDirectionCount; direction++)
+        {
+            // A context in use is freed by Release(), which no longer finds it.
+            if (entry.mContexts[direction] != nullptr && !entry.mInUse[direction])
+            {
+                EVP_CIPHER_CTX_free(entry.mContexts[direction]);
+            }
+            entry.mContexts[direction] = nullptr;
+            entry.mInUse[direction]    = false;
+        }
+        ClearSecretData(entry.mKeyBytes);
+    }
+
+    static void Clear(Entry & entry)
+    {
+        ClearContexts(entry);
+        entry.mKey     = nullptr;
+        entry.mLastUse = 0;
+    }
+
+    std::mutex mLock;
+    uint32_t mUseCounter = 0;
+    Entry mEntries[CHIP_CONFIG_AES_CCM_CONTEXT_CACHE_SIZE];
+};
+
+AesCcmContextCache sAesCcmContexts;
+
+} // namespace
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
+
+void AesCcmContextCacheAddKey(const Aes128KeyHandle & key)
+{
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+    sAesCcmContexts.AddKey(key);
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
+}
+
+void AesCcmContextCacheRemoveKey(const Symmetric128BitsKeyHandle & key)
+{
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+    sAesCcmContexts.RemoveKey(key);
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
+}
+
 CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
                            const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
                            uint8_t * tag, size_t tag_length)
@@ -159,6 +388,7 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
     int bytesWritten         = 0;
     size_t ciphertext_length = 0;
     const EVP_CIPHER * type  = nullptr;
+    bool keyed               = false;
 #endif
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -215,24 +445,32 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 
     type = EVP_aes_128_ccm();
 
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+    context = sAesCcmContexts.Acquire(key, AesCcmContextCache::kEncrypt, nonce_length, tag_length, keyed);
+#else
     context = EVP_CIPHER_CTX_new();
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
     VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    if (!keyed)
+    {
+        // Pass in cipher
+        result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
 
-    // Pass in key + nonce
+    // Pass in key + nonce.  A context that is already keyed only takes the new nonce.
     static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    result = EVP_EncryptInit_ex(context, nullptr, nullptr, keyed ? nullptr : key.As<Symmetric128BitsKeyByteArray>(),
+                                Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in plain text length
@@ -268,6 +506,10 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+    // Cached contexts stay keyed for the next message unless the operation failed part way.
+    sAesCcmContexts.Release(context, error == CHIP_NO_ERROR);
+#else
     if (context != nullptr)
     {
 #if CHIP_CRYPTO_BORINGSSL
@@ -277,6 +519,7 @@ exit:
 #endif // CHIP_CRYPTO_BORINGSSL
         context = nullptr;
     }
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
 
     return error;
 }
@@ -293,6 +536,7 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
     EVP_CIPHER_CTX * context = nullptr;
     int bytesOutput          = 0;
     const EVP_CIPHER * type  = nullptr;
+    bool keyed               = false;
 #endif // CHIP_CRYPTO_BORINGSSL
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -345,17 +589,24 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #else
     type = EVP_aes_128_ccm();
 
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+    context = sAesCcmContexts.Acquire(key, AesCcmContextCache::kDecrypt, nonce_length, tag_length, keyed);
+#else
     context = EVP_CIPHER_CTX_new();
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
     VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    if (!keyed)
+    {
+        // Pass in cipher
+        result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in nonce length
-    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in nonce length
+        VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
 
     // Pass in expected tag
     // Removing "const" from |tag| here should hopefully be safe as
@@ -365,9 +616,10 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                                               const_cast<void *>(static_cast<const void *>(tag)));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
+    // Pass in key + nonce.  A context that is already keyed only takes the new nonce.
     static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    result = EVP_DecryptInit_ex(context, nullptr, nullptr, keyed ? nullptr : key.As<Symmetric128BitsKeyByteArray>(),
+                                Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in cipher text length
@@ -397,6 +649,10 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
+#if AES_CCM_CONTEXT_CACHE_ENABLED
+    // Cached contexts stay keyed for the next message unless the operation failed part way.
+    sAesCcmContexts.Release(context, error == CHIP_NO_ERROR);
+#else
     if (context != nullptr)
     {
 #if CHIP_CRYPTO_BORINGSSL
@@ -407,6 +663,7 @@ exit:
 
         context = nullptr;
     }
+#endif // AES_CCM_CONTEXT_CACHE_ENABLED
 
     return error;
 }
@@ -0,0 +1,50 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Header file that contains private definitions used by OpenSSL crypto backend.
+ *
+ * This file should not be included directly by the application. Instead, use
+ * cryptographic primitives defined in CHIPCryptoPAL.h or SessionKeystore.h.
+ */
+
+#pragma once
+
+#include "CHIPCryptoPAL.h"
+
+namespace chip {
+namespace Crypto {
+
+/**
+ * @brief Allow AES_CCM_encrypt() and AES_CCM_decrypt() to keep keyed cipher contexts for a key handle.
+ *
+ * The contexts are found by the address of the handle, so the session keystore calls this whenever it
+ * sets the key in a handle, and must call AesCcmContextCacheRemoveKey() when it destroys the key.
+ * Handles whose key is set by other means are never cached.  A registered handle may still be filled
+ * by other means later: the contexts are set up again whenever the key in the handle has changed.
+ */
+void AesCcmContextCacheAddKey(const Aes128KeyHandle & key);
+
+/**
+ * @brief Free the cipher contexts kept for a key handle, if any.
+ */
+void AesCcmContextCacheRemoveKey(const Symmetric128BitsKeyHandle & key);
+
+} // namespace Crypto
+} // namespace chip
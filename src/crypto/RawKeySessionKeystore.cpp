@@ -17,6 +17,9 @@
 
 #include <crypto/RawKeySessionKeystore.h>
 
+#if CHIP_CRYPTO_OPENSSL
+#include <crypto/CHIPCryptoPALOpenSSL.h>
+#endif // CHIP_CRYPTO_OPENSSL
 #include <lib/support/BufferReader.h>
 
 #include <cstdint>
@@ -36,8 +39,29 @@ struct RawHkdfKeyHandle
     uint8_t size;
 };
 
+namespace {
+
+// The OpenSSL crypto PAL caches keyed AES-CCM contexts by key handle, so it is told whenever the
+// key in a handle is set or destroyed.
+void OnAesKeySet(const Aes128KeyHandle & key)
+{
+#if CHIP_CRYPTO_OPENSSL
+    AesCcmContextCacheAddKey(key);
+#endif // CHIP_CRYPTO_OPENSSL
+}
+
+void OnKeyDestroyed(const Symmetric128BitsKeyHandle & key)
+{
+#if CHIP_CRYPTO_OPENSSL
+    AesCcmContextCacheRemoveKey(key);
+#endif // CHIP_CRYPTO_OPENSSL
+}
+
+} // namespace
+
 CHIP_ERROR RawKeySessionKeystore::CreateKey(const Symmetric128BitsKeyByteArray & keyMaterial, Aes128KeyHandle & key)
 {
+    OnAesKeySet(key);
     memcpy(key.AsMutable<Symmetric128BitsKeyByteArray>(), keyMaterial, sizeof(Symmetric128BitsKeyByteArray));
     return CHIP_NO_ERROR;
 }
@@ -64,6 +88,7 @@ CHIP_ERROR RawKeySessionKeystore::DeriveKey(const P256ECDHDerivedSecret & secret
 {
     HKDF_sha hkdf;
 
+    OnAesKeySet(key);
     return hkdf.HKDF_SHA256(secret.ConstBytes(), secret.Length(), salt.data(), salt.size(), info.data(), info.size(),
                             key.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray));
 }
@@ -75,6 +100,8 @@ CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const ByteSpan & secret, con
     HKDF_sha hkdf;
     uint8_t keyMaterial[2 * sizeof(Symmetric128BitsKeyByteArray) + AttestationChallenge::Capacity()];
 
+    OnAesKeySet(i2rKey);
+    OnAesKeySet(r2iKey);
     ReturnErrorOnFailure(hkdf.HKDF_SHA256(secret.data(), secret.size(), salt.data(), salt.size(), info.data(), info.size(),
                                           keyMaterial, sizeof(keyMaterial)));
 
@@ -95,6 +122,7 @@ CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const HkdfKeyHandle & hkdfKe
 
 void RawKeySessionKeystore::DestroyKey(Symmetric128BitsKeyHandle & key)
 {
+    OnKeyDestroyed(key);
     ClearSecretData(key.AsMutable<Symmetric128BitsKeyByteArray>());
 }
 
@@ -390,6 +390,187 @@ TEST_F(TestChipCryptoPAL, TestAES_CCM_128DecryptTestVectors)
     EXPECT_GT(numOfTestsRan, 0);
 }
 
+// Processing several messages with the same keys, interleaved with other keys and
+// failed operations, must give the same results as processing each one on its own.
+TEST_F(TestChipCryptoPAL, TestAES_CCM_128RepeatedKeys)
+{
+    HeapChecker heapChecker;
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int pass = 0; pass < 3; pass++)
+    {
+        for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+        {
+            const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+            if (vector->pt_len == 0 || vector->result != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+            numOfTestsRan++;
+
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            ASSERT_TRUE(out_ct.Alloc(vector->ct_len));
+            ASSERT_TRUE(out_tag.Alloc(vector->tag_len));
+            ASSERT_TRUE(out_pt.Alloc(vector->pt_len));
+
+            TestAesKey key(vector->key, vector->key_len);
+
+            EXPECT_EQ(AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, key.key, vector->nonce,
+                                      vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len),
+                      CHIP_NO_ERROR);
+            EXPECT_EQ(memcmp(out_ct.Get(), vector->ct, vector->ct_len), 0);
+            EXPECT_EQ(memcmp(out_tag.Get(), vector->tag, vector->tag_len), 0);
+
+            if (pass == 1)
+            {
+                // Fail authentication once before decrypting the genuine message.
+                out_tag[0] ^= 1;
+                EXPECT_NE(AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, out_tag.Get(), vector->tag_len,
+                                          key.key, vector->nonce, vector->nonce_len, out_pt.Get()),
+                          CHIP_NO_ERROR);
+            }
+
+            EXPECT_EQ(AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                      key.key, vector->nonce, vector->nonce_len, out_pt.Get()),
+                      CHIP_NO_ERROR);
+            EXPECT_EQ(memcmp(out_pt.Get(), vector->pt, vector->pt_len), 0);
+        }
+    }
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
+// Keyed contexts are kept per key handle, so they must follow the key currently set in a handle: one
+// replaced or destroyed through the keystore, or one written without the keystore.
+TEST_F(TestChipCryptoPAL, TestAES_CCM_128ReusedKeyHandle)
+{
+    HeapChecker heapChecker;
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle keystoreKey;
+    Aes128KeyHandle rawKey;
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+        {
+            const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+            if (vector->pt_len == 0 || vector->result != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+            numOfTestsRan++;
+
+            Symmetric128BitsKeyByteArray keyMaterial;
+            memcpy(keyMaterial, vector->key, vector->key_len);
+
+            // On the first pass, the previous key is replaced without being destroyed.
+            ASSERT_EQ(keystore.CreateKey(keyMaterial, keystoreKey), CHIP_NO_ERROR);
+            memcpy(rawKey.AsMutable<Symmetric128BitsKeyByteArray>(), keyMaterial, sizeof(keyMaterial));
+
+            for (const Aes128KeyHandle * key : { &keystoreKey, &rawKey })
+            {
+                chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+                chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+                chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+                ASSERT_TRUE(out_ct.Alloc(vector->ct_len));
+                ASSERT_TRUE(out_tag.Alloc(vector->tag_len));
+                ASSERT_TRUE(out_pt.Alloc(vector->pt_len));
+
+                for (int repeat = 0; repeat < 2; repeat++)
+                {
+                    EXPECT_EQ(AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, *key, vector->nonce,
+                                              vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len),
+                              CHIP_NO_ERROR);
+                    EXPECT_EQ(memcmp(out_ct.Get(), vector->ct, vector->ct_len), 0);
+                    EXPECT_EQ(memcmp(out_tag.Get(), vector->tag, vector->tag_len), 0);
+
+                    EXPECT_EQ(AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag,
+                                              vector->tag_len, *key, vector->nonce, vector->nonce_len, out_pt.Get()),
+                              CHIP_NO_ERROR);
+                    EXPECT_EQ(memcmp(out_pt.Get(), vector->pt, vector->pt_len), 0);
+                }
+            }
+
+            if (pass == 1)
+            {
+                keystore.DestroyKey(keystoreKey);
+            }
+        }
+    }
+    keystore.DestroyKey(keystoreKey);
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
+// A handle set by the keystore may be left without being destroyed, and a later handle at the same address
+// filled without the keystore, as the ICD code does.  The contexts kept for the handle must follow its new key.
+TEST_F(TestChipCryptoPAL, TestAES_CCM_128OverwrittenKeyHandle)
+{
+    HeapChecker heapChecker;
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+    Aes128KeyHandle otherKeys[64];
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfKeyChanges  = 0;
+
+    const Symmetric128BitsKeyByteArray initialKeyMaterial = {};
+    ASSERT_EQ(keystore.CreateKey(initialKeyMaterial, key), CHIP_NO_ERROR);
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+        {
+            const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+            if (vector->pt_len == 0 || vector->result != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+
+            if (memcmp(key.As<Symmetric128BitsKeyByteArray>(), vector->key, vector->key_len) != 0)
+            {
+                numOfKeyChanges++;
+            }
+            memcpy(key.AsMutable<Symmetric128BitsKeyByteArray>(), vector->key, vector->key_len);
+
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            ASSERT_TRUE(out_ct.Alloc(vector->ct_len));
+            ASSERT_TRUE(out_tag.Alloc(vector->tag_len));
+            ASSERT_TRUE(out_pt.Alloc(vector->pt_len));
+
+            for (int repeat = 0; repeat < 2; repeat++)
+            {
+                EXPECT_EQ(AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, key, vector->nonce,
+                                          vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len),
+                          CHIP_NO_ERROR);
+                EXPECT_EQ(memcmp(out_ct.Get(), vector->ct, vector->ct_len), 0);
+                EXPECT_EQ(memcmp(out_tag.Get(), vector->tag, vector->tag_len), 0);
+
+                EXPECT_EQ(AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                          key, vector->nonce, vector->nonce_len, out_pt.Get()),
+                          CHIP_NO_ERROR);
+                EXPECT_EQ(memcmp(out_pt.Get(), vector->pt, vector->pt_len), 0);
+            }
+        }
+
+        // On the second pass, the cache is full of handles that are never destroyed.
+        for (Aes128KeyHandle & otherKey : otherKeys)
+        {
+            ASSERT_EQ(keystore.CreateKey(initialKeyMaterial, otherKey), CHIP_NO_ERROR);
+        }
+        ASSERT_EQ(keystore.CreateKey(initialKeyMaterial, key), CHIP_NO_ERROR);
+    }
+
+    keystore.DestroyKey(key);
+    for (Aes128KeyHandle & otherKey : otherKeys)
+    {
+        keystore.DestroyKey(otherKey);
+    }
+    EXPECT_GT(numOfKeyChanges, 1);
+}
+
 TEST_F(TestChipCryptoPAL, TestAES_CCM_128EncryptInvalidNonceLen)
 {
     HeapChecker heapChecker;
@@ -72,6 +72,11 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitChipStack()
     VerifyOrReturnError(ret == 0, CHIP_ERROR_POSIX(ret));
 #endif
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    // Unlike on FreeRTOS, applications do not start the background task themselves.
+    ReturnErrorOnFailure(Impl()->StartBackgroundEventLoopTask());
+#endif
+
     return CHIP_NO_ERROR;
 }
 
@@ -167,9 +172,10 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
     SystemLayer().ScheduleWork(&_DispatchEventViaScheduleWork, eventCopyP);
     return CHIP_NO_ERROR;
 #else
-    mChipEventQueue.Push(*event);
-
-    SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    if (mChipEventQueue.Push(*event))
+    {
+        SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    }
     return CHIP_NO_ERROR;
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
@@ -179,11 +185,21 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessDeviceEvents()
 {
-    while (!mChipEventQueue.Empty())
+    // Events posted from now on wake the event loop up again.
+    mChipEventQueue.PrepareToPop();
+
+    // Handle events in batches of at most one queue's worth, so that handlers posting further events cannot keep the
+    // event loop from servicing timers and sockets.
+    ChipDeviceEvent event;
+    for (size_t count = 0; count < CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE && mChipEventQueue.PopFront(event); count++)
     {
-        const ChipDeviceEvent event = mChipEventQueue.PopFront();
         Impl()->DispatchEvent(&event);
     }
+
+    if (!mChipEventQueue.Empty())
+    {
+        SystemLayerSocketsLoop().Signal();
+    }
 }
 
 template <class ImplClass>
@@ -383,6 +399,140 @@ exit:
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    if (!(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+
+    if (!mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        // Use foreground event loop for background events
+        return Impl()->PostEvent(event);
+    }
+
+    if (mBackgroundEventQueueLength == CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE)
+    {
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        ChipLogError(DeviceLayer, "Failed to post event to CHIP background event queue");
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    mBackgroundEventQueue[(mBackgroundEventQueueHead + mBackgroundEventQueueLength) % CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE] =
+        *event;
+    mBackgroundEventQueueLength++;
+
+    pthread_cond_signal(&mBackgroundEventQueueCond);
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+
+    // Any number of threads may run this loop, each taking the next event from the shared queue.
+    // Events still queued when the loop is stopped are processed before returning, so that the
+    // work they carry is not lost.
+    while (true)
+    {
+        while (mShouldRunBackgroundEventLoop && mBackgroundEventQueueLength == 0)
+        {
+            pthread_cond_wait(&mBackgroundEventQueueCond, &mBackgroundEventQueueLock);
+        }
+        if (mBackgroundEventQueueLength == 0)
+        {
+            break;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue[mBackgroundEventQueueHead];
+        mBackgroundEventQueueHead   = (mBackgroundEventQueueHead + 1) % CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE;
+        mBackgroundEventQueueLength--;
+
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventQueueLock);
+    }
+
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->Impl()->RunBackgroundEventLoop();
+    return nullptr;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    int err = 0;
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+
+    if (mBackgroundEventLoopTaskCount == 0)
+    {
+        mShouldRunBackgroundEventLoop = true;
+        for (size_t i = 0; i < CHIP_DEVICE_CONFIG_BG_TASK_COUNT; i++)
+        {
+            err = pthread_create(&mBackgroundEventLoopTasks[i], nullptr, BackgroundEventLoopTaskMain, this);
+            if (err != 0)
+            {
+                break;
+            }
+            mBackgroundEventLoopTaskCount++;
+        }
+    }
+
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    if (err != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to start CHIP background task: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(err).Format());
+        _StopBackgroundEventLoopTask();
+    }
+
+    return CHIP_ERROR_POSIX(err);
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    int err = 0;
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = false;
+    pthread_cond_broadcast(&mBackgroundEventQueueCond);
+    size_t taskCount              = mBackgroundEventLoopTaskCount;
+    mBackgroundEventLoopTaskCount = 0;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        // A background task stopping the loop cannot wait for itself.
+        if (pthread_equal(pthread_self(), mBackgroundEventLoopTasks[i]))
+        {
+            pthread_detach(mBackgroundEventLoopTasks[i]);
+            continue;
+        }
+        int joinErr = pthread_join(mBackgroundEventLoopTasks[i], nullptr);
+        err         = (err == 0) ? joinErr : err;
+    }
+
+    return CHIP_ERROR_POSIX(err);
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
 {
@@ -393,6 +543,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    Impl()->StopBackgroundEventLoopTask();
+#endif
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
@@ -272,6 +272,23 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    Maximum number of datagrams the socket-based implementation of UDP
+ *    endpoints reads per wakeup.
+ *
+ *  @details
+ *    When greater than 1, pending datagrams are drained with a single
+ *    recvmmsg() call into receive buffers that are kept by the endpoint
+ *    between wakeups, instead of one recvmsg() call and one fresh buffer per
+ *    datagram. Requires recvmmsg() support from the platform.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE 1
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
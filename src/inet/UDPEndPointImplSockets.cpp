@@ -433,6 +433,13 @@ void UDPEndPointImplSockets::CloseImpl()
         close(mSocket);
         mSocket = kInvalidSocketFd;
     }
+
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    for (auto & buffer : mReceiveBatchBuffers)
+    {
+        buffer = nullptr;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
 }
 
 void UDPEndPointImplSockets::Free()
@@ -577,123 +584,194 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
-    CHIP_ERROR lStatus = CHIP_NO_ERROR;
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    HandleBatchedReceive();
+#else
     IPPacketInfo lPacketInfo;
-    System::PacketBufferHandle lBuffer;
-
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
+    System::PacketBufferHandle lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+    if (lBuffer.IsNull())
+    {
+        DeliverReceivedMessage(CHIP_ERROR_NO_MEMORY, std::move(lBuffer), lPacketInfo);
+        return;
+    }
 
-    lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+    ReceiveSlot slot;
+    struct msghdr msgHeader;
+    slot.Prepare(lBuffer, msgHeader);
 
-    if (!lBuffer.IsNull())
+    CHIP_ERROR lStatus;
+    ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+    if (rcvLen == -1)
+    {
+        lStatus = CHIP_ERROR_POSIX(errno);
+    }
+    else
     {
-        struct iovec msgIOV;
-        SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
-        struct msghdr msgHeader;
+        lStatus = ParseReceivedMessage(msgHeader, static_cast<size_t>(rcvLen), slot, lBuffer, lPacketInfo);
+    }
+    DeliverReceivedMessage(lStatus, std::move(lBuffer), lPacketInfo);
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+}
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+void UDPEndPointImplSockets::HandleBatchedReceive()
+{
+    ReceiveSlot slots[INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE];
+    struct mmsghdr msgHeaders[INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE];
+    unsigned int slotCount = 0;
 
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
+    // Top up the receive buffers kept from the previous wakeup; only the ones
+    // handed up to the application need to be replaced.
+    for (auto & buffer : mReceiveBatchBuffers)
+    {
+        if (buffer.IsNull())
+        {
+            buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (buffer.IsNull())
+            {
+                break;
+            }
+        }
+        memset(&msgHeaders[slotCount], 0, sizeof(msgHeaders[slotCount]));
+        slots[slotCount].Prepare(buffer, msgHeaders[slotCount].msg_hdr);
+        slotCount++;
+    }
+
+    if (slotCount == 0)
+    {
+        IPPacketInfo lPacketInfo;
+        DeliverReceivedMessage(CHIP_ERROR_NO_MEMORY, System::PacketBufferHandle(), lPacketInfo);
+        return;
+    }
 
-        memset(&msgHeader, 0, sizeof(msgHeader));
+    int rcvCount = recvmmsg(mSocket, msgHeaders, slotCount, MSG_DONTWAIT, nullptr);
+    if (rcvCount == -1)
+    {
+        IPPacketInfo lPacketInfo;
+        DeliverReceivedMessage(CHIP_ERROR_POSIX(errno), System::PacketBufferHandle(), lPacketInfo);
+        return;
+    }
 
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+    // The application may close or free this endpoint from its receive
+    // callback; keep it alive until the whole batch has been handled.
+    Retain();
+    for (int i = 0; i < rcvCount; i++)
+    {
+        IPPacketInfo lPacketInfo;
+        System::PacketBufferHandle lBuffer = std::move(mReceiveBatchBuffers[i]);
 
-        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+        CHIP_ERROR lStatus = ParseReceivedMessage(msgHeaders[i].msg_hdr, msgHeaders[i].msg_len, slots[i], lBuffer, lPacketInfo);
+        DeliverReceivedMessage(lStatus, std::move(lBuffer), lPacketInfo);
 
-        if (rcvLen == -1)
-        {
-            lStatus = CHIP_ERROR_POSIX(errno);
-        }
-        else if (lBuffer->AvailableDataLength() < static_cast<size_t>(rcvLen))
+        if (mState != State::kListening || OnMessageReceived == nullptr)
         {
-            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+            // Remaining datagrams were already dequeued from the socket, but
+            // nobody is listening for them any more.
+            break;
         }
-        else
-        {
-            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+    }
+    Release();
+}
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
+void UDPEndPointImplSockets::ReceiveSlot::Prepare(const System::PacketBufferHandle & buffer, struct msghdr & msgHeader)
+{
+    msgIOV.iov_base = buffer->Start();
+    msgIOV.iov_len  = buffer->AvailableDataLength();
+
+    memset(&peerSockAddr, 0, sizeof(peerSockAddr));
+
+    memset(&msgHeader, 0, sizeof(msgHeader));
+
+    msgHeader.msg_name       = &peerSockAddr;
+    msgHeader.msg_namelen    = sizeof(peerSockAddr);
+    msgHeader.msg_iov        = &msgIOV;
+    msgHeader.msg_iovlen     = 1;
+    msgHeader.msg_control    = controlData;
+    msgHeader.msg_controllen = sizeof(controlData);
+}
+
+CHIP_ERROR UDPEndPointImplSockets::ParseReceivedMessage(struct msghdr & msgHeader, size_t rcvLen, const ReceiveSlot & slot,
+                                                        const System::PacketBufferHandle & buffer, IPPacketInfo & packetInfo)
+{
+    packetInfo.Clear();
+    packetInfo.DestPort  = mBoundPort;
+    packetInfo.Interface = mBoundIntfId;
+
+    if (buffer->AvailableDataLength() < rcvLen)
+    {
+        return CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+    }
+
+    buffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+
+    if (slot.peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(slot.peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(slot.peerSockAddr.in6.sin6_port);
+    }
 #if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
+    else if (slot.peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(slot.peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(slot.peerSockAddr.in.sin_port);
+    }
 #endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
 
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
 #if INET_CONFIG_ENABLE_IPV4
 #ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
 #endif // defined(IP_PKTINFO)
 #endif // INET_CONFIG_ENABLE_IPV4
 
 #ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
             }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
         }
-    }
-    else
-    {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+#endif // defined(IPV6_PKTINFO)
     }
 
-    if (lStatus == CHIP_NO_ERROR)
+    return CHIP_NO_ERROR;
+}
+
+void UDPEndPointImplSockets::DeliverReceivedMessage(CHIP_ERROR status, System::PacketBufferHandle && buffer,
+                                                    const IPPacketInfo & packetInfo)
+{
+    if (status == CHIP_NO_ERROR)
     {
-        lBuffer.RightSize();
-        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        buffer.RightSize();
+        OnMessageReceived(this, std::move(buffer), &packetInfo);
     }
     else
     {
-        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        if (OnReceiveError != nullptr && status != CHIP_ERROR_POSIX(EAGAIN))
         {
-            OnReceiveError(this, lStatus, nullptr);
+            OnReceiveError(this, status, nullptr);
         }
     }
 }
@@ -54,13 +54,34 @@ private:
     CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg) override;
     void CloseImpl() override;
 
+    // Per-datagram state handed to recvmsg()/recvmmsg().
+    struct ReceiveSlot
+    {
+        void Prepare(const System::PacketBufferHandle & buffer, struct msghdr & msgHeader);
+
+        struct iovec msgIOV;
+        SockAddr peerSockAddr;
+        uint8_t controlData[256];
+    };
+
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+    CHIP_ERROR ParseReceivedMessage(struct msghdr & msgHeader, size_t rcvLen, const ReceiveSlot & slot,
+                                    const System::PacketBufferHandle & buffer, IPPacketInfo & packetInfo);
+    void DeliverReceivedMessage(CHIP_ERROR status, System::PacketBufferHandle && buffer, const IPPacketInfo & packetInfo);
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    void HandleBatchedReceive();
+
+    // Receive buffers for recvmmsg(), kept across wakeups so that each batch
+    // only allocates replacements for the buffers it handed up.
+    System::PacketBufferHandle mReceiveBatchBuffers[INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE];
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     enum class MulticastOperation
@@ -231,6 +231,24 @@
 #define CHIP_CONFIG_HKDF_KEY_HANDLE_CONTEXT_SIZE (32 + 1)
 #endif // CHIP_CONFIG_HKDF_KEY_HANDLE_CONTEXT_SIZE
 
+/**
+ *  @def CHIP_CONFIG_AES_CCM_CONTEXT_CACHE_SIZE
+ *
+ *  @brief
+ *    Number of session keys for which the OpenSSL CryptoPAL keeps keyed AES-CCM
+ *    cipher contexts.
+ *
+ *  Reusing a context that has already been set up for a session key saves a
+ *  context allocation and the AES key schedule on every message encrypted or
+ *  decrypted with that key.  Contexts are kept for the keys created by the
+ *  session keystore, and freed when the key is destroyed.  Once every entry is
+ *  taken, the least recently used key gives its entry to the next one.
+ *  Set to 0 to allocate a new context per message.
+ */
+#ifndef CHIP_CONFIG_AES_CCM_CONTEXT_CACHE_SIZE
+#define CHIP_CONFIG_AES_CCM_CONTEXT_CACHE_SIZE 0
+#endif // CHIP_CONFIG_AES_CCM_CONTEXT_CACHE_SIZE
+
 /**
  *  @def CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
  *
@@ -769,6 +787,22 @@
 #define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+ *
+ * @brief Enables hash indexes of the secure session table by local session ID
+ * and by peer node ID.
+ *
+ * With the indexes, dispatching an incoming message to its session and looking
+ * up the sessions to a given peer take constant time instead of walking the
+ * whole session pool.  This is mostly useful for controllers that keep a large
+ * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; each index costs two slots per pool
+ * entry (rounded up to a power of two).
+ */
+#ifndef CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+#define CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX 0
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
 /**
  *  @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
  *
@@ -931,6 +965,30 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+ *
+ * @brief If true, the reporting engine keeps the attribute paths of all read handlers
+ *        indexed by endpoint and cluster, so that marking a concrete attribute dirty only
+ *        visits the handlers interested in that cluster.  The index is rebuilt on the next
+ *        change after any read handler's path list changes, and costs one entry per path.
+ */
+#ifndef CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+#define CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+ *
+ * @brief The size in bytes of the buffer the reporting engine uses to share attribute encodings
+ *        between read handlers, or 0 to disable sharing.  Within one run of the reporting engine,
+ *        an attribute that several read handlers report is read and encoded once per accessing
+ *        fabric, and copied into the reports of the other handlers.
+ */
+#ifndef CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+#define CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE 0
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1032,6 +1090,64 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_CONTROLLER_MAX_CONCURRENT_CASE_SESSION_SETUPS
+ *
+ * @brief Number of session setups, from address resolution to the end of CASE, a controller
+ *        runs at once.  Further session setups are queued by CASESessionManager until one
+ *        completes, instead of overflowing the CASE client pool.  0, the default, means no
+ *        limit; a controller starting many session setups at once should set it to at most
+ *        CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_MAX_CONCURRENT_CASE_SESSION_SETUPS
+#define CHIP_CONFIG_CONTROLLER_MAX_CONCURRENT_CASE_SESSION_SETUPS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_CONTROLLER_CASE_SESSION_SETUP_BACKOFF_INITIAL_DELAY_MS
+ *
+ * @brief Time, in milliseconds, a controller waits before setting up a session with a node
+ *        again after a failed session setup.  The delay doubles with every further failure,
+ *        up to CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT times.  0, the default, disables
+ *        the backoff.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_CASE_SESSION_SETUP_BACKOFF_INITIAL_DELAY_MS
+#define CHIP_CONFIG_CONTROLLER_CASE_SESSION_SETUP_BACKOFF_INITIAL_DELAY_MS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT
+ *
+ * @brief Number of times the session setup backoff delay of CASESessionManager is doubled at most.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT
+#define CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_MAX_SHIFT 5
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_TABLE_SIZE
+ *
+ * @brief Number of nodes for which CASESessionManager remembers failed session setups, to back
+ *        off from them.  When full, the node whose backoff ends first is forgotten.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_TABLE_SIZE
+#define CHIP_CONFIG_CASE_SESSION_SETUP_BACKOFF_TABLE_SIZE 8
+#endif
+
+/**
+ * @def CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+ *
+ * @brief If true, ClusterStateCache keeps its endpoint, cluster and attribute
+ *        state in vectors sorted by ID instead of nested std::maps, and tracks
+ *        the attributes changed by a report in a vector.  This trades
+ *        per-entry allocations and pointer chasing for moving entries on
+ *        insertion, which suits controllers caching large wildcard
+ *        subscriptions.
+ */
+#ifndef CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+#define CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE 0
+#endif
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -1107,6 +1223,30 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+ *
+ * @brief Defines the number of (group, operational key) pairs GroupDataProviderImpl
+ *        keeps indexed by session id to look up the keys of incoming group messages.
+ *
+ * Each group/keyset mapping takes up one entry per epoch key of its keyset.  When the
+ * stored mappings need more entries, group sessions are looked up in persistent
+ * storage instead.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE_KEYS
+ *
+ * @brief Defines the number of operational group keys GroupDataProviderImpl keeps
+ *        imported in the session keystore for decrypting incoming group messages.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_KEYS
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_KEYS 4
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1116,6 +1256,33 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_CACHE
+ *
+ * @brief Enables caching in AccessControl::Check.
+ *
+ * When enabled, the entries of each fabric are compiled into flat arrays with
+ * their subjects sorted, so a check only evaluates the entries that may apply
+ * to the subject, without going through the delegate.  Recent decisions are
+ * also kept, see CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE.  Both are
+ * invalidated whenever an entry is created, updated or deleted.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_CACHE
+#define CHIP_CONFIG_ACCESS_CONTROL_CACHE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+ *
+ * @brief Defines the number of recent (subject, path, privilege) decisions
+ *        AccessControl keeps when CHIP_CONFIG_ACCESS_CONTROL_CACHE is enabled.
+ *
+ * Decisions that depend on which device types are on an endpoint are never kept.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE 8
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -1236,6 +1403,21 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+ *
+ * @brief The number of entries in the sparse event number index kept by each
+ *   event buffer, or 0 to disable the index.
+ *
+ * The index maps event numbers to positions in the buffer, sampled roughly
+ * every 1/CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE of the buffer size, and
+ * lets event reports seek past the events a reader has already seen instead
+ * of parsing every stored event from the head of the buffer.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE 0
+#endif /* CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1359,6 +1541,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE
+ *
+ * @brief Number of resolved operational nodes the minmdns resolver remembers.
+ *        Data from any received response (including unsolicited announcements)
+ *        is kept until the smallest TTL of its SRV/TXT/AAAA records expires, and
+ *        node ID resolutions for cached nodes complete without sending queries.
+ *
+ *        Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -218,6 +218,13 @@ void TLVCircularBuffer::GetCurrentWritableBuffer(uint8_t *& outBufStart, uint32_
     }
 }
 
+void TLVCircularBuffer::SetQueueState(uint32_t inHeadOffset, uint32_t inDataLength)
+{
+    VerifyOrDie(inHeadOffset < mQueueSize && inDataLength <= mQueueSize);
+    mQueueHead   = mQueue + inHeadOffset;
+    mQueueLength = inDataLength;
+}
+
 /**
  * @brief
  *   FinalizeBuffer adjust the `TLVCircularBuffer` state on
@@ -139,6 +139,17 @@ protected:
      */
     void GetCurrentWritableBuffer(uint8_t *& outBufStart, uint32_t & outBufLen) const;
 
+    /**
+     * @brief
+     *   Sets the position and length of the data held in the backing store, e.g. when the backing store outlives the buffer.
+     *
+     * @param[in] inHeadOffset Offset of the oldest element in the backing store; must be less than the backing store length
+     *
+     * @param[in] inDataLength Length of the data starting at @a inHeadOffset, wrapping around the end of the backing store;
+     *                         must not exceed the backing store length
+     */
+    void SetQueueState(uint32_t inHeadOffset, uint32_t inDataLength);
+
 private:
     uint8_t * mQueue;
     uint32_t mQueueSize;
@@ -145,6 +145,8 @@ CHIP_ERROR IncrementalResolver::InitializeParsing(mdns::Minimal::SerializedQName
     ReturnErrorOnFailure(mRecordName.Set(name));
     ReturnErrorOnFailure(mTargetHostName.Set(srv.GetName()));
     mCommonResolutionData.port = srv.GetPort();
+    mTtlSeconds                = UINT32_MAX;
+    UpdateTtl(ttl);
 
     {
         // TODO: Chip code historically seems to assume that the host name is of the
@@ -248,7 +250,9 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             MATTER_TRACE_INSTANT("TXT not applicable", "Resolver");
             return CHIP_NO_ERROR;
         }
-        return OnTxtRecord(data, packetRange);
+        ReturnErrorOnFailure(OnTxtRecord(data, packetRange));
+        UpdateTtl(data.GetTtlSeconds());
+        return CHIP_NO_ERROR;
     case QType::A: {
         if (data.GetName() != mTargetHostName.Get())
         {
@@ -263,7 +267,9 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
-        return OnIpAddress(interface, addr);
+        ReturnErrorOnFailure(OnIpAddress(interface, addr));
+        UpdateTtl(data.GetTtlSeconds());
+        return CHIP_NO_ERROR;
 #else
 #if CHIP_MINMDNS_HIGH_VERBOSITY
         ChipLogProgress(Discovery, "Ignoring A record: IPv4 not supported");
@@ -285,7 +291,9 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
-        return OnIpAddress(interface, addr);
+        ReturnErrorOnFailure(OnIpAddress(interface, addr));
+        UpdateTtl(data.GetTtlSeconds());
+        return CHIP_NO_ERROR;
     }
     case QType::SRV: // SRV handled on creation, ignored for 'additional data'
     default:
@@ -343,6 +351,14 @@ CHIP_ERROR IncrementalResolver::OnIpAddress(Inet::InterfaceId interface, const I
     return CHIP_NO_ERROR;
 }
 
+void IncrementalResolver::UpdateTtl(uint64_t ttl)
+{
+    if (ttl < mTtlSeconds)
+    {
+        mTtlSeconds = static_cast<uint32_t>(ttl);
+    }
+}
+
 CHIP_ERROR IncrementalResolver::Take(DiscoveredNodeData & outputData)
 {
     VerifyOrReturnError(IsActiveCommissionParse(), CHIP_ERROR_INCORRECT_STATE);
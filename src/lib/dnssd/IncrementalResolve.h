@@ -149,6 +149,10 @@ public:
     ///           as this object is valid and InitializeParsing is not called again.
     mdns::Minimal::SerializedQNameIterator GetRecordName() const { return mRecordName.Get(); }
 
+    /// Smallest TTL, in seconds, of the SRV, TXT and A/AAAA records that
+    /// contributed to the current data. Only valid while `IsActive()`.
+    uint32_t GetTtlSeconds() const { return mTtlSeconds; }
+
     /// Take the current value of the object and clear it once returned.
     ///
     /// Object must be in `IsActive()` for this to succeed.
@@ -186,11 +190,15 @@ private:
     /// Prerequisite: IP address belongs to the right nost name
     CHIP_ERROR OnIpAddress(Inet::InterfaceId interface, const Inet::IPAddress & addr);
 
+    /// Lowers the tracked TTL to [ttl] if [ttl] is smaller.
+    void UpdateTtl(uint64_t ttl);
+
     using ParsedRecordSpecificData = Variant<OperationalNodeData, CommissionNodeData>;
 
     StoredServerName mRecordName;     // Record name for what is parsed (SRV/PTR/TXT)
     StoredServerName mTargetHostName; // `Target` for the SRV record
     ServiceNameType mServiceNameType = ServiceNameType::kInvalid;
+    uint32_t mTtlSeconds             = 0;
     CommonResolutionData mCommonResolutionData;
     ParsedRecordSpecificData mSpecificResolutionData;
 };
@@ -0,0 +1,200 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "OperationalRecordCache.h"
+
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace Dnssd {
+
+OperationalRecordCacheBase::Entry * OperationalRecordCacheBase::Find(const PeerId & peerId, System::Clock::Timestamp now)
+{
+    for (auto & entry : mEntries)
+    {
+        if (!entry.inUse || (entry.nodeData.operationalData.peerId != peerId))
+        {
+            continue;
+        }
+
+        if (entry.expiry <= now)
+        {
+            entry.inUse = false;
+            return nullptr;
+        }
+
+        return &entry;
+    }
+
+    return nullptr;
+}
+
+void OperationalRecordCacheBase::Insert(const ResolvedNodeData & nodeData, uint32_t ttlSeconds)
+{
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    if (ttlSeconds == 0)
+    {
+        Remove(nodeData.operationalData.peerId);
+        return;
+    }
+
+    Entry * target = Find(nodeData.operationalData.peerId, now);
+
+    if (target == nullptr)
+    {
+        // Prefer a free or expired entry, else replace the least recently used one.
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse || (entry.expiry <= now))
+            {
+                target = &entry;
+                break;
+            }
+
+            if ((target == nullptr) || (entry.lastUsed < target->lastUsed))
+            {
+                target = &entry;
+            }
+        }
+
+        if (target->inUse && (target->expiry > now))
+        {
+            mStatistics.evictions++;
+        }
+    }
+
+    target->nodeData = nodeData;
+    target->expiry   = now + System::Clock::Seconds32(ttlSeconds);
+    target->lastUsed = now;
+    target->inUse    = true;
+}
+
+bool OperationalRecordCacheBase::Lookup(const PeerId & peerId, ResolvedNodeData & outData)
+{
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    Entry * entry = Find(peerId, now);
+    if (entry == nullptr)
+    {
+        mStatistics.misses++;
+        return false;
+    }
+
+    mStatistics.hits++;
+    entry->lastUsed = now;
+    outData         = entry->nodeData;
+    return true;
+}
+
+bool OperationalRecordCacheBase::Get(const PeerId & peerId, ResolvedNodeData & outData)
+{
+    Entry * entry = Find(peerId, mClock->GetMonotonicTimestamp());
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    outData = entry->nodeData;
+    return true;
+}
+
+void OperationalRecordCacheBase::Remove(const PeerId & peerId)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.inUse && (entry.nodeData.operationalData.peerId == peerId))
+        {
+            entry.inUse = false;
+        }
+    }
+}
+
+void OperationalRecordCacheBase::RemoveHost(const char * hostName)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.inUse && (strcmp(entry.nodeData.resolutionData.hostName, hostName) == 0))
+        {
+            entry.inUse = false;
+        }
+    }
+}
+
+void OperationalRecordCacheBase::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.inUse = false;
+    }
+}
+
+bool CachedResolvesBase::Add(const PeerId & peerId)
+{
+    ResolvedNodeData nodeData;
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        if (mPeerIds[i] == peerId)
+        {
+            // Already queued, but still counts as a cache hit.
+            return mCache.Lookup(peerId, nodeData);
+        }
+    }
+
+    VerifyOrReturnValue(mCount < mPeerIds.size(), false);
+    VerifyOrReturnValue(mCache.Lookup(peerId, nodeData), false);
+
+    mPeerIds[mCount++] = peerId;
+    return true;
+}
+
+void CachedResolvesBase::Remove(const PeerId & peerId)
+{
+    for (size_t i = 0; i < mCount; i++)
+    {
+        if (mPeerIds[i] == peerId)
+        {
+            mPeerIds[i] = mPeerIds[--mCount];
+            return;
+        }
+    }
+}
+
+void CachedResolvesBase::Report(Delegate & delegate)
+{
+    // The delegate may add or remove resolutions, so take one entry at a time.
+    while (mCount > 0)
+    {
+        const PeerId peerId = mPeerIds[--mCount];
+        ResolvedNodeData nodeData;
+
+        if (mCache.Get(peerId, nodeData))
+        {
+            delegate.OnCachedNodeResolved(nodeData);
+        }
+        else
+        {
+            delegate.OnCachedNodeExpired(peerId);
+        }
+    }
+}
+
+} // namespace Dnssd
+} // namespace chip
@@ -0,0 +1,165 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <lib/core/PeerId.h>
+#include <lib/dnssd/Types.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace Dnssd {
+
+/// Remembers recently resolved operational nodes.
+///
+/// Each entry holds the data built from a SRV record and its TXT and A/AAAA
+/// records, and is valid for the smallest TTL of those records. Once full,
+/// inserting a new node replaces an expired entry or else the least recently
+/// used one.
+class OperationalRecordCacheBase
+{
+public:
+    struct Statistics
+    {
+        uint32_t hits      = 0; // lookups answered from the cache
+        uint32_t misses    = 0; // lookups for nodes not cached or expired
+        uint32_t evictions = 0; // unexpired entries replaced to make room
+    };
+
+    OperationalRecordCacheBase(const OperationalRecordCacheBase &)             = delete;
+    OperationalRecordCacheBase & operator=(const OperationalRecordCacheBase &) = delete;
+
+    /// Stores [nodeData] for [ttlSeconds], replacing any previous data for the
+    /// same peer. A TTL of 0 (e.g. a goodbye announcement) removes the peer.
+    void Insert(const ResolvedNodeData & nodeData, uint32_t ttlSeconds);
+
+    /// Fetches unexpired data for [peerId] and updates the hit/miss statistics.
+    bool Lookup(const PeerId & peerId, ResolvedNodeData & outData);
+
+    /// Same as Lookup, without affecting statistics or eviction order.
+    bool Get(const PeerId & peerId, ResolvedNodeData & outData);
+
+    void Remove(const PeerId & peerId);
+
+    /// Removes every node whose SRV target host name (first label only, as
+    /// stored in CommonResolutionData::hostName) is [hostName].
+    void RemoveHost(const char * hostName);
+
+    void Clear();
+
+    const Statistics & GetStatistics() const { return mStatistics; }
+
+protected:
+    struct Entry
+    {
+        ResolvedNodeData nodeData;
+        System::Clock::Timestamp expiry;
+        System::Clock::Timestamp lastUsed;
+        bool inUse = false;
+    };
+
+    OperationalRecordCacheBase(System::Clock::ClockBase * clock, Span<Entry> entries) : mClock(clock), mEntries(entries) {}
+
+private:
+    /// Returns the unexpired entry for [peerId], releasing it if it expired.
+    Entry * Find(const PeerId & peerId, System::Clock::Timestamp now);
+
+    System::Clock::ClockBase * mClock;
+    Span<Entry> mEntries;
+    Statistics mStatistics;
+};
+
+template <size_t kCacheSize>
+class OperationalRecordCache : public OperationalRecordCacheBase
+{
+public:
+    static_assert(kCacheSize > 0, "Operational record cache must have at least one entry");
+
+    OperationalRecordCache(System::Clock::ClockBase * clock) : OperationalRecordCacheBase(clock, Span<Entry>(mStorage)) {}
+
+private:
+    Entry mStorage[kCacheSize];
+};
+
+/// Node ID resolutions answered from an OperationalRecordCache.
+///
+/// Results cannot be reported from within Resolver::ResolveNodeId, as its
+/// callers only expect them once it has returned. Resolutions are queued
+/// instead, and reported later (e.g. from a zero-delay timer) from the data
+/// cached at that time.
+class CachedResolvesBase
+{
+public:
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /// A queued resolution completed with the cached [nodeData].
+        virtual void OnCachedNodeResolved(const ResolvedNodeData & nodeData) = 0;
+
+        /// The cached data for a queued resolution of [peerId] expired (or was
+        /// removed) before it could be reported.
+        virtual void OnCachedNodeExpired(const PeerId & peerId) = 0;
+    };
+
+    CachedResolvesBase(const CachedResolvesBase &)             = delete;
+    CachedResolvesBase & operator=(const CachedResolvesBase &) = delete;
+
+    /// Queues a resolution of [peerId] if the cache holds unexpired data for
+    /// it. Returns false on a cache miss or if the queue is full.
+    bool Add(const PeerId & peerId);
+
+    void Remove(const PeerId & peerId);
+
+    bool IsEmpty() const { return mCount == 0; }
+
+    /// Reports and dequeues every queued resolution. The delegate may add or
+    /// remove resolutions while being called.
+    void Report(Delegate & delegate);
+
+protected:
+    CachedResolvesBase(OperationalRecordCacheBase & cache, Span<PeerId> peerIds) : mCache(cache), mPeerIds(peerIds) {}
+
+private:
+    OperationalRecordCacheBase & mCache;
+    Span<PeerId> mPeerIds;
+    size_t mCount = 0;
+};
+
+template <size_t kQueueSize>
+class CachedResolves : public CachedResolvesBase
+{
+public:
+    static_assert(kQueueSize > 0, "Cached resolve queue must have at least one entry");
+
+    CachedResolves(OperationalRecordCacheBase & cache) : CachedResolvesBase(cache, Span<PeerId>(mStorage)) {}
+
+private:
+    PeerId mStorage[kQueueSize];
+};
+
+/// Statistics of the operational cache used by the minimal mDNS resolver.
+///
+/// All counters stay 0 when CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE is 0.
+OperationalRecordCacheBase::Statistics GetMinMdnsOperationalCacheStatistics();
+
+} // namespace Dnssd
+} // namespace chip
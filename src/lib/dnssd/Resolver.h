@@ -193,6 +193,16 @@ public:
      */
     virtual CHIP_ERROR ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId) = 0;
 
+    /**
+     * Notify the resolver that the address previously resolved for the given
+     * node appears to be out of date (for example because establishing a
+     * session with the node has failed), so that the next ResolveNodeId for
+     * it is not answered from cached data.
+     *
+     * Resolvers that do not cache resolution results need not implement this.
+     */
+    virtual void ForgetNodeId(const PeerId & peerId) {}
+
     /**
      * Returns the system-wide implementation of the service resolver.
      *
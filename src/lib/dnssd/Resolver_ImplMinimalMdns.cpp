@@ -21,6 +21,7 @@
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/OperationalRecordCache.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
@@ -36,6 +37,8 @@
 // These logs are useful for debug only
 #undef MINMDNS_RESOLVER_OVERLY_VERBOSE
 
+#define CHIP_MINMDNS_HAS_OPERATIONAL_CACHE (CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE > 0)
+
 namespace chip {
 namespace Dnssd {
 namespace {
@@ -264,7 +267,7 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
     mParsingState = RecordParsingState::kIdle;
 }
 
-class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
+class MinMdnsResolver : public Resolver, public MdnsPacketDelegate, private CachedResolvesBase::Delegate
 {
 public:
     MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
@@ -286,6 +289,9 @@ public:
     CHIP_ERROR StartDiscovery(DiscoveryType type, DiscoveryFilter filter, DiscoveryContext & context) override;
     CHIP_ERROR StopDiscovery(DiscoveryContext & context) override;
     CHIP_ERROR ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId) override;
+    void ForgetNodeId(const PeerId & peerId) override;
+
+    OperationalRecordCacheBase::Statistics GetOperationalCacheStatistics() const;
 
 private:
     OperationalResolveDelegate * mOperationalDelegate = nullptr;
@@ -294,6 +300,25 @@ private:
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
 
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+    static constexpr size_t kOperationalCacheSize = CHIP_CONFIG_MINMDNS_OPERATIONAL_CACHE_SIZE;
+
+    OperationalRecordCache<kOperationalCacheSize> mOperationalCache{ &chip::System::SystemClock() };
+    CachedResolves<kOperationalCacheSize> mCachedResolves{ mOperationalCache };
+
+    bool ResolveFromCache(const PeerId & peerId);
+    void ReportCachedResolves();
+    static void CachedResolvesCallback(System::Layer *, void * self);
+#endif // CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+
+    // Set when a cached resolve could not be reported after all, and the
+    // network has to be queried.
+    bool mCachedResolvesNeedQueries = false;
+
+    //// CachedResolvesBase::Delegate implementation
+    void OnCachedNodeResolved(const ResolvedNodeData & nodeData) override;
+    void OnCachedNodeExpired(const PeerId & peerId) override;
+
     void SetDiscoveryContext(DiscoveryContext * context);
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
 
@@ -453,7 +478,8 @@ void MinMdnsResolver::AdvancePendingResolverStates()
         {
             MATTER_TRACE_SCOPE("Active operational delegate call", "MinMdnsResolver");
             ResolvedNodeData nodeResolvedData;
-            CHIP_ERROR err = resolver->Take(nodeResolvedData);
+            [[maybe_unused]] const uint32_t ttlSeconds = resolver->GetTtlSeconds();
+            CHIP_ERROR err                             = resolver->Take(nodeResolvedData);
 
             if (err != CHIP_NO_ERROR)
             {
@@ -461,6 +487,11 @@ void MinMdnsResolver::AdvancePendingResolverStates()
                 continue;
             }
 
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+            // Keep announcements as well as answers: either may save a later resolve.
+            mOperationalCache.Insert(nodeResolvedData, ttlSeconds);
+#endif
+
             if (mActiveResolves.HasBrowseFor(chip::Dnssd::DiscoveryType::kOperational))
             {
                 if (mDiscoveryContext != nullptr)
@@ -736,9 +767,32 @@ CHIP_ERROR MinMdnsResolver::StopDiscovery(DiscoveryContext & context)
 
 CHIP_ERROR MinMdnsResolver::ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId)
 {
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+    // There is no reconfirmation query; forget the host so that the next
+    // resolve goes back to the network.
+    mOperationalCache.RemoveHost(hostname);
+#endif
     return CHIP_ERROR_NOT_IMPLEMENTED;
 }
 
+void MinMdnsResolver::ForgetNodeId(const PeerId & peerId)
+{
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+    // A resolve already answered from the cache but not reported yet finds
+    // the node gone, and queries the network instead.
+    mOperationalCache.Remove(peerId);
+#endif
+}
+
+OperationalRecordCacheBase::Statistics MinMdnsResolver::GetOperationalCacheStatistics() const
+{
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+    return mOperationalCache.GetStatistics();
+#else
+    return OperationalRecordCacheBase::Statistics();
+#endif
+}
+
 CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filter)
 {
     mActiveResolves.MarkPending(filter, type);
@@ -748,6 +802,13 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+    if (ResolveFromCache(peerId))
+    {
+        return CHIP_NO_ERROR;
+    }
+#endif
+
     mActiveResolves.MarkPending(peerId);
 
     return SendAllPendingQueries();
@@ -755,9 +816,65 @@ CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
 {
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+    mCachedResolves.Remove(peerId);
+#endif
+
     mActiveResolves.NodeIdResolutionNoLongerNeeded(peerId);
 }
 
+#if CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+
+bool MinMdnsResolver::ResolveFromCache(const PeerId & peerId)
+{
+    VerifyOrReturnValue(mSystemLayer != nullptr, false);
+    VerifyOrReturnValue(mCachedResolves.Add(peerId), false);
+
+    if (mSystemLayer->StartTimer(System::Clock::kZero, &CachedResolvesCallback, this) != CHIP_NO_ERROR)
+    {
+        mCachedResolves.Remove(peerId);
+        return false;
+    }
+
+    return true;
+}
+
+void MinMdnsResolver::ReportCachedResolves()
+{
+    MATTER_TRACE_SCOPE("Report cached resolves", "MinMdnsResolver");
+
+    mCachedResolvesNeedQueries = false;
+    mCachedResolves.Report(*this);
+
+    if (mCachedResolvesNeedQueries)
+    {
+        SendAllPendingQueries();
+    }
+}
+
+void MinMdnsResolver::CachedResolvesCallback(System::Layer *, void * self)
+{
+    static_cast<MinMdnsResolver *>(self)->ReportCachedResolves();
+}
+
+#endif // CHIP_MINMDNS_HAS_OPERATIONAL_CACHE
+
+void MinMdnsResolver::OnCachedNodeResolved(const ResolvedNodeData & nodeData)
+{
+    ChipLogDetail(Discovery, "Resolved " ChipLogFormatPeerId " from cache", ChipLogValuePeerId(nodeData.operationalData.peerId));
+    if (mOperationalDelegate != nullptr)
+    {
+        mOperationalDelegate->OnOperationalNodeResolved(nodeData);
+    }
+}
+
+void MinMdnsResolver::OnCachedNodeExpired(const PeerId & peerId)
+{
+    // Expired or forgotten since the lookup: ask the network after all.
+    mActiveResolves.MarkPending(peerId);
+    mCachedResolvesNeedQueries = true;
+}
+
 CHIP_ERROR MinMdnsResolver::ScheduleRetries()
 {
     MATTER_TRACE_SCOPE("Schedule retries", "MinMdnsResolver");
@@ -784,6 +901,11 @@ MinMdnsResolver gResolver;
 
 } // namespace
 
+OperationalRecordCacheBase::Statistics GetMinMdnsOperationalCacheStatistics()
+{
+    return gResolver.GetOperationalCacheStatistics();
+}
+
 #if CHIP_DNSSD_DEFAULT_MINIMAL
 
 Resolver & GetDefaultResolver()
@@ -317,6 +317,44 @@ TEST(TestIncrementalResolve, TestParseOperational)
     EXPECT_EQ(nodeData.resolutionData.ipAddress[0], addr);
 }
 
+TEST(TestIncrementalResolve, TestTtlTracking)
+{
+    IncrementalResolver resolver;
+
+    SrvRecord srvRecord;
+    PreloadSrvRecord(srvRecord);
+
+    EXPECT_EQ(resolver.InitializeParsing(kTestOperationalName.Serialized(), 4500, srvRecord), CHIP_NO_ERROR);
+    EXPECT_EQ(resolver.GetTtlSeconds(), 4500u);
+
+    Inet::IPAddress addr;
+    EXPECT_TRUE(Inet::IPAddress::FromString("fe80::abcd:ef11:2233:4455", addr));
+
+    // Records for other names do not affect the TTL
+    {
+        IPResourceRecord record(kIrrelevantHostName.Full(), addr);
+        record.SetTtl(10);
+        CallOnRecord(resolver, record);
+    }
+    EXPECT_EQ(resolver.GetTtlSeconds(), 4500u);
+
+    // The smallest TTL of all used records is kept
+    {
+        IPResourceRecord record(kTestHostName.Full(), addr);
+        record.SetTtl(120);
+        CallOnRecord(resolver, record);
+    }
+    EXPECT_EQ(resolver.GetTtlSeconds(), 120u);
+
+    {
+        const char * entries[] = { "SII=23" };
+        TxtResourceRecord record(kTestOperationalName.Full(), entries);
+        record.SetTtl(60);
+        CallOnRecord(resolver, record);
+    }
+    EXPECT_EQ(resolver.GetTtlSeconds(), 60u);
+}
+
 TEST(TestIncrementalResolve, TestParseCommissionable)
 {
     IncrementalResolver resolver;
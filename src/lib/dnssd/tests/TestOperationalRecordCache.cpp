@@ -0,0 +1,263 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/OperationalRecordCache.h>
+
+#include <lib/support/CHIPMemString.h>
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace chip::System::Clock::Literals;
+
+PeerId MakePeerId(NodeId nodeId)
+{
+    PeerId peerId;
+    return peerId.SetNodeId(nodeId).SetCompressedFabricId(123);
+}
+
+class RecordingCachedResolvesDelegate : public CachedResolvesBase::Delegate
+{
+public:
+    void OnCachedNodeResolved(const ResolvedNodeData & nodeData) override
+    {
+        ASSERT_LT(resolvedCount, kMaxRecords);
+        resolved[resolvedCount++] = nodeData;
+
+        if (onResolved)
+        {
+            onResolved(nodeData.operationalData.peerId);
+        }
+    }
+
+    void OnCachedNodeExpired(const PeerId & peerId) override
+    {
+        ASSERT_LT(expiredCount, kMaxRecords);
+        expired[expiredCount++] = peerId;
+    }
+
+    static constexpr size_t kMaxRecords = 4;
+
+    ResolvedNodeData resolved[kMaxRecords];
+    size_t resolvedCount = 0;
+    PeerId expired[kMaxRecords];
+    size_t expiredCount = 0;
+
+    // Called after recording every resolved node, to act on the queue from within Report.
+    std::function<void(const PeerId &)> onResolved;
+};
+
+ResolvedNodeData MakeNodeData(NodeId nodeId, uint16_t port, const char * hostName = "AABBCCDDEEFF0011")
+{
+    ResolvedNodeData nodeData;
+    nodeData.operationalData.peerId     = MakePeerId(nodeId);
+    nodeData.operationalData.hasZeroTTL = false;
+    nodeData.resolutionData.port        = port;
+    nodeData.resolutionData.numIPs      = 1;
+    EXPECT_TRUE(Inet::IPAddress::FromString("fe80::1", nodeData.resolutionData.ipAddress[0]));
+    Platform::CopyString(nodeData.resolutionData.hostName, hostName);
+    return nodeData;
+}
+
+TEST(TestOperationalRecordCache, TestHitMissAndExpiry)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalRecordCache<2> cache(&mockClock);
+    ResolvedNodeData nodeData;
+
+    mockClock.AdvanceMonotonic(1234_ms32);
+
+    EXPECT_FALSE(cache.Lookup(MakePeerId(1), nodeData));
+
+    cache.Insert(MakeNodeData(1, 5540), 120);
+    ASSERT_TRUE(cache.Lookup(MakePeerId(1), nodeData));
+    EXPECT_EQ(nodeData.operationalData.peerId, MakePeerId(1));
+    EXPECT_EQ(nodeData.resolutionData.port, 5540);
+    EXPECT_EQ(nodeData.resolutionData.numIPs, 1u);
+
+    // Still valid right up to the TTL
+    mockClock.AdvanceMonotonic(119999_ms32);
+    EXPECT_TRUE(cache.Lookup(MakePeerId(1), nodeData));
+
+    mockClock.AdvanceMonotonic(1_ms32);
+    EXPECT_FALSE(cache.Lookup(MakePeerId(1), nodeData));
+    EXPECT_FALSE(cache.Get(MakePeerId(1), nodeData));
+
+    EXPECT_EQ(cache.GetStatistics().hits, 2u);
+    EXPECT_EQ(cache.GetStatistics().misses, 2u);
+    EXPECT_EQ(cache.GetStatistics().evictions, 0u);
+}
+
+TEST(TestOperationalRecordCache, TestUpdateAndGoodbye)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalRecordCache<2> cache(&mockClock);
+    ResolvedNodeData nodeData;
+
+    cache.Insert(MakeNodeData(1, 5540), 10);
+
+    // Newer data replaces the old one and restarts its TTL
+    mockClock.AdvanceMonotonic(5_s);
+    cache.Insert(MakeNodeData(1, 5541), 10);
+    mockClock.AdvanceMonotonic(8_s);
+    ASSERT_TRUE(cache.Get(MakePeerId(1), nodeData));
+    EXPECT_EQ(nodeData.resolutionData.port, 5541);
+
+    // A zero TTL removes the node
+    cache.Insert(MakeNodeData(1, 5541), 0);
+    EXPECT_FALSE(cache.Get(MakePeerId(1), nodeData));
+
+    cache.Insert(MakeNodeData(2, 5540), 10);
+    cache.Remove(MakePeerId(2));
+    EXPECT_FALSE(cache.Get(MakePeerId(2), nodeData));
+
+    // Get does not count towards statistics
+    EXPECT_EQ(cache.GetStatistics().hits, 0u);
+    EXPECT_EQ(cache.GetStatistics().misses, 0u);
+}
+
+TEST(TestOperationalRecordCache, TestEviction)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalRecordCache<2> cache(&mockClock);
+    ResolvedNodeData nodeData;
+
+    cache.Insert(MakeNodeData(1, 5540), 100);
+    mockClock.AdvanceMonotonic(1_s);
+    cache.Insert(MakeNodeData(2, 5540), 100);
+    mockClock.AdvanceMonotonic(1_s);
+
+    // Node 1 becomes the most recently used one
+    EXPECT_TRUE(cache.Lookup(MakePeerId(1), nodeData));
+    mockClock.AdvanceMonotonic(1_s);
+
+    cache.Insert(MakeNodeData(3, 5540), 100);
+    EXPECT_TRUE(cache.Get(MakePeerId(1), nodeData));
+    EXPECT_FALSE(cache.Get(MakePeerId(2), nodeData));
+    EXPECT_TRUE(cache.Get(MakePeerId(3), nodeData));
+    EXPECT_EQ(cache.GetStatistics().evictions, 1u);
+
+    // Expired entries are reused before evicting anything
+    cache.Insert(MakeNodeData(4, 5540), 1);
+    mockClock.AdvanceMonotonic(2_s);
+    cache.Insert(MakeNodeData(5, 5540), 100);
+    EXPECT_TRUE(cache.Get(MakePeerId(5), nodeData));
+    EXPECT_FALSE(cache.Get(MakePeerId(4), nodeData));
+    EXPECT_EQ(cache.GetStatistics().evictions, 2u);
+}
+
+TEST(TestOperationalRecordCache, TestRemoveHost)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalRecordCache<4> cache(&mockClock);
+    ResolvedNodeData nodeData;
+
+    cache.Insert(MakeNodeData(1, 5540, "HOST1"), 100);
+    cache.Insert(MakeNodeData(2, 5540, "HOST2"), 100);
+    cache.Insert(MakeNodeData(3, 5541, "HOST1"), 100);
+
+    cache.RemoveHost("HOST1");
+    EXPECT_FALSE(cache.Get(MakePeerId(1), nodeData));
+    EXPECT_TRUE(cache.Get(MakePeerId(2), nodeData));
+    EXPECT_FALSE(cache.Get(MakePeerId(3), nodeData));
+
+    cache.Clear();
+    EXPECT_FALSE(cache.Get(MakePeerId(2), nodeData));
+}
+
+TEST(TestOperationalRecordCache, TestCachedResolves)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalRecordCache<4> cache(&mockClock);
+    CachedResolves<4> cachedResolves(cache);
+    RecordingCachedResolvesDelegate delegate;
+
+    cache.Insert(MakeNodeData(1, 5540), 10);
+    cache.Insert(MakeNodeData(2, 5541), 1);
+
+    // Only cached nodes are queued, once each
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(1)));
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(1)));
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(2)));
+    EXPECT_FALSE(cachedResolves.Add(MakePeerId(3)));
+    EXPECT_EQ(cache.GetStatistics().hits, 3u);
+    EXPECT_EQ(cache.GetStatistics().misses, 1u);
+
+    // Node 2 expires before the resolves are reported, e.g. from a zero-delay timer
+    mockClock.AdvanceMonotonic(1_s);
+    cachedResolves.Report(delegate);
+
+    ASSERT_EQ(delegate.resolvedCount, 1u);
+    EXPECT_EQ(delegate.resolved[0].operationalData.peerId, MakePeerId(1));
+    EXPECT_EQ(delegate.resolved[0].resolutionData.port, 5540);
+    ASSERT_EQ(delegate.expiredCount, 1u);
+    EXPECT_EQ(delegate.expired[0], MakePeerId(2));
+    EXPECT_TRUE(cachedResolves.IsEmpty());
+
+    // Nothing is reported twice
+    cachedResolves.Report(delegate);
+    EXPECT_EQ(delegate.resolvedCount, 1u);
+    EXPECT_EQ(delegate.expiredCount, 1u);
+}
+
+TEST(TestOperationalRecordCache, TestCachedResolvesRemoved)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalRecordCache<4> cache(&mockClock);
+    CachedResolves<2> cachedResolves(cache);
+    RecordingCachedResolvesDelegate delegate;
+
+    cache.Insert(MakeNodeData(1, 5540), 10);
+    cache.Insert(MakeNodeData(2, 5540), 10);
+    cache.Insert(MakeNodeData(3, 5540), 10);
+
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(1)));
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(2)));
+
+    // The queue is full
+    EXPECT_FALSE(cachedResolves.Add(MakePeerId(3)));
+
+    // A resolve no longer needed is not reported
+    cachedResolves.Remove(MakePeerId(1));
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(3)));
+
+    // A node removed from the cache (e.g. after failing to connect to it) is reported as expired
+    cache.Remove(MakePeerId(2));
+
+    cachedResolves.Report(delegate);
+    ASSERT_EQ(delegate.resolvedCount, 1u);
+    EXPECT_EQ(delegate.resolved[0].operationalData.peerId, MakePeerId(3));
+    ASSERT_EQ(delegate.expiredCount, 1u);
+    EXPECT_EQ(delegate.expired[0], MakePeerId(2));
+
+    // The delegate may cancel resolves that are still queued
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(1)));
+    EXPECT_TRUE(cachedResolves.Add(MakePeerId(3)));
+    delegate.onResolved = [&](const PeerId & peerId) { cachedResolves.Remove(MakePeerId(1)); };
+
+    cachedResolves.Report(delegate);
+    ASSERT_EQ(delegate.resolvedCount, 2u);
+    EXPECT_EQ(delegate.resolved[1].operationalData.peerId, MakePeerId(3));
+    EXPECT_EQ(delegate.expiredCount, 1u);
+    EXPECT_TRUE(cachedResolves.IsEmpty());
+}
+
+} // namespace
@@ -117,6 +117,11 @@ public:
     }
 
     static StorageKeyName SessionResumptionIndex() { return StorageKeyName::FromConst("g/sri"); }
+    static StorageKeyName SessionResumptionIndexPageCount() { return StorageKeyName::FromConst("g/sric"); }
+    static StorageKeyName SessionResumptionIndexPage(size_t page)
+    {
+        return StorageKeyName::Formatted("g/srip/%x", static_cast<unsigned>(page));
+    }
     static StorageKeyName SessionResumption(const char * resumptionIdBase64)
     {
         return StorageKeyName::Formatted("g/s/%s", resumptionIdBase64);
@@ -216,8 +216,9 @@ void HeapObjectList::CleanupDeferredReleases()
         HeapObjectListNode * next = p->mNext;
         if (p->mObject == nullptr)
         {
+            // The node starts the allocation that held its (already destroyed) object.
             p->Remove();
-            Platform::Delete(p);
+            Platform::MemoryFree(p);
         }
         p = next;
     }
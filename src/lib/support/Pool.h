@@ -29,9 +29,11 @@
 #include <lib/support/Iterators.h>
 
 #include <atomic>
+#include <cstddef>
 #include <limits>
 #include <new>
 #include <stddef.h>
+#include <type_traits>
 #include <utility>
 
 namespace chip {
@@ -141,6 +143,7 @@ private:
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
+// Each node is the start of the single heap allocation that also holds the object it tracks; see HeapObjectPool.
 struct HeapObjectListNode
 {
     void Remove()
@@ -362,6 +365,9 @@ private:
 /**
  * A class template used for allocating objects from the heap.
  *
+ *  Each object is allocated together with the list node that tracks it, so that creating an object takes a single
+ *  allocation and releasing it finds its node without searching the list of active objects.
+ *
  *  @tparam     T   type to be allocated.
  */
 template <class T>
@@ -482,19 +488,18 @@ public:
     template <typename... Args>
     T * CreateObject(Args &&... args)
     {
-        T * object = Platform::New<T>(std::forward<Args>(args)...);
-        if (object != nullptr)
+        void * memory = Platform::MemoryAlloc(sizeof(Block));
+        if (memory == nullptr)
         {
-            auto node = Platform::New<internal::HeapObjectListNode>();
-            if (node != nullptr)
-            {
-                node->mObject = object;
-                mObjects.Append(node);
-                IncreaseUsage();
-                return object;
-            }
+            return nullptr;
         }
-        return nullptr;
+
+        Block * block        = new (memory) Block;
+        T * object           = new (block->mStorage) T(std::forward<Args>(args)...);
+        block->mNode.mObject = object;
+        mObjects.Append(&block->mNode);
+        IncreaseUsage();
+        return object;
     }
 
     /*
@@ -513,20 +518,28 @@ public:
     {
         if (object != nullptr)
         {
-            internal::HeapObjectListNode * node = mObjects.FindNode(object);
             // Releasing an object that is not allocated indicates likely memory
             // corruption; better to safe-crash than proceed at this point.
-            VerifyOrDie(node != nullptr);
+#if CHIP_CONFIG_MEMORY_DEBUG_CHECKS
+            // The block of an object released outside of iteration is already freed, so
+            // only a scan of the live objects can tell that it is released again.
+            VerifyOrDie(mObjects.FindNode(object) != nullptr);
+#endif // CHIP_CONFIG_MEMORY_DEBUG_CHECKS
+            internal::HeapObjectListNode * node = &BlockOf(object)->mNode;
+            // The block of an object released during iteration is kept until the
+            // iteration completes, so releasing it again is always caught here.
+            VerifyOrDie(node->mObject == object);
 
             node->mObject = nullptr;
-            Platform::Delete(object);
+            object->~T();
 
-            // The node needs to be released immediately if we are not in the middle of iteration.
-            // Otherwise cleanup is deferred until all iteration on this pool completes and it's safe to release nodes.
+            // The node, and with it the memory of the object, needs to be released immediately if we are not in the middle
+            // of iteration. Otherwise cleanup is deferred until all iteration on this pool completes and it's safe to release
+            // nodes.
             if (mObjects.mIterationDepth == 0)
             {
                 node->Remove();
-                Platform::Delete(node);
+                Platform::MemoryFree(node);
             }
             else
             {
@@ -571,6 +584,20 @@ public:
     }
 
 private:
+    // The single allocation holding an object. The node comes first, so that the allocation can be freed through it.
+    struct Block
+    {
+        internal::HeapObjectListNode mNode;
+        alignas(T) uint8_t mStorage[sizeof(T)];
+    };
+    static_assert(std::is_standard_layout<Block>::value && offsetof(Block, mNode) == 0, "The node must start the block");
+    static_assert(alignof(Block) <= alignof(std::max_align_t), "Heap allocations are not aligned enough for the object");
+
+    static Block * BlockOf(T * object)
+    {
+        return reinterpret_cast<Block *>(reinterpret_cast<uint8_t *>(object) - offsetof(Block, mStorage));
+    }
+
     static Loop ReleaseObject(void * context, void * object)
     {
         static_cast<HeapObjectPool *>(context)->ReleaseObject(static_cast<T *>(object));
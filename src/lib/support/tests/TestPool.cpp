@@ -23,7 +23,9 @@
  *
  */
 
+#include <cstddef>
 #include <set>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -542,6 +544,73 @@ TEST_F(TestPool, TestPoolInterfaceDynamic)
 {
     TestPoolInterface<ObjectPoolMem::kHeap>();
 }
+
+TEST_F(TestPool, TestHeapReleaseInAnyOrder)
+{
+    struct alignas(std::max_align_t) S
+    {
+        S(size_t id, size_t & destroyed) : mId(id), mDestroyed(destroyed) {}
+        ~S() { ++mDestroyed; }
+        size_t mId;
+        size_t & mDestroyed;
+    };
+
+    constexpr size_t kSize = 10000;
+    size_t destroyed       = 0;
+    ObjectPool<S, kSize, ObjectPoolMem::kHeap> pool;
+
+    std::vector<S *> objs;
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        S * obj = pool.CreateObject(i, destroyed);
+        ASSERT_NE(obj, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(obj) % alignof(S), 0u);
+        objs.push_back(obj);
+    }
+    EXPECT_EQ(pool.Allocated(), kSize);
+
+    // Release every third object, walking the pool backwards, so that releases do not follow creation order.
+    for (size_t i = kSize; i-- > 0;)
+    {
+        if (i % 3 == 0)
+        {
+            pool.ReleaseObject(objs[i]);
+            objs[i] = nullptr;
+        }
+    }
+    const size_t released = (kSize + 2) / 3;
+    EXPECT_EQ(destroyed, released);
+    EXPECT_EQ(pool.Allocated(), kSize - released);
+    EXPECT_EQ(GetNumObjectsInUse(pool), kSize - released);
+
+    // Objects released while iterating are destroyed right away, and are not visited afterwards.
+    size_t visited = 0;
+    pool.ForEachActiveObject([&](S * object) {
+        EXPECT_NE(object->mId % 3, 0u);
+        ++visited;
+        if (object->mId % 3 == 1)
+        {
+            objs[object->mId] = nullptr;
+            pool.ReleaseObject(object);
+        }
+        return Loop::Continue;
+    });
+    EXPECT_EQ(visited, kSize - released);
+    EXPECT_EQ(destroyed, kSize - kSize / 3);
+    EXPECT_EQ(pool.Allocated(), kSize / 3);
+
+    for (S * obj : objs)
+    {
+        if (obj != nullptr)
+        {
+            EXPECT_EQ(obj->mId % 3, 2u);
+            pool.ReleaseObject(obj);
+        }
+    }
+    EXPECT_EQ(destroyed, kSize);
+    EXPECT_EQ(pool.Allocated(), 0u);
+    EXPECT_EQ(GetNumObjectsInUse(pool), 0u);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace
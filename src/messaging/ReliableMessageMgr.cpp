@@ -77,7 +77,7 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
+        ReleaseRetransEntry(entry);
         return Loop::Continue;
     });
 
@@ -122,62 +122,80 @@ void ReliableMessageMgr::ExecuteActions()
     });
 
     // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    // Take the due entries out of the wheel before handling any of them: handling an entry can release other
+    // entries, which then simply unlink themselves from dueEntries.
+    TimerWheelSlot dueEntries;
+    TakeDueRetransEntries(now, dueEntries);
+
+    while (!dueEntries.Empty())
+    {
+        RetransTableEntry * entry = &*dueEntries.begin();
+        dueEntries.Remove(entry);
+        mTimerWheelEntryCount--;
+        HandleRetransTimeout(entry);
+    }
+#else
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
+        if (entry->nextRetransTime <= now)
+        {
+            HandleRetransTimeout(entry);
+        }
+        return Loop::Continue;
+    });
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
 
-        VerifyOrDie(!entry->retainedBuf.IsNull());
+    TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
+}
 
-        uint8_t sendCount = entry->sendCount;
+void ReliableMessageMgr::HandleRetransTimeout(RetransTableEntry * entry)
+{
+    VerifyOrDie(!entry->retainedBuf.IsNull());
+
+    uint8_t sendCount = entry->sendCount;
 #if CHIP_ERROR_LOGGING || CHIP_DETAIL_LOGGING
-        uint32_t messageCounter = entry->retainedBuf.GetMessageCounter();
+    uint32_t messageCounter = entry->retainedBuf.GetMessageCounter();
 #endif // CHIP_ERROR_LOGGING || CHIP_DETAIL_LOGGING
 
-        if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
+    if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
+    {
+        // Make sure our exchange stays alive until we are done working with it.
+        ExchangeHandle ec(entry->ec);
+
+        ChipLogError(ExchangeManager,
+                     "Failed to Send CHIP MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
+                     " sendCount: %u max retries: %d",
+                     messageCounter, ChipLogValueExchange(&ec.Get()), sendCount, CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
+
+        // Don't check whether the session in the exchange is valid, because when the session is released, the retrans entry is
+        // cleared inside ExchangeContext::OnSessionReleased, so the session must be valid if the entry exists.
+        SessionHandle session = ec->GetSessionHandle();
+
+        // If the exchange is expecting a response, it will handle sending
+        // this notification once it detects that it has not gotten a
+        // response.  Otherwise, we need to do it.
+        if (!ec->IsResponseExpected())
         {
-            // Make sure our exchange stays alive until we are done working with it.
-            ExchangeHandle ec(entry->ec);
-
-            ChipLogError(ExchangeManager,
-                         "Failed to Send CHIP MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
-                         " sendCount: %u max retries: %d",
-                         messageCounter, ChipLogValueExchange(&ec.Get()), sendCount, CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
-
-            // Don't check whether the session in the exchange is valid, because when the session is released, the retrans entry is
-            // cleared inside ExchangeContext::OnSessionReleased, so the session must be valid if the entry exists.
-            SessionHandle session = ec->GetSessionHandle();
-
-            // If the exchange is expecting a response, it will handle sending
-            // this notification once it detects that it has not gotten a
-            // response.  Otherwise, we need to do it.
-            if (!ec->IsResponseExpected())
+            if (session->IsSecureSession() && session->AsSecureSession()->IsCASESession())
             {
-                if (session->IsSecureSession() && session->AsSecureSession()->IsCASESession())
-                {
-                    session->AsSecureSession()->MarkAsDefunct();
-                }
-                session->NotifySessionHang();
+                session->AsSecureSession()->MarkAsDefunct();
             }
-
-            // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
-
-            return Loop::Continue;
+            session->NotifySessionHang();
         }
 
-        entry->sendCount++;
-        ChipLogProgress(ExchangeManager,
-                        "Retransmitting MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
-                        " Send Cnt %d",
-                        messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
-
-        CalculateNextRetransTime(*entry);
-        SendFromRetransTable(entry);
+        // Do not StartTimer, we will schedule the timer at the end of the timer handler.
+        ReleaseRetransEntry(entry);
+        return;
+    }
 
-        return Loop::Continue;
-    });
+    entry->sendCount++;
+    ChipLogProgress(ExchangeManager,
+                    "Retransmitting MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
+                    " Send Cnt %d",
+                    messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
 
-    TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
+    CalculateNextRetransTime(*entry);
+    SendFromRetransTable(entry);
 }
 
 void ReliableMessageMgr::Timeout(System::Layer * aSystemLayer, void * aAppState)
@@ -208,6 +226,10 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
         return CHIP_ERROR_RETRANS_TABLE_FULL;
     }
 
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    mRetransTableIndex.Insert(*rEntry);
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+
     return CHIP_NO_ERROR;
 }
 
@@ -280,6 +302,19 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMessageCounter)
 {
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    RetransTableEntry * entry = mRetransTableIndex.Find(rc);
+    VerifyOrReturnValue(entry != nullptr && entry->retainedBuf.GetMessageCounter() == ackMessageCounter, false);
+
+    // Clear the entry from the retransmision table.
+    ClearRetransTable(*entry);
+
+    ChipLogDetail(ExchangeManager,
+                  "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
+                  " from Retrans Table on exchange " ChipLogFormatExchange,
+                  ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+    return true;
+#else
     bool removed = false;
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
@@ -298,6 +333,7 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     });
 
     return removed;
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
 }
 
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
@@ -356,6 +392,13 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    RetransTableEntry * entry = mRetransTableIndex.Find(rc);
+    if (entry != nullptr)
+    {
+        ClearRetransTable(*entry);
+    }
+#else
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc)
         {
@@ -364,11 +407,12 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
         }
         return Loop::Continue;
     });
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
 }
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransEntry(&entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
@@ -386,6 +430,9 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    nextWakeTime = std::min(nextWakeTime, GetNextRetransTime());
+#else
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->nextRetransTime < nextWakeTime)
         {
@@ -393,6 +440,7 @@ void ReliableMessageMgr::StartTimer()
         }
         return Loop::Continue;
     });
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
 
     StopTimer();
 
@@ -481,7 +529,175 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 
     System::Clock::Timeout backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime          = System::SystemClock().GetMonotonicTimestamp() + backoff;
+
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    ScheduleRetransEntry(entry);
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+}
+
+void ReliableMessageMgr::ReleaseRetransEntry(RetransTableEntry * entry)
+{
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    // The entry unlinks itself from the timer wheel (or from the due entries of ExecuteActions) when it is destroyed.
+    if (entry->IsInList())
+    {
+        mTimerWheelEntryCount--;
+    }
+    mRetransTableIndex.Remove(entry);
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    mRetransTable.ReleaseObject(entry);
+}
+
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+void ReliableMessageMgr::ScheduleRetransEntry(RetransTableEntry & entry)
+{
+    // Entries being rescheduled are in the wheel: ExecuteActions unlinks due entries before handling them.
+    if (entry.IsInList())
+    {
+        entry.Unlink();
+    }
+    else
+    {
+        mTimerWheelEntryCount++;
+    }
+
+    const uint64_t tick = TimerWheelTick(entry.nextRetransTime);
+
+    // Only a clock that went backwards can make this happen; keep the cursor at or before every scheduled entry.
+    if (tick < mTimerWheelCursor)
+    {
+        mTimerWheelCursor = tick;
+    }
+
+    mTimerWheel[tick % kTimerWheelSlots].PushBack(&entry);
+}
+
+void ReliableMessageMgr::TakeDueRetransEntries(System::Clock::Timestamp now, TimerWheelSlot & dueEntries)
+{
+    const uint64_t nowTick = TimerWheelTick(now);
+
+    // Nothing can be due before the cursor's tick has started.
+    VerifyOrReturn(nowTick >= mTimerWheelCursor);
+
+    // Visit the slots for every tick from the cursor up to now, or the whole wheel if we have fallen more than one
+    // turn behind.  Slots can also hold entries for later turns, so check each entry's time.
+    const uint64_t ticksToVisit = std::min<uint64_t>(nowTick - mTimerWheelCursor + 1, kTimerWheelSlots);
+    for (uint64_t i = 0; i < ticksToVisit; i++)
+    {
+        TimerWheelSlot & slot = mTimerWheel[(mTimerWheelCursor + i) % kTimerWheelSlots];
+        for (auto iter = slot.begin(); iter != slot.end();)
+        {
+            RetransTableEntry & entry = *iter;
+            ++iter;
+            if (entry.nextRetransTime <= now)
+            {
+                slot.Remove(&entry);
+                dueEntries.PushBack(&entry);
+            }
+        }
+    }
+
+    // Anything left is due after now, so no earlier than the current tick.
+    mTimerWheelCursor = nowTick;
+}
+
+System::Clock::Timestamp ReliableMessageMgr::GetNextRetransTime()
+{
+    System::Clock::Timestamp nextRetransTime = System::Clock::Timestamp::max();
+
+    VerifyOrReturnValue(mTimerWheelEntryCount > 0, nextRetransTime);
+
+    // Every scheduled entry is due at or after the cursor's tick, so the first tick from there that has an entry
+    // due within it holds the earliest entry.
+    for (uint64_t tick = mTimerWheelCursor; tick < mTimerWheelCursor + kTimerWheelSlots; tick++)
+    {
+        for (RetransTableEntry & entry : mTimerWheel[tick % kTimerWheelSlots])
+        {
+            if (TimerWheelTick(entry.nextRetransTime) == tick && entry.nextRetransTime < nextRetransTime)
+            {
+                nextRetransTime = entry.nextRetransTime;
+            }
+        }
+
+        if (nextRetransTime != System::Clock::Timestamp::max())
+        {
+            return nextRetransTime;
+        }
+    }
+
+    // Nothing is due within one turn of the wheel, so look at every scheduled entry.
+    for (TimerWheelSlot & slot : mTimerWheel)
+    {
+        for (RetransTableEntry & entry : slot)
+        {
+            nextRetransTime = std::min(nextRetransTime, entry.nextRetransTime);
+        }
+    }
+
+    return nextRetransTime;
+}
+
+size_t ReliableMessageMgr::RetransTableIndex::HomeSlot(const ReliableMessageContext * rc)
+{
+    // Fibonacci hashing spreads the pool-allocated, similarly aligned context addresses across the table.
+    const uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(rc)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>((hash >> 32) % kCapacity);
+}
+
+void ReliableMessageMgr::RetransTableIndex::Insert(RetransTableEntry * entry)
+{
+    const ReliableMessageContext * rc = entry->ec->GetReliableMessageContext();
+
+    // The table has room for twice as many entries as the retransmission table, so there is always a free slot.
+    size_t slot = HomeSlot(rc);
+    while (mSlots[slot].mEntry != nullptr)
+    {
+        slot = NextSlot(slot);
+    }
+
+    mSlots[slot].mContext = rc;
+    mSlots[slot].mEntry   = entry;
+}
+
+void ReliableMessageMgr::RetransTableIndex::Remove(RetransTableEntry * entry)
+{
+    size_t hole = HomeSlot(entry->ec->GetReliableMessageContext());
+    while (mSlots[hole].mEntry != entry)
+    {
+        VerifyOrReturn(mSlots[hole].mEntry != nullptr);
+        hole = NextSlot(hole);
+    }
+
+    mSlots[hole] = Slot();
+
+    // Shift later entries of the probe sequence back into the hole, unless that would move them ahead of their home
+    // slot, so that lookups can keep stopping at the first empty slot.
+    for (size_t slot = NextSlot(hole); mSlots[slot].mEntry != nullptr; slot = NextSlot(slot))
+    {
+        const size_t home = HomeSlot(mSlots[slot].mContext);
+        const bool canMove = (hole < slot) ? (home <= hole || home > slot) : (home <= hole && home > slot);
+        if (canMove)
+        {
+            mSlots[hole] = mSlots[slot];
+            mSlots[slot] = Slot();
+            hole         = slot;
+        }
+    }
+}
+
+ReliableMessageMgr::RetransTableEntry * ReliableMessageMgr::RetransTableIndex::Find(const ReliableMessageContext * rc) const
+{
+    for (size_t slot = HomeSlot(rc); mSlots[slot].mEntry != nullptr; slot = NextSlot(slot))
+    {
+        if (mSlots[slot].mContext == rc)
+        {
+            return mSlots[slot].mEntry;
+        }
+    }
+
+    return nullptr;
 }
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
 
 #if CHIP_CONFIG_TEST
 int ReliableMessageMgr::TestGetCountRetransTable()
@@ -29,6 +29,7 @@
 #include <lib/core/CHIPError.h>
 #include <lib/core/Optional.h>
 #include <lib/support/BitFlags.h>
+#include <lib/support/IntrusiveList.h>
 #include <lib/support/Pool.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
@@ -57,6 +58,10 @@ public:
      *
      */
     struct RetransTableEntry
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+        // Links the entry into the timer wheel slot for its nextRetransTime once it has been scheduled.
+        : public IntrusiveListNodeBase<IntrusiveMode::AutoUnlink>
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
     {
         RetransTableEntry(ReliableMessageContext * rc);
         ~RetransTableEntry();
@@ -230,6 +235,64 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
+    /**
+     * Retransmits an entry whose retransmission time has passed, or gives up on it and releases it
+     * if it has already been sent the maximum number of times.
+     */
+    void HandleRetransTimeout(RetransTableEntry * entry);
+
+    // Releases an entry without rearming the timer.
+    void ReleaseRetransEntry(RetransTableEntry * entry);
+
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    /**
+     * Open-addressed index of the retransmission table by exchange.  An exchange has at most one message
+     * waiting for an ack, so the exchange identifies its entry and the message counter only needs to be
+     * checked on the entry that is found.
+     */
+    class RetransTableIndex
+    {
+    public:
+        void Insert(RetransTableEntry * entry);
+        void Remove(RetransTableEntry * entry);
+        RetransTableEntry * Find(const ReliableMessageContext * rc) const;
+
+    private:
+        struct Slot
+        {
+            const ReliableMessageContext * mContext = nullptr;
+            RetransTableEntry * mEntry              = nullptr;
+        };
+
+        // Keep the load factor at or below one half so that probe sequences stay short.
+        static constexpr size_t kCapacity = 2 * CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE;
+
+        static size_t HomeSlot(const ReliableMessageContext * rc);
+        static size_t NextSlot(size_t slot) { return (slot + 1) % kCapacity; }
+
+        Slot mSlots[kCapacity];
+    };
+
+    using TimerWheelSlot = IntrusiveList<RetransTableEntry, IntrusiveMode::AutoUnlink>;
+
+    // Scheduled entries are hashed into the wheel by their nextRetransTime in units of kTimerWheelTick.  One turn
+    // of the wheel covers the retransmission intervals of active peers and of most sleepy peers; entries that are
+    // further out share slots with nearer ones and are skipped until their time comes.
+    static constexpr size_t kTimerWheelSlots                       = 256;
+    static constexpr System::Clock::Milliseconds64 kTimerWheelTick = System::Clock::Milliseconds64(64);
+
+    static uint64_t TimerWheelTick(System::Clock::Timestamp time) { return time.count() / kTimerWheelTick.count(); }
+
+    // (Re)links an entry into the wheel slot for its nextRetransTime.
+    void ScheduleRetransEntry(RetransTableEntry & entry);
+
+    // Moves all the entries whose nextRetransTime is at or before now from the wheel into dueEntries.
+    void TakeDueRetransEntries(System::Clock::Timestamp now, TimerWheelSlot & dueEntries);
+
+    // Returns the earliest nextRetransTime of any scheduled entry, or Timestamp::max() if there is none.
+    System::Clock::Timestamp GetNextRetransTime();
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
@@ -245,6 +308,16 @@ private:
 
     void TicklessDebugDumpRetransTable(const char * log);
 
+#if CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+    // Declared ahead of mRetransTable so that any entries left in the table unlink themselves before the wheel goes away.
+    TimerWheelSlot mTimerWheel[kTimerWheelSlots];
+    // Every scheduled entry is due at or after this wheel tick, so searches of the wheel can start from here.
+    uint64_t mTimerWheelCursor = 0;
+    // Entries linked into the wheel, plus those ExecuteActions has taken out of it and not handled yet.
+    size_t mTimerWheelEntryCount = 0;
+    RetransTableIndex mRetransTableIndex;
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
@@ -149,6 +149,22 @@ namespace chip {
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 #endif // CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE
 
+/**
+ *  @def CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+ *
+ *  @brief
+ *    If true, the ReliableMessageProtocol retransmission table is indexed by
+ *    exchange, so that received acks are matched without walking the table,
+ *    and pending retransmissions are kept in a hashed timing wheel, so that
+ *    timer handling only looks at the entries that are due.
+ *
+ *  This costs a few kilobytes of RAM and is meant for controllers that keep
+ *  many exchanges in flight, for example to sleepy devices.
+ */
+#ifndef CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+#define CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX 0
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+
 /**
  *  @def CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS
  *
@@ -358,6 +358,45 @@ TEST_F(TestReliableMessageProtocol, CheckAddClearRetrans)
     exchange->Close();
 }
 
+TEST_F(TestReliableMessageProtocol, CheckClearRetransForMultipleExchanges)
+{
+    MockAppDelegate mockAppDelegate(*this);
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    constexpr size_t kExchangeCount = 4;
+    ExchangeContext * exchanges[kExchangeCount];
+    for (auto & exchange : exchanges)
+    {
+        exchange = NewExchangeToAlice(&mockAppDelegate);
+        ASSERT_NE(exchange, nullptr);
+
+        ReliableMessageMgr::RetransTableEntry * entry;
+        EXPECT_EQ(rm->AddToRetransTable(exchange->GetReliableMessageContext(), &entry), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(kExchangeCount));
+
+    // Clearing an exchange must only remove its own entry, whatever order the exchanges are cleared in.
+    const size_t clearOrder[kExchangeCount] = { 1, 3, 0, 2 };
+    for (size_t i = 0; i < kExchangeCount; i++)
+    {
+        ReliableMessageContext * rc = exchanges[clearOrder[i]]->GetReliableMessageContext();
+        EXPECT_TRUE(rc->IsWaitingForAck());
+        rm->ClearRetransTable(rc);
+        EXPECT_FALSE(rc->IsWaitingForAck());
+        EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(kExchangeCount - i - 1));
+
+        // Clearing it again is a no-op.
+        rm->ClearRetransTable(rc);
+        EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(kExchangeCount - i - 1));
+    }
+
+    for (auto & exchange : exchanges)
+    {
+        exchange->Close();
+    }
+}
+
 /**
  * Tests MRP retransmission logic with the following scenario:
  *
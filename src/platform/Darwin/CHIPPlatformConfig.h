@@ -65,6 +65,34 @@ extern "C" int __cxa_atexit(void (*f)(void *), void * p, void * d);
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+#define CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX 1
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_CACHE
+#define CHIP_CONFIG_ACCESS_CONTROL_CACHE 1
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CACHE
+
+#ifndef CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+#define CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE 1
+#endif // CHIP_CONFIG_CLUSTER_STATE_CACHE_FLAT_STORAGE
+
+#ifndef CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+#define CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX 1
+#endif // CHIP_CONFIG_RMP_RETRANS_TABLE_INDEX
+
+#ifndef CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+#define CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX 1
+#endif // CHIP_CONFIG_IM_REPORTING_INTEREST_INDEX
+
+#ifndef CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+#define CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE 2048
+#endif // CHIP_CONFIG_IM_REPORT_ENCODING_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE 16
+#endif // CHIP_CONFIG_EVENT_LOGGING_NUMBER_INDEX_SIZE
+
 #ifndef CHIP_CONFIG_KVS_PATH
 #define CHIP_CONFIG_KVS_PATH "/tmp/chip_kvs"
 #endif // CHIP_CONFIG_KVS_PATH
@@ -28,26 +28,107 @@ namespace chip {
 namespace DeviceLayer {
 namespace Internal {
 
-void DeviceSafeQueue::Push(const ChipDeviceEvent & event)
+DeviceSafeQueue::DeviceSafeQueue()
 {
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
-    mEventQueue.push(event);
+    for (size_t i = 0; i < kRingSize; i++)
+    {
+        mRing[i].mSequence.store(i, std::memory_order_relaxed);
+    }
 }
 
-bool DeviceSafeQueue::Empty()
+bool DeviceSafeQueue::Push(const ChipDeviceEvent & event)
 {
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
-    return mEventQueue.empty();
+    if (mOverflowCount.load(std::memory_order_acquire) != 0 || !PushToRing(event))
+    {
+        std::unique_lock<std::mutex> lock(mOverflowQueueLock);
+        mOverflowQueue.push(event);
+        mOverflowCount.fetch_add(1, std::memory_order_release);
+    }
+
+    // Publish the event before checking for a pending wake-up: the event loop clears it before popping.
+    return !mWakePending.exchange(true, std::memory_order_acq_rel);
+}
+
+void DeviceSafeQueue::PrepareToPop()
+{
+    mWakePending.exchange(false, std::memory_order_acq_rel);
+}
+
+bool DeviceSafeQueue::PopFront(ChipDeviceEvent & event)
+{
+    if (PopFromRing(event))
+    {
+        return true;
+    }
+
+    // Only pop overflowed events once every event that went to the ring has been popped, since a thread may have pushed
+    // some of its events to the ring before it pushed others to the overflow queue.
+    if (mPushPosition.load(std::memory_order_acquire) != mPopPosition || mOverflowCount.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mOverflowQueueLock);
+    event = mOverflowQueue.front();
+    mOverflowQueue.pop();
+    mOverflowCount.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool DeviceSafeQueue::Empty() const
+{
+    const Slot & slot = mRing[mPopPosition % kRingSize];
+    return slot.mSequence.load(std::memory_order_acquire) != mPopPosition + 1 &&
+        mOverflowCount.load(std::memory_order_acquire) == 0;
+}
+
+bool DeviceSafeQueue::PushToRing(const ChipDeviceEvent & event)
+{
+    size_t position = mPushPosition.load(std::memory_order_relaxed);
+    Slot * slot;
+
+    while (true)
+    {
+        slot                  = &mRing[position % kRingSize];
+        const size_t sequence = slot->mSequence.load(std::memory_order_acquire);
+        const auto distance   = static_cast<intptr_t>(sequence - position);
+
+        if (distance == 0)
+        {
+            // The slot is free; claim it unless another producer got there first.
+            if (mPushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (distance < 0)
+        {
+            // The slot still holds the event pushed one turn of the ring ago: the ring is full.
+            return false;
+        }
+        else
+        {
+            position = mPushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->mEvent = event;
+    slot->mSequence.store(position + 1, std::memory_order_release);
+    return true;
 }
 
-ChipDeviceEvent DeviceSafeQueue::PopFront()
+bool DeviceSafeQueue::PopFromRing(ChipDeviceEvent & event)
 {
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
+    Slot & slot = mRing[mPopPosition % kRingSize];
 
-    const ChipDeviceEvent event = mEventQueue.front();
-    mEventQueue.pop();
+    // The slot may also have been claimed by a producer that has not finished writing it yet; its event is popped on a later
+    // call, once the producer's push has woken the event loop up again.
+    VerifyOrReturnValue(slot.mSequence.load(std::memory_order_acquire) == mPopPosition + 1, false);
 
-    return event;
+    event = slot.mEvent;
+    slot.mSequence.store(mPopPosition + kRingSize, std::memory_order_release);
+    mPopPosition++;
+    return true;
 }
 
 } // namespace Internal
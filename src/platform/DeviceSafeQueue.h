@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <queue>
 
@@ -39,24 +40,73 @@ namespace Internal {
  *  @class DeviceSafeQueue
  *
  *  @brief
- *      This class represents a thread-safe message queue implemented with C++ Standard Library, the message queue
- *      is used by the CHIP event loop to hold incoming messages. Each message is sequentially dequeued, decoded,
- *      and then an action is performed.
+ *      This class represents a thread-safe message queue, the message queue is used by the CHIP event loop to hold
+ *      incoming messages. Each message is sequentially dequeued, decoded, and then an action is performed.
  *
+ *      Events can be pushed from any number of threads, but must be popped by a single thread, the CHIP event loop.
+ *      Pushes go to a lock-free ring of CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE events, so that threads posting work
+ *      do not contend on a lock.  When the ring is full, events go to an unbounded overflow queue guarded by a mutex
+ *      instead, until the event loop has emptied it; each thread's events are popped in the order it pushed them.
+ *
+ *      Push() also coalesces the wake-ups of the event loop: once a push has asked for the event loop to be woken up,
+ *      further pushes do not until the event loop calls PrepareToPop().
  */
 class DeviceSafeQueue
 {
 public:
-    DeviceSafeQueue()  = default;
+    DeviceSafeQueue();
     ~DeviceSafeQueue() = default;
 
-    void Push(const ChipDeviceEvent & event);
-    bool Empty();
-    ChipDeviceEvent PopFront();
+    /**
+     * Push an event, from any thread.
+     *
+     * @return true if the caller must wake up the event loop to pop the event, false if a wake-up is already pending.
+     */
+    bool Push(const ChipDeviceEvent & event);
+
+    /**
+     * Called by the event loop before popping events, so that events pushed from then on wake it up again.
+     */
+    void PrepareToPop();
+
+    /**
+     * Pop the oldest event, from the event loop only.
+     *
+     * @return false if the queue is empty.
+     */
+    bool PopFront(ChipDeviceEvent & event);
+
+    /// Determine, from the event loop only, whether the queue is empty.
+    bool Empty() const;
 
 private:
-    std::queue<ChipDeviceEvent> mEventQueue;
-    std::mutex mEventQueueLock;
+    static constexpr size_t kRingSize = CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE;
+    static_assert(kRingSize > 0, "The event queue needs room for at least one event");
+
+    // A slot of the ring.  A slot at position pos (modulo kRingSize) can be written when its sequence is pos, and
+    // read when its sequence is pos + 1; reading it makes it writable again at position pos + kRingSize.
+    struct Slot
+    {
+        std::atomic<size_t> mSequence;
+        ChipDeviceEvent mEvent;
+    };
+
+    bool PushToRing(const ChipDeviceEvent & event);
+    bool PopFromRing(ChipDeviceEvent & event);
+
+    Slot mRing[kRingSize];
+
+    // Keep the position producers contend on apart from the state of the consumer.
+    alignas(64) std::atomic<size_t> mPushPosition{ 0 };
+    alignas(64) size_t mPopPosition = 0;
+
+    std::atomic<bool> mWakePending{ false };
+
+    // Overflow queue used while the ring is full.  While it holds events, all pushes go to it, so that no thread's
+    // later events can overtake its earlier ones by going to the ring.
+    std::atomic<size_t> mOverflowCount{ 0 };
+    std::queue<ChipDeviceEvent> mOverflowQueue;
+    std::mutex mOverflowQueueLock;
 
     DeviceSafeQueue(const DeviceSafeQueue &)             = delete;
     DeviceSafeQueue & operator=(const DeviceSafeQueue &) = delete;
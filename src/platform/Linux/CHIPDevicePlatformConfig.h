@@ -54,8 +54,50 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+ *
+ * When enabled, KeyValueStoreManager keeps its contents in an append-only journal
+ * (see ChipLinuxStorageJournal) instead of rewriting the whole INI file on every write.
+ * An existing INI file is migrated to the journal format the first time it is opened.
+ * The migration is one-way: builds without this option cannot read the journal format,
+ * so it is disabled by default.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_{CRIT,INFO,DEBUG}_BUFFER_SIZE
+ *
+ * Sizes, in bytes, of the event buffers kept in a memory-mapped event log file
+ * (see ChipLinuxEventLogStorage), used instead of the statically allocated buffers
+ * when the application is given an event log file.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_CRIT_BUFFER_SIZE
+#define CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_CRIT_BUFFER_SIZE (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_CRIT_BUFFER_SIZE
+
+#ifndef CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_INFO_BUFFER_SIZE
+#define CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_INFO_BUFFER_SIZE (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_INFO_BUFFER_SIZE
+
+#ifndef CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_DEBUG_BUFFER_SIZE
+#define CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_DEBUG_BUFFER_SIZE (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_EVENT_LOG_FILE_DEBUG_BUFFER_SIZE
+
 // ========== Platform-specific Configuration Overrides =========
 
+// When background event processing is enabled, e.g. on controllers establishing many CASE sessions
+// at once, background work is spread over a pool of threads.
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 4
+#endif // CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+
+#ifndef CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
+#define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 64
+#endif // CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
+
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
 #define CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE 8192
 #endif // CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
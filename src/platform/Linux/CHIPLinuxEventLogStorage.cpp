@@ -0,0 +1,184 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Implements the memory-mapped file storage for the event log buffers
+ *          on Linux.
+ *
+ *          The file starts with a 64 byte header, all integers being in host
+ *          byte order:
+ *
+ *              magic        (8 bytes)
+ *              bufferCount  (4 bytes)
+ *              bufferSizes  (4 bytes each, kMaxBuffers entries)
+ *              padding      (up to offset 32)
+ *              states       (8 bytes each, kMaxBuffers entries)
+ *
+ *          followed by the buffers, each starting on an 8 byte boundary.  The
+ *          magic is written last when the file is created, so a file whose
+ *          creation was interrupted is recreated on the next Init.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/CHIPLinuxEventLogStorage.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr char kEventLogMagic[] = { 'C', 'H', 'I', 'P', 'E', 'V', 'L', '1' };
+
+constexpr size_t kBufferCountOffset = sizeof(kEventLogMagic);
+constexpr size_t kBufferSizesOffset = kBufferCountOffset + sizeof(uint32_t);
+constexpr size_t kStatesOffset      = 32;
+constexpr size_t kHeaderSize        = kStatesOffset + ChipLinuxEventLogStorage::kMaxBuffers * sizeof(uint64_t);
+
+static_assert(kBufferSizesOffset + ChipLinuxEventLogStorage::kMaxBuffers * sizeof(uint32_t) <= kStatesOffset,
+              "Buffer sizes overlap the states");
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && std::atomic<uint64_t>::is_always_lock_free,
+              "States must be plain lock-free words to be shared through the file");
+
+size_t AlignUp(size_t value)
+{
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+} // namespace
+
+ChipLinuxEventLogStorage::~ChipLinuxEventLogStorage()
+{
+    Shutdown();
+}
+
+CHIP_ERROR ChipLinuxEventLogStorage::Init(const char * eventLogFile, const uint32_t * bufferSizes, size_t bufferCount)
+{
+    ChipLogDetail(DeviceLayer, "ChipLinuxEventLogStorage::Init: Using event log file: %s", StringOrNullMarker(eventLogFile));
+    VerifyOrReturnError(eventLogFile != nullptr && bufferSizes != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(bufferCount > 0 && bufferCount <= kMaxBuffers, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mFd == -1, CHIP_ERROR_INCORRECT_STATE);
+
+    size_t size = kHeaderSize;
+    for (size_t i = 0; i < bufferCount; i++)
+    {
+        VerifyOrReturnError(bufferSizes[i] > 0, CHIP_ERROR_INVALID_ARGUMENT);
+        mBufferSizes[i]   = bufferSizes[i];
+        mBufferOffsets[i] = size;
+        size              = AlignUp(size + bufferSizes[i]);
+    }
+    mBufferCount = bufferCount;
+
+    int fd = open(eventLogFile, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    VerifyOrReturnError(fd != -1, CHIP_ERROR_POSIX(errno));
+
+    struct stat st;
+    bool reset = (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != size);
+    if (reset && (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0))
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        close(fd);
+        return err;
+    }
+
+    void * mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        close(fd);
+        return err;
+    }
+
+    mFd          = fd;
+    mMapping     = static_cast<uint8_t *>(mapping);
+    mMappingSize = size;
+
+    uint32_t storedCount;
+    memcpy(&storedCount, mMapping + kBufferCountOffset, sizeof(storedCount));
+    reset = reset || memcmp(mMapping, kEventLogMagic, sizeof(kEventLogMagic)) != 0 || storedCount != bufferCount ||
+        memcmp(mMapping + kBufferSizesOffset, bufferSizes, bufferCount * sizeof(uint32_t)) != 0;
+
+    if (reset)
+    {
+        ChipLogProgress(DeviceLayer, "ChipLinuxEventLogStorage::Init: Creating a new event log");
+        memset(mMapping, 0, kHeaderSize);
+        const uint32_t count = static_cast<uint32_t>(bufferCount);
+        memcpy(mMapping + kBufferCountOffset, &count, sizeof(count));
+        memcpy(mMapping + kBufferSizesOffset, bufferSizes, bufferCount * sizeof(uint32_t));
+        VerifyOrReturnError(msync(mMapping, kHeaderSize, MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+        memcpy(mMapping, kEventLogMagic, sizeof(kEventLogMagic));
+        VerifyOrReturnError(msync(mMapping, kHeaderSize, MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxEventLogStorage::Shutdown()
+{
+    if (mMapping != nullptr)
+    {
+        msync(mMapping, mMappingSize, MS_SYNC);
+        munmap(mMapping, mMappingSize);
+        mMapping     = nullptr;
+        mMappingSize = 0;
+    }
+    if (mFd != -1)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+    mBufferCount = 0;
+}
+
+CHIP_ERROR ChipLinuxEventLogStorage::Sync()
+{
+    VerifyOrReturnError(mMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(msync(mMapping, mMappingSize, MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+    return CHIP_NO_ERROR;
+}
+
+uint8_t * ChipLinuxEventLogStorage::GetBuffer(size_t index) const
+{
+    VerifyOrReturnValue(index < mBufferCount, nullptr);
+    return mMapping + mBufferOffsets[index];
+}
+
+uint32_t ChipLinuxEventLogStorage::GetBufferSize(size_t index) const
+{
+    VerifyOrReturnValue(index < mBufferCount, 0);
+    return mBufferSizes[index];
+}
+
+std::atomic<uint64_t> * ChipLinuxEventLogStorage::GetBufferState(size_t index) const
+{
+    VerifyOrReturnValue(index < mBufferCount, nullptr);
+    return reinterpret_cast<std::atomic<uint64_t> *>(mMapping + kStatesOffset + index * sizeof(uint64_t));
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,84 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides memory-mapped file storage for the event log buffers on
+ *          Linux.
+ *
+ *          The buffers handed to EventManagement live in a file mapped with
+ *          MAP_SHARED, next to one state word per buffer recording where its
+ *          events are (see app::PersistedEventBufferState).  Events therefore
+ *          survive a restart of the process without being serialized, and the
+ *          buffers can be much larger than the statically allocated ones
+ *          without growing the heap.
+ *
+ *          The state words only ever describe complete events, so a crash of
+ *          the process at any point leaves a consistent log.  The kernel writes
+ *          the mapping back to the file on its own; Sync() forces it, e.g.
+ *          before a planned power off.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxEventLogStorage
+{
+public:
+    static constexpr size_t kMaxBuffers = 4;
+
+    ChipLinuxEventLogStorage() = default;
+    ~ChipLinuxEventLogStorage();
+
+    /**
+     * Maps the event log file, creating it if needed.  The events it holds are
+     * kept if it was created with the same buffer sizes, and discarded
+     * otherwise.
+     */
+    CHIP_ERROR Init(const char * eventLogFile, const uint32_t * bufferSizes, size_t bufferCount);
+    void Shutdown();
+
+    /**
+     * Writes the mapping back to the file and waits for completion.
+     */
+    CHIP_ERROR Sync();
+
+    uint8_t * GetBuffer(size_t index) const;
+    uint32_t GetBufferSize(size_t index) const;
+    std::atomic<uint64_t> * GetBufferState(size_t index) const;
+
+private:
+    int mFd             = -1;
+    uint8_t * mMapping  = nullptr;
+    size_t mMappingSize = 0;
+    size_t mBufferCount = 0;
+    uint32_t mBufferSizes[kMaxBuffers];
+    size_t mBufferOffsets[kMaxBuffers];
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
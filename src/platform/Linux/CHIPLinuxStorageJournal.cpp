@@ -0,0 +1,478 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Implements the append-only, log-structured key-value store used as the
+ *          KeyValueStoreManager backend on Linux.
+ *
+ *          The journal file starts with an 8 byte magic followed by a sequence of
+ *          records, all integers being little-endian:
+ *
+ *              crc32     (4 bytes, covers every following byte of the record)
+ *              type      (1 byte, put or delete)
+ *              keyLen    (2 bytes)
+ *              valueLen  (4 bytes, 0 for delete)
+ *              key       (keyLen bytes)
+ *              value     (valueLen bytes)
+ */
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <string.h>
+#include <unistd.h>
+
+#include <inipp/inipp.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/IniEscaping.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/CHIPLinuxStorageJournal.h>
+#include <system/SystemError.h>
+
+using namespace chip::IniEscaping;
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr char kJournalMagic[]     = { 'C', 'H', 'I', 'P', 'K', 'V', 'J', '1' };
+constexpr size_t kRecordHeaderSize = 4 + 1 + 2 + 4;
+
+constexpr uint8_t kRecordTypePut    = 1;
+constexpr uint8_t kRecordTypeDelete = 2;
+
+uint32_t Crc32(const uint8_t * data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+size_t RecordSize(size_t keyLen, size_t valueLen)
+{
+    return kRecordHeaderSize + keyLen + valueLen;
+}
+
+void EncodeRecord(std::string & out, uint8_t type, const std::string & key, const void * value, size_t valueSize)
+{
+    const size_t start = out.size();
+
+    out.resize(start + kRecordHeaderSize);
+    out.append(key);
+    if (valueSize > 0)
+    {
+        out.append(static_cast<const char *>(value), valueSize);
+    }
+
+    uint8_t * record = reinterpret_cast<uint8_t *>(&out[start]);
+    record[4]        = type;
+    Encoding::LittleEndian::Put16(&record[5], static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(&record[7], static_cast<uint32_t>(valueSize));
+    Encoding::LittleEndian::Put32(&record[0], Crc32(&record[4], out.size() - start - 4));
+}
+
+CHIP_ERROR WriteAll(int fd, const std::string & data)
+{
+    size_t written = 0;
+
+    while (written < data.size())
+    {
+        ssize_t rc = write(fd, data.data() + written, data.size() - written);
+        if (rc < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        written += static_cast<size_t>(rc);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+ChipLinuxStorageJournal::~ChipLinuxStorageJournal()
+{
+    Shutdown();
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Init(const char * journalFile)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageJournal::Init: Using KVS journal file: %s", StringOrNullMarker(journalFile));
+    VerifyOrReturnError(journalFile != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    if (mFd != -1)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageJournal::Init: Attempt to re-initialize with KVS journal file: %s", journalFile);
+        return CHIP_NO_ERROR;
+    }
+
+    mJournalPath.assign(journalFile);
+    mEntries.clear();
+
+    std::string contents;
+    std::ifstream ifs(mJournalPath, std::ifstream::in | std::ifstream::binary);
+    if (ifs.is_open())
+    {
+        contents.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        ifs.close();
+    }
+
+    if (contents.empty())
+    {
+        // Create an empty journal if none exists yet.
+        mLiveSize = sizeof(kJournalMagic);
+        return WriteSnapshot();
+    }
+    if (contents.compare(0, sizeof(kJournalMagic), kJournalMagic, sizeof(kJournalMagic)) == 0)
+    {
+        ReturnErrorOnFailure(LoadJournal(contents));
+    }
+    else
+    {
+        return MigrateIniFile();
+    }
+
+    return OpenForAppend();
+}
+
+void ChipLinuxStorageJournal::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    if (mFd != -1)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+    mEntries.clear();
+    mJournalSize = 0;
+    mLiveSize    = 0;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::LoadJournal(const std::string & contents)
+{
+    const uint8_t * data = reinterpret_cast<const uint8_t *>(contents.data());
+    size_t offset        = sizeof(kJournalMagic);
+
+    mLiveSize = sizeof(kJournalMagic);
+
+    while (contents.size() - offset >= kRecordHeaderSize)
+    {
+        const uint8_t * record = data + offset;
+        const uint8_t type     = record[4];
+        const size_t keyLen    = Encoding::LittleEndian::Get16(&record[5]);
+        const size_t valueLen  = Encoding::LittleEndian::Get32(&record[7]);
+
+        if (contents.size() - offset - kRecordHeaderSize < keyLen + valueLen)
+        {
+            break;
+        }
+        if (Encoding::LittleEndian::Get32(&record[0]) != Crc32(&record[4], RecordSize(keyLen, valueLen) - 4))
+        {
+            break;
+        }
+
+        if (type != kRecordTypePut && type != kRecordTypeDelete)
+        {
+            break;
+        }
+
+        std::string key(contents, offset + kRecordHeaderSize, keyLen);
+        auto it = mEntries.find(key);
+        if (it != mEntries.end())
+        {
+            mLiveSize -= RecordSize(key.size(), it->second.size());
+        }
+
+        if (type == kRecordTypePut)
+        {
+            std::string & value = mEntries[key];
+            value.assign(contents, offset + kRecordHeaderSize + keyLen, valueLen);
+            mLiveSize += RecordSize(keyLen, valueLen);
+        }
+        else if (it != mEntries.end())
+        {
+            mEntries.erase(it);
+        }
+
+        offset += RecordSize(keyLen, valueLen);
+    }
+
+    mJournalSize = offset;
+
+    if (offset != contents.size())
+    {
+        // Most likely a write interrupted by a crash or power loss; everything
+        // up to the last complete record is still valid.
+        ChipLogError(DeviceLayer, "Discarding %u bytes of incomplete records at the end of KVS journal (%s)",
+                     static_cast<unsigned>(contents.size() - offset), mJournalPath.c_str());
+        if (truncate(mJournalPath.c_str(), static_cast<off_t>(offset)) != 0)
+        {
+            ChipLogError(DeviceLayer, "failed to truncate (%s), %s (%d)", mJournalPath.c_str(), strerror(errno), errno);
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::MigrateIniFile()
+{
+    inipp::Ini<char> ini;
+    std::ifstream ifs;
+
+    ifs.open(mJournalPath, std::ifstream::in);
+    VerifyOrReturnError(ifs.is_open(), CHIP_ERROR_OPEN_FAILED);
+    ini.parse(ifs);
+    ifs.close();
+
+    mLiveSize = sizeof(kJournalMagic);
+
+    for (const auto & entry : ini.sections["DEFAULT"])
+    {
+        std::string key = UnescapeKey(entry.first);
+        if (key.empty())
+        {
+            ChipLogError(DeviceLayer, "Skipping invalid key (%s) while migrating KVS file", entry.first.c_str());
+            continue;
+        }
+
+        std::string & value = mEntries[key];
+        value               = Base64ToString(entry.second);
+        mLiveSize += RecordSize(key.size(), value.size());
+    }
+
+    ChipLogProgress(DeviceLayer, "Migrating %u entries of KVS file (%s) to journal format", static_cast<unsigned>(mEntries.size()),
+                    mJournalPath.c_str());
+
+    return WriteSnapshot();
+}
+
+// Updating a file atomically and durably on Linux requires:
+// 1. Writing to a temporary file
+// 2. Sync'ing the temp file to commit updated data
+// 3. Using rename() to overwrite the existing file
+//
+// The temporary file is opened for appending, and once renamed it becomes the
+// journal that later records are appended to.  Nothing has to be reopened
+// after the rename, so the journal can never be left without a file to
+// append to.  On failure the current journal stays in use.
+CHIP_ERROR ChipLinuxStorageJournal::WriteSnapshot()
+{
+    CHIP_ERROR err      = CHIP_NO_ERROR;
+    std::string tmpPath = mJournalPath + "-XXXXXX";
+    std::string snapshot(kJournalMagic, sizeof(kJournalMagic));
+
+    snapshot.reserve(mLiveSize);
+    for (const auto & entry : mEntries)
+    {
+        EncodeRecord(snapshot, kRecordTypePut, entry.first, entry.second.data(), entry.second.size());
+    }
+
+    int fd = mkostemp(&tmpPath[0], O_APPEND | O_CLOEXEC);
+    if (fd == -1)
+    {
+        ChipLogError(DeviceLayer, "failed to open file (%s) for writing, %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    err = WriteAll(fd, snapshot);
+    if (err == CHIP_NO_ERROR && fsync(fd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+
+    if (err == CHIP_NO_ERROR && rename(tmpPath.c_str(), mJournalPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "failed to write KVS journal snapshot: %" CHIP_ERROR_FORMAT, err.Format());
+        close(fd);
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    if (mFd != -1)
+    {
+        close(mFd);
+    }
+    mFd          = fd;
+    mJournalSize = snapshot.size();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::OpenForAppend()
+{
+    VerifyOrReturnError(mFd == -1, CHIP_ERROR_INCORRECT_STATE);
+
+    mFd = open(mJournalPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (mFd == -1)
+    {
+        ChipLogError(DeviceLayer, "failed to open file (%s) for appending, %s (%d)", mJournalPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::AppendRecord(uint8_t type, const std::string & key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    std::string record;
+    EncodeRecord(record, type, key, value, valueSize);
+
+    CHIP_ERROR err = WriteAll(mFd, record);
+    if (err == CHIP_NO_ERROR && fdatasync(mFd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Drop whatever part of the record made it to the file, so that later
+        // records are not appended after a torn one.
+        ChipLogError(DeviceLayer, "failed to append to KVS journal (%s): %" CHIP_ERROR_FORMAT, mJournalPath.c_str(), err.Format());
+        if (ftruncate(mFd, static_cast<off_t>(mJournalSize)) != 0)
+        {
+            ChipLogError(DeviceLayer, "failed to truncate (%s), %s (%d)", mJournalPath.c_str(), strerror(errno), errno);
+        }
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+
+    mJournalSize += record.size();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr && value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    VerifyOrReturnError(offset <= it->second.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t totalSizeToRead = it->second.size() - offset;
+    size_t copySize        = std::min(valueSize, totalSizeToRead);
+    if (readBytesSize != nullptr)
+    {
+        *readBytesSize = copySize;
+    }
+    ::memcpy(value, it->second.data() + offset, copySize);
+
+    return (valueSize < totalSizeToRead) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Put(const char * key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key != nullptr && (value != nullptr || valueSize == 0), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(CanCastTo<uint32_t>(valueSize), CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::string keyString(key);
+    VerifyOrReturnError(keyString.size() <= kMaxKeyLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::string valueString;
+    if (valueSize > 0)
+    {
+        valueString.assign(static_cast<const char *>(value), valueSize);
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ReturnErrorOnFailure(AppendRecord(kRecordTypePut, keyString, valueString.data(), valueString.size()));
+
+    auto it = mEntries.find(keyString);
+    if (it != mEntries.end())
+    {
+        mLiveSize -= RecordSize(keyString.size(), it->second.size());
+        it->second = std::move(valueString);
+    }
+    else
+    {
+        mEntries.emplace(std::move(keyString), std::move(valueString));
+    }
+    mLiveSize += RecordSize(strlen(key), valueSize);
+
+    CompactIfNeeded();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    ReturnErrorOnFailure(AppendRecord(kRecordTypeDelete, it->first, nullptr, 0));
+
+    mLiveSize -= RecordSize(it->first.size(), it->second.size());
+    mEntries.erase(it);
+
+    CompactIfNeeded();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Compact()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+    return WriteSnapshot();
+}
+
+void ChipLinuxStorageJournal::CompactIfNeeded()
+{
+    VerifyOrReturn(mJournalSize >= kCompactionMinSize && mJournalSize >= kCompactionRatio * mLiveSize);
+
+    // A failed compaction leaves the current journal in place, which is still
+    // complete and open for appending, so the write that triggered it has
+    // succeeded regardless.  The next write tries again.
+    CHIP_ERROR err = WriteSnapshot();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "KVS journal compaction failed: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
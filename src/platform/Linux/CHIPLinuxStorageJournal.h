@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides an append-only, log-structured key-value store used as the
+ *          KeyValueStoreManager backend on Linux.
+ *
+ *          Every Put or Delete appends a single checksummed record to the
+ *          journal file instead of rewriting the whole store, so the cost of a
+ *          write is proportional to the size of the record.  The full contents
+ *          are kept in memory and the journal is compacted (rewritten to a
+ *          temporary file and renamed into place) once superseded records make
+ *          up most of it.
+ *
+ *          On Init, a torn or corrupted tail left by a crash is discarded and
+ *          the file is truncated back to the last complete record.  A file in
+ *          the legacy INI format written by ChipLinuxStorage is migrated to the
+ *          journal format in place.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <map>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageJournal
+{
+public:
+    ChipLinuxStorageJournal() = default;
+    ~ChipLinuxStorageJournal();
+
+    CHIP_ERROR Init(const char * journalFile);
+    void Shutdown();
+
+    /**
+     * Reads the value of the given key, starting at offset.  Follows the
+     * semantics of KeyValueStoreManager::Get().
+     */
+    CHIP_ERROR Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset);
+    CHIP_ERROR Put(const char * key, const void * value, size_t valueSize);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Rewrites the journal so that it only contains the live entries.
+     */
+    CHIP_ERROR Compact();
+
+    size_t GetJournalSize() const { return mJournalSize; }
+
+    // Compaction is only considered once the journal is at least this large...
+    static constexpr size_t kCompactionMinSize = 64 * 1024;
+    // ...and holds at least this many times the bytes needed for the live entries.
+    static constexpr size_t kCompactionRatio = 2;
+
+    // Keys are limited by the 16-bit key length of a record.  Values are only
+    // limited by the 32-bit value length of a record.
+    static constexpr size_t kMaxKeyLength = UINT16_MAX;
+
+private:
+    CHIP_ERROR LoadJournal(const std::string & contents);
+    CHIP_ERROR MigrateIniFile();
+    CHIP_ERROR AppendRecord(uint8_t type, const std::string & key, const void * value, size_t valueSize);
+    CHIP_ERROR WriteSnapshot();
+    CHIP_ERROR OpenForAppend();
+    void CompactIfNeeded();
+
+    std::mutex mLock;
+    std::string mJournalPath;
+    std::map<std::string, std::string> mEntries;
+    // The journal file, opened for appending.  A snapshot only replaces it once
+    // the snapshot has been renamed into place, so a failed compaction leaves
+    // the current journal in use.
+    int mFd = -1;
+    // Current size of the journal file, and the size it would have if it only
+    // held the records of the live entries.
+    size_t mJournalSize = 0;
+    size_t mLiveSize    = 0;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -39,6 +39,9 @@ KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+    return mStorage.Get(key, value, value_size, read_bytes_size, offset_bytes);
+#else
     size_t read_size;
 
     // Copy data into value buffer
@@ -74,10 +77,14 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t
     ::memcpy(value, buf.Get() + offset_bytes, copy_size);
 
     return (value_size < total_size_to_read) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
 }
 
 CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
 {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+    return mStorage.Put(key, value, value_size);
+#else
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
@@ -89,10 +96,14 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
 
 exit:
     return err;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
 }
 
 CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
 {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+    return mStorage.Delete(key);
+#else
     CHIP_ERROR err = CHIP_NO_ERROR;
     err            = mStorage.ClearValue(key);
 
@@ -108,6 +119,7 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
 
 exit:
     return err;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
 }
 
 } // namespace PersistedStorage
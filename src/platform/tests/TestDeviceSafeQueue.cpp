@@ -0,0 +1,165 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the event queue used by
+ *      the POSIX PlatformManager implementations.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <platform/DeviceSafeQueue.h>
+
+using namespace chip::DeviceLayer;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+ChipDeviceEvent MakeEvent(intptr_t arg)
+{
+    ChipDeviceEvent event;
+    event.Type              = DeviceEventType::kCallWorkFunct;
+    event.CallWorkFunct.Arg = arg;
+    return event;
+}
+
+TEST(TestDeviceSafeQueue, PushPopInOrder)
+{
+    // Enough events to go through the ring several times, and to overflow it.
+    constexpr intptr_t kEventCount = 3 * CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE + 1;
+
+    auto queue = std::make_unique<DeviceSafeQueue>();
+    ChipDeviceEvent event;
+
+    EXPECT_TRUE(queue->Empty());
+    EXPECT_FALSE(queue->PopFront(event));
+
+    for (int round = 0; round < 2; round++)
+    {
+        for (intptr_t i = 0; i < kEventCount; i++)
+        {
+            queue->Push(MakeEvent(i));
+        }
+
+        for (intptr_t i = 0; i < kEventCount; i++)
+        {
+            EXPECT_FALSE(queue->Empty());
+            ASSERT_TRUE(queue->PopFront(event));
+            EXPECT_EQ(event.Type, DeviceEventType::kCallWorkFunct);
+            EXPECT_EQ(event.CallWorkFunct.Arg, i);
+        }
+
+        EXPECT_TRUE(queue->Empty());
+        EXPECT_FALSE(queue->PopFront(event));
+    }
+}
+
+TEST(TestDeviceSafeQueue, CoalesceWakeUps)
+{
+    auto queue = std::make_unique<DeviceSafeQueue>();
+    ChipDeviceEvent event;
+
+    // Only the first push asks for a wake-up until the event loop prepares to pop.
+    EXPECT_TRUE(queue->Push(MakeEvent(1)));
+    EXPECT_FALSE(queue->Push(MakeEvent(2)));
+
+    queue->PrepareToPop();
+    ASSERT_TRUE(queue->PopFront(event));
+    EXPECT_EQ(event.CallWorkFunct.Arg, 1);
+
+    // An event pushed while popping asks for another wake-up.
+    EXPECT_TRUE(queue->Push(MakeEvent(3)));
+    EXPECT_FALSE(queue->Push(MakeEvent(4)));
+
+    for (intptr_t arg = 2; arg <= 4; arg++)
+    {
+        ASSERT_TRUE(queue->PopFront(event));
+        EXPECT_EQ(event.CallWorkFunct.Arg, arg);
+    }
+    EXPECT_TRUE(queue->Empty());
+}
+
+TEST(TestDeviceSafeQueue, ConcurrentProducers)
+{
+    constexpr intptr_t kProducerCount      = 8;
+    constexpr intptr_t kEventsPerProducer  = 20000;
+    constexpr intptr_t kProducerIdShift    = 24;
+    constexpr intptr_t kSequenceNumberMask = (intptr_t(1) << kProducerIdShift) - 1;
+    static_assert(kEventsPerProducer <= kSequenceNumberMask, "Sequence numbers must fit below the producer id");
+
+    auto queue = std::make_unique<DeviceSafeQueue>();
+    std::atomic<int> wakeUps{ 0 };
+
+    std::vector<std::thread> producers;
+    for (intptr_t producer = 0; producer < kProducerCount; producer++)
+    {
+        producers.emplace_back([&queue, &wakeUps, producer] {
+            for (intptr_t i = 0; i < kEventsPerProducer; i++)
+            {
+                if (queue->Push(MakeEvent((producer << kProducerIdShift) | i)))
+                {
+                    wakeUps++;
+                }
+            }
+        });
+    }
+
+    // Pop concurrently with the producers, checking that each producer's events come out in the order it pushed them.
+    intptr_t nextSequenceNumber[kProducerCount] = {};
+    intptr_t popped                             = 0;
+    while (popped < kProducerCount * kEventsPerProducer)
+    {
+        queue->PrepareToPop();
+
+        ChipDeviceEvent event;
+        while (queue->PopFront(event))
+        {
+            const intptr_t producer = event.CallWorkFunct.Arg >> kProducerIdShift;
+            ASSERT_GE(producer, 0);
+            ASSERT_LT(producer, kProducerCount);
+            EXPECT_EQ(event.CallWorkFunct.Arg & kSequenceNumberMask, nextSequenceNumber[producer]);
+            nextSequenceNumber[producer] = (event.CallWorkFunct.Arg & kSequenceNumberMask) + 1;
+            popped++;
+        }
+
+        std::this_thread::yield();
+    }
+
+    for (auto & thread : producers)
+    {
+        thread.join();
+    }
+
+    EXPECT_TRUE(queue->Empty());
+    for (intptr_t producer = 0; producer < kProducerCount; producer++)
+    {
+        EXPECT_EQ(nextSequenceNumber[producer], kEventsPerProducer);
+    }
+
+    // Pushes coalesce their wake-ups, so there cannot have been more wake-ups than events.
+    EXPECT_GE(wakeUps.load(), 1);
+    EXPECT_LE(wakeUps.load(), kProducerCount * kEventsPerProducer);
+}
+
+} // namespace
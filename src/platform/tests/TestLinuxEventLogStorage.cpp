@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the memory-mapped event log
+ *      storage used on Linux.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <platform/Linux/CHIPLinuxEventLogStorage.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+struct TestLinuxEventLogStorage : public ::testing::Test
+{
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_event_log_test-XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        mPath = path;
+    }
+
+    void TearDown() override { unlink(mPath.c_str()); }
+
+    std::string mPath;
+};
+
+TEST_F(TestLinuxEventLogStorage, BuffersPersist)
+{
+    static constexpr uint32_t kSizes[] = { 61, 128, 256 };
+    static constexpr char kData[]      = "persisted event data";
+
+    {
+        ChipLinuxEventLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str(), kSizes, 3), CHIP_NO_ERROR);
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            ASSERT_NE(storage.GetBuffer(i), nullptr);
+            EXPECT_EQ(storage.GetBufferSize(i), kSizes[i]);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(storage.GetBufferState(i)) % sizeof(uint64_t), 0u);
+            EXPECT_EQ(storage.GetBufferState(i)->load(), 0u);
+        }
+        EXPECT_EQ(storage.GetBuffer(3), nullptr);
+        EXPECT_EQ(storage.GetBufferState(3), nullptr);
+
+        // Buffers must not overlap each other or the header.
+        EXPECT_GE(storage.GetBuffer(1), storage.GetBuffer(0) + kSizes[0]);
+        EXPECT_GE(storage.GetBuffer(2), storage.GetBuffer(1) + kSizes[1]);
+        EXPECT_GT(storage.GetBuffer(0), reinterpret_cast<uint8_t *>(storage.GetBufferState(2)));
+
+        memcpy(storage.GetBuffer(2) + kSizes[2] - sizeof(kData), kData, sizeof(kData));
+        storage.GetBufferState(2)->store(0x0000001200000034);
+        EXPECT_EQ(storage.Sync(), CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxEventLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str(), kSizes, 3), CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(storage.GetBuffer(2) + kSizes[2] - sizeof(kData), kData, sizeof(kData)), 0);
+        EXPECT_EQ(storage.GetBufferState(2)->load(), 0x0000001200000034u);
+        EXPECT_EQ(storage.GetBufferState(0)->load(), 0u);
+    }
+}
+
+TEST_F(TestLinuxEventLogStorage, ResetOnLayoutChange)
+{
+    static constexpr uint32_t kSizes[]        = { 128, 128 };
+    static constexpr uint32_t kResizedSizes[] = { 128, 256 };
+
+    {
+        ChipLinuxEventLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str(), kSizes, 2), CHIP_NO_ERROR);
+        storage.GetBuffer(0)[0] = 0xA5;
+        storage.GetBufferState(0)->store(1);
+    }
+
+    // Same total size, different number of buffers.
+    {
+        static constexpr uint32_t kSplitSizes[] = { 64, 64, 128 };
+        ChipLinuxEventLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str(), kSplitSizes, 3), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.GetBufferState(0)->load(), 0u);
+    }
+
+    {
+        ChipLinuxEventLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str(), kSizes, 2), CHIP_NO_ERROR);
+        storage.GetBufferState(0)->store(1);
+    }
+
+    {
+        ChipLinuxEventLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str(), kResizedSizes, 2), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.GetBuffer(0)[0], 0);
+        EXPECT_EQ(storage.GetBufferState(0)->load(), 0u);
+    }
+}
+
+TEST_F(TestLinuxEventLogStorage, InvalidArguments)
+{
+    static constexpr uint32_t kSizes[] = { 128, 128, 128, 128, 128 };
+    ChipLinuxEventLogStorage storage;
+
+    EXPECT_EQ(storage.Init(nullptr, kSizes, 1), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(storage.Init(mPath.c_str(), kSizes, 0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(storage.Init(mPath.c_str(), kSizes, ChipLinuxEventLogStorage::kMaxBuffers + 1), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(storage.Sync(), CHIP_ERROR_INCORRECT_STATE);
+}
+
+} // namespace
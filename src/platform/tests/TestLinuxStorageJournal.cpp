@@ -0,0 +1,255 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the journaled key-value
+ *      store used by KeyValueStoreManager on Linux.
+ *
+ */
+
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <lib/support/CHIPMem.h>
+#include <platform/Linux/CHIPLinuxStorageJournal.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+struct TestLinuxStorageJournal : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_kvs_journal_test-XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        mPath = path;
+    }
+
+    void TearDown() override { unlink(mPath.c_str()); }
+
+    size_t FileSize()
+    {
+        std::ifstream ifs(mPath, std::ifstream::binary | std::ifstream::ate);
+        return static_cast<size_t>(ifs.tellg());
+    }
+
+    std::string mPath;
+};
+
+TEST_F(TestLinuxStorageJournal, PutGetDeletePersist)
+{
+    static constexpr char kValue1[] = "value1";
+    static constexpr char kValue2[] = "second value";
+    char readValue[32];
+    size_t readSize;
+
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        EXPECT_EQ(journal.Put("key1", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Put("key2", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Put("key2", kValue2, sizeof(kValue2)), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Put("key3", nullptr, 0), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Delete("key1"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Delete("key1"), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+        EXPECT_EQ(journal.Get("key2", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+        EXPECT_EQ(readSize, sizeof(kValue2));
+        EXPECT_EQ(memcmp(readValue, kValue2, sizeof(kValue2)), 0);
+    }
+
+    // Everything must survive reopening the journal.
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    EXPECT_EQ(journal.Get("key1", readValue, sizeof(readValue), &readSize, 0), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    EXPECT_EQ(journal.Get("key2", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(kValue2));
+    EXPECT_EQ(memcmp(readValue, kValue2, sizeof(kValue2)), 0);
+
+    // Partial reads at an offset.
+    EXPECT_EQ(journal.Get("key2", readValue, 3, &readSize, 7), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(readSize, 3u);
+    EXPECT_EQ(memcmp(readValue, &kValue2[7], 3), 0);
+
+    EXPECT_EQ(journal.Get("key3", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 0u);
+}
+
+TEST_F(TestLinuxStorageJournal, TornTailIsDiscarded)
+{
+    static constexpr char kValue[] = "some value";
+    char readValue[32];
+    size_t readSize;
+    size_t sizeAfterFirstPut;
+
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Put("a", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+        sizeAfterFirstPut = journal.GetJournalSize();
+        EXPECT_EQ(journal.Put("b", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+    }
+
+    // Simulate a crash in the middle of appending the second record.
+    ASSERT_EQ(truncate(mPath.c_str(), static_cast<off_t>(FileSize() - 3)), 0);
+
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(FileSize(), sizeAfterFirstPut);
+
+        EXPECT_EQ(journal.Get("a", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Get("b", readValue, sizeof(readValue), &readSize, 0), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        EXPECT_EQ(journal.Put("c", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(journal.Get("a", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(journal.Get("c", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+}
+
+TEST_F(TestLinuxStorageJournal, MigratesIniFile)
+{
+    {
+        std::ofstream ofs(mPath, std::ofstream::trunc);
+        // "g/fs/c" and "key with space" holding base64 of "abc" and "hello".
+        ofs << "[DEFAULT]\ng/fs/c=YWJj\nkey\\x20with\\x20space=aGVsbG8=\n";
+    }
+
+    char readValue[32];
+    size_t readSize;
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    EXPECT_EQ(journal.Get("g/fs/c", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 3u);
+    EXPECT_EQ(memcmp(readValue, "abc", 3), 0);
+
+    EXPECT_EQ(journal.Get("key with space", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 5u);
+    EXPECT_EQ(memcmp(readValue, "hello", 5), 0);
+
+    // The file has been rewritten in the journal format.
+    std::ifstream ifs(mPath, std::ifstream::binary);
+    char magic[8];
+    ifs.read(magic, sizeof(magic));
+    EXPECT_EQ(memcmp(magic, "CHIPKVJ1", sizeof(magic)), 0);
+}
+
+TEST_F(TestLinuxStorageJournal, CompactsSupersededRecords)
+{
+    static uint8_t sValue[1024];
+    char readValue[8];
+    size_t readSize;
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < 2 * ChipLinuxStorageJournal::kCompactionMinSize / sizeof(sValue); i++)
+    {
+        sValue[0] = static_cast<uint8_t>(i);
+        ASSERT_EQ(journal.Put("key", sValue, sizeof(sValue)), CHIP_NO_ERROR);
+        EXPECT_LT(journal.GetJournalSize(), ChipLinuxStorageJournal::kCompactionMinSize + sizeof(sValue) + 64);
+    }
+
+    EXPECT_EQ(FileSize(), journal.GetJournalSize());
+    EXPECT_EQ(journal.Get("key", readValue, 1, &readSize, 0), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(readValue[0], static_cast<char>(sValue[0]));
+}
+
+TEST_F(TestLinuxStorageJournal, FailedCompactionKeepsJournal)
+{
+    static constexpr char kValue1[] = "value1";
+    static constexpr char kValue2[] = "value2";
+    char readValue[32];
+    size_t readSize;
+
+    char dir[] = "/tmp/chip_kvs_journal_dir-XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    const std::string movedDir = std::string(dir) + "-moved";
+    const std::string path     = std::string(dir) + "/kvs";
+
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(path.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Put("key1", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+
+        // Without the directory, no snapshot can be written next to the journal.
+        ASSERT_EQ(rename(dir, movedDir.c_str()), 0);
+        EXPECT_NE(journal.Compact(), CHIP_NO_ERROR);
+
+        // The journal is still open, so writes keep going to it.
+        EXPECT_EQ(journal.Put("key2", kValue2, sizeof(kValue2)), CHIP_NO_ERROR);
+
+        ASSERT_EQ(rename(movedDir.c_str(), dir), 0);
+        EXPECT_EQ(journal.Compact(), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Delete("key1"), CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(path.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Get("key1", readValue, sizeof(readValue), &readSize, 0), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        EXPECT_EQ(journal.Get("key2", readValue, sizeof(readValue), &readSize, 0), CHIP_NO_ERROR);
+        EXPECT_EQ(readSize, sizeof(kValue2));
+        EXPECT_EQ(memcmp(readValue, kValue2, sizeof(kValue2)), 0);
+    }
+
+    unlink(path.c_str());
+    rmdir(dir);
+}
+
+TEST_F(TestLinuxStorageJournal, LargeValue)
+{
+    // Values are not limited to 64 KiB.
+    std::string value(3 * UINT16_MAX, 'x');
+    value.back() = 'y';
+    std::string readValue(value.size(), '\0');
+    size_t readSize;
+
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Put("key", value.data(), value.size()), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(journal.Get("key", &readValue[0], readValue.size(), &readSize, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, value.size());
+    EXPECT_EQ(readValue, value);
+}
+
+} // namespace
@@ -203,6 +203,50 @@ TEST_F(TestPlatformMgr, RunEventLoopStopBeforeSleep)
     PlatformMgr().Shutdown();
 }
 
+static constexpr int kBackgroundWorkCount = 16;
+static std::atomic<int> sBackgroundWorkRan;
+static int sAfterBackgroundWorkRan;
+
+static void AfterBackgroundWork(intptr_t)
+{
+    // Runs on the Matter thread, so needs no synchronization.
+    if (++sAfterBackgroundWorkRan == kBackgroundWorkCount)
+    {
+        StopTheLoop(0);
+    }
+}
+
+static void BackgroundWork(intptr_t)
+{
+    sBackgroundWorkRan++;
+    PlatformMgr().ScheduleWork(AfterBackgroundWork);
+}
+
+TEST_F(TestPlatformMgr, BackgroundWork)
+{
+    stopRan                 = false;
+    sBackgroundWorkRan      = 0;
+    sAfterBackgroundWorkRan = 0;
+
+    EXPECT_EQ(PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+
+    // Background work runs on background threads if there are any, or on the Matter thread otherwise.
+    // Either way, it can hand its results back to the Matter thread.
+    PlatformMgr().LockChipStack();
+    for (int i = 0; i < kBackgroundWorkCount; i++)
+    {
+        EXPECT_EQ(PlatformMgr().ScheduleBackgroundWork(BackgroundWork), CHIP_NO_ERROR);
+    }
+    PlatformMgr().UnlockChipStack();
+
+    PlatformMgr().RunEventLoop();
+    EXPECT_TRUE(stopRan);
+    EXPECT_EQ(sBackgroundWorkRan, kBackgroundWorkCount);
+    EXPECT_EQ(sAfterBackgroundWorkRan, kBackgroundWorkCount);
+
+    PlatformMgr().Shutdown();
+}
+
 TEST_F(TestPlatformMgr, TryLockChipStack)
 {
     bool locked = PlatformMgr().TryLockChipStack();
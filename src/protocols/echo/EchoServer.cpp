@@ -71,21 +71,11 @@ CHIP_ERROR EchoServer::OnMessageReceived(Messaging::ExchangeContext * ec, const
         OnEchoRequestReceived(ec, payload.Retain());
     }
 
-    System::PacketBufferHandle response;
-
-    // Since we are re-using the inbound EchoRequest buffer to send the EchoResponse, if necessary,
-    // adjust the position of the payload within the buffer to ensure there is enough room for the
-    // outgoing network headers.  This is necessary because in some network stack configurations,
-    // the incoming header size may be smaller than the outgoing size.
-    if (payload->EnsureReservedSize(CHIP_SYSTEM_CONFIG_HEADER_RESERVE_SIZE) && MessagePacketBuffer::HasFooterSpace(payload))
-    {
-        response = std::move(payload);
-    }
-    else
-    {
-        response = MessagePacketBuffer::NewWithData(payload->Start(), payload->DataLength());
-        VerifyOrReturnError(!response.IsNull(), CHIP_ERROR_NO_MEMORY);
-    }
+    // Re-use the inbound EchoRequest buffer to send the EchoResponse when possible.  This moves the payload within the
+    // buffer if necessary, since in some network stack configurations the incoming header size may be smaller than the
+    // outgoing size.
+    System::PacketBufferHandle response = MessagePacketBuffer::ReuseOrCopy(std::move(payload));
+    VerifyOrReturnError(!response.IsNull(), CHIP_ERROR_NO_MEMORY);
 
     // Send an Echo Response back to the sender.
     return ec->SendMessage(MsgType::EchoResponse, std::move(response));
@@ -0,0 +1,581 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/IndexedSessionResumptionStorage.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+
+#include <string.h>
+
+namespace chip {
+
+constexpr TLV::Tag IndexedSessionResumptionStorage::kSlotTag;
+constexpr TLV::Tag IndexedSessionResumptionStorage::kFabricIndexTag;
+constexpr TLV::Tag IndexedSessionResumptionStorage::kPeerNodeIdTag;
+constexpr TLV::Tag IndexedSessionResumptionStorage::kResumptionIdTag;
+constexpr TLV::Tag IndexedSessionResumptionStorage::kSaveCounterTag;
+
+namespace {
+
+size_t Mix(uint64_t value)
+{
+    // Fibonacci hashing: the upper bits of the product depend on all the bits of the value.
+    return static_cast<size_t>((value * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+} // namespace
+
+CHIP_ERROR IndexedSessionResumptionStorage::Init(PersistentStorageDelegate * storage, size_t capacity)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(capacity > 0 && capacity <= kMaxCapacity, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mStorage == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // Pages are always full, so that a slot is valid if and only if its page is.
+    mCapacity = (capacity + kEntriesPerPage - 1) / kEntriesPerPage * kEntriesPerPage;
+
+    size_t bucketCount = 1;
+    while (bucketCount < mCapacity)
+    {
+        bucketCount <<= 1;
+    }
+    mBucketMask = bucketCount - 1;
+
+    mEntries.Calloc(mCapacity);
+    mNodeBuckets.Alloc(bucketCount);
+    mResumptionIdBuckets.Alloc(bucketCount);
+    VerifyOrReturnError(mEntries.Get() != nullptr && mNodeBuckets.Get() != nullptr && mResumptionIdBuckets.Get() != nullptr,
+                        CHIP_ERROR_NO_MEMORY);
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        mNodeBuckets[i]         = kInvalidSlot;
+        mResumptionIdBuckets[i] = kInvalidSlot;
+    }
+
+    ReturnErrorOnFailure(mStateStorage.Init(storage));
+    mStorage         = storage;
+    mCount           = 0;
+    mFreeList        = kInvalidSlot;
+    mNextSaveCounter = 0;
+
+    uint16_t storedPageCount = 0;
+    uint16_t size            = static_cast<uint16_t>(sizeof(storedPageCount));
+    CHIP_ERROR err =
+        mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SessionResumptionIndexPageCount().KeyName(), &storedPageCount, size);
+    const bool migrate = (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    if (migrate)
+    {
+        storedPageCount = 0;
+    }
+    else
+    {
+        ReturnErrorOnFailure(err);
+        VerifyOrReturnError(size == sizeof(storedPageCount), CHIP_ERROR_INCORRECT_STATE);
+        storedPageCount = Encoding::LittleEndian::HostSwap16(storedPageCount);
+    }
+
+    for (size_t page = 0; page < PageCount(); page++)
+    {
+        ReturnErrorOnFailure(LoadPage(page));
+    }
+
+    // The lowest slots come first, so that sessions are kept in as few pages as possible.
+    for (size_t slot = mCapacity; slot > 0; slot--)
+    {
+        if (!mEntries[slot - 1].mInUse)
+        {
+            mEntries[slot - 1].mNextByNode = mFreeList;
+            mFreeList                      = static_cast<uint16_t>(slot - 1);
+        }
+    }
+
+    // Pages beyond the capacity are left over from a larger capacity; their sessions are moved to free slots.
+    for (size_t page = PageCount(); page < storedPageCount; page++)
+    {
+        ReturnErrorOnFailure(LoadPage(page));
+        err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SessionResumptionIndexPage(page).KeyName());
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+    }
+
+    if (migrate)
+    {
+        ReturnErrorOnFailure(MigrateSimpleStorage());
+    }
+
+    if (storedPageCount != PageCount())
+    {
+        const uint16_t pageCountLE = Encoding::LittleEndian::HostSwap16(static_cast<uint16_t>(PageCount()));
+        ReturnErrorOnFailure(mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SessionResumptionIndexPageCount().KeyName(),
+                                                       &pageCountLE, sizeof(pageCountLE)));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                                               Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    const uint16_t slot = FindSlot(node);
+    VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_KEY_NOT_FOUND);
+
+    ReturnErrorOnFailure(mStateStorage.LoadState(node, resumptionId, sharedSecret, peerCATs));
+    // The state is saved before the index, so they disagree if saving the index failed.
+    VerifyOrReturnError(resumptionId == mEntries[slot].mResumptionId, CHIP_ERROR_KEY_NOT_FOUND);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                                               Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    const uint16_t slot = FindSlot(resumptionId);
+    VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_KEY_NOT_FOUND);
+
+    ResumptionIdStorage storedResumptionId;
+    ReturnErrorOnFailure(mStateStorage.LoadState(mEntries[slot].mNode, storedResumptionId, sharedSecret, peerCATs));
+    VerifyOrReturnError(std::equal(storedResumptionId.begin(), storedResumptionId.end(), resumptionId.begin(), resumptionId.end()),
+                        CHIP_ERROR_KEY_NOT_FOUND);
+    node = mEntries[slot].mNode;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                                                 const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    uint16_t slot = FindSlot(node);
+    if (slot == kInvalidSlot && mFreeList == kInvalidSlot)
+    {
+        // Finding the least recently saved session is linear, but only happens once the storage is full.
+        ReturnErrorOnFailure(DeleteSlot(FindLeastRecentlySavedSlot()));
+    }
+
+    ReturnErrorOnFailure(mStateStorage.SaveState(node, resumptionId, sharedSecret, peerCATs));
+
+    if (slot == kInvalidSlot)
+    {
+        slot = AllocateSlot();
+        InsertEntry(slot, node, resumptionId, mNextSaveCounter++);
+    }
+    else
+    {
+        Entry & entry = mEntries[slot];
+        UnlinkResumptionId(slot);
+        std::copy(resumptionId.begin(), resumptionId.end(), entry.mResumptionId.begin());
+        LinkResumptionId(slot);
+        entry.mSaveCounter = mNextSaveCounter++;
+    }
+
+    return SavePage(slot / kEntriesPerPage);
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::Delete(const ScopedNodeId & node)
+{
+    const uint16_t slot = FindSlot(node);
+    VerifyOrReturnError(slot != kInvalidSlot, CHIP_NO_ERROR);
+    return DeleteSlot(slot);
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
+{
+    CHIP_ERROR stickyErr = CHIP_NO_ERROR;
+
+    for (size_t page = 0; page < PageCount() && mCount > 0; page++)
+    {
+        bool found = false;
+        for (size_t slot = page * kEntriesPerPage; slot < (page + 1) * kEntriesPerPage; slot++)
+        {
+            const Entry & entry = mEntries[slot];
+            if (!entry.mInUse || entry.mNode.GetFabricIndex() != fabricIndex)
+            {
+                continue;
+            }
+
+            const ScopedNodeId node = entry.mNode;
+            RemoveEntry(static_cast<uint16_t>(slot));
+            found = true;
+
+            CHIP_ERROR err = mStateStorage.DeleteState(node);
+            if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+            {
+                ChipLogError(SecureChannel,
+                             "Session resumption cache deletion partially failed for fabric index %u, "
+                             "unable to delete node state: %" CHIP_ERROR_FORMAT,
+                             fabricIndex, err.Format());
+                stickyErr = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
+            }
+        }
+
+        if (found)
+        {
+            CHIP_ERROR err = SavePage(page);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(
+                    SecureChannel,
+                    "Unable to save session resumption index during attempted deletion of fabric index %u: %" CHIP_ERROR_FORMAT,
+                    fabricIndex, err.Format());
+                stickyErr = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
+            }
+        }
+    }
+
+    return stickyErr;
+}
+
+size_t IndexedSessionResumptionStorage::HashNode(const ScopedNodeId & node)
+{
+    return Mix(node.GetNodeId() ^ (static_cast<uint64_t>(node.GetFabricIndex()) << 56));
+}
+
+size_t IndexedSessionResumptionStorage::HashResumptionId(ConstResumptionIdView resumptionId)
+{
+    // Resumption IDs are random, so part of them is as good as all of them.
+    uint64_t value;
+    memcpy(&value, resumptionId.data(), sizeof(value));
+    return Mix(value);
+}
+
+uint16_t IndexedSessionResumptionStorage::FindSlot(const ScopedNodeId & node) const
+{
+    VerifyOrReturnValue(mCount > 0, kInvalidSlot);
+
+    uint16_t slot = mNodeBuckets[HashNode(node) & mBucketMask];
+    while (slot != kInvalidSlot && !(mEntries[slot].mNode == node))
+    {
+        slot = mEntries[slot].mNextByNode;
+    }
+    return slot;
+}
+
+uint16_t IndexedSessionResumptionStorage::FindSlot(ConstResumptionIdView resumptionId) const
+{
+    VerifyOrReturnValue(mCount > 0, kInvalidSlot);
+
+    uint16_t slot = mResumptionIdBuckets[HashResumptionId(resumptionId) & mBucketMask];
+    while (slot != kInvalidSlot &&
+           !std::equal(resumptionId.begin(), resumptionId.end(), mEntries[slot].mResumptionId.begin()))
+    {
+        slot = mEntries[slot].mNextByResumptionId;
+    }
+    return slot;
+}
+
+uint16_t IndexedSessionResumptionStorage::FindLeastRecentlySavedSlot() const
+{
+    uint16_t oldest = kInvalidSlot;
+    for (size_t slot = 0; slot < mCapacity; slot++)
+    {
+        const Entry & entry = mEntries[slot];
+        // Save counters are compared as differences to the next one, so that they may wrap around.
+        if (entry.mInUse &&
+            (oldest == kInvalidSlot ||
+             mNextSaveCounter - entry.mSaveCounter > mNextSaveCounter - mEntries[oldest].mSaveCounter))
+        {
+            oldest = static_cast<uint16_t>(slot);
+        }
+    }
+    return oldest;
+}
+
+uint16_t IndexedSessionResumptionStorage::AllocateSlot()
+{
+    const uint16_t slot = mFreeList;
+    VerifyOrDie(slot != kInvalidSlot);
+    mFreeList = mEntries[slot].mNextByNode;
+    return slot;
+}
+
+void IndexedSessionResumptionStorage::InsertEntry(uint16_t slot, const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                                                  uint32_t saveCounter)
+{
+    Entry & entry = mEntries[slot];
+    entry.mNode   = node;
+    std::copy(resumptionId.begin(), resumptionId.end(), entry.mResumptionId.begin());
+    entry.mSaveCounter = saveCounter;
+    entry.mInUse       = true;
+
+    uint16_t & bucket = mNodeBuckets[HashNode(node) & mBucketMask];
+    entry.mNextByNode = bucket;
+    bucket            = slot;
+    LinkResumptionId(slot);
+    mCount++;
+}
+
+void IndexedSessionResumptionStorage::RemoveEntry(uint16_t slot)
+{
+    Entry & entry = mEntries[slot];
+
+    uint16_t * link = &mNodeBuckets[HashNode(entry.mNode) & mBucketMask];
+    while (*link != slot)
+    {
+        link = &mEntries[*link].mNextByNode;
+    }
+    *link = entry.mNextByNode;
+    UnlinkResumptionId(slot);
+
+    entry.mInUse      = false;
+    entry.mNextByNode = mFreeList;
+    mFreeList         = slot;
+    mCount--;
+}
+
+void IndexedSessionResumptionStorage::LinkResumptionId(uint16_t slot)
+{
+    Entry & entry             = mEntries[slot];
+    uint16_t & bucket         = mResumptionIdBuckets[HashResumptionId(ConstResumptionIdView(entry.mResumptionId)) & mBucketMask];
+    entry.mNextByResumptionId = bucket;
+    bucket                    = slot;
+}
+
+void IndexedSessionResumptionStorage::UnlinkResumptionId(uint16_t slot)
+{
+    Entry & entry = mEntries[slot];
+
+    uint16_t * link = &mResumptionIdBuckets[HashResumptionId(ConstResumptionIdView(entry.mResumptionId)) & mBucketMask];
+    while (*link != slot)
+    {
+        link = &mEntries[*link].mNextByResumptionId;
+    }
+    *link = entry.mNextByResumptionId;
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::DeleteSlot(uint16_t slot)
+{
+    const ScopedNodeId node = mEntries[slot].mNode;
+    RemoveEntry(slot);
+
+    CHIP_ERROR err = mStateStorage.DeleteState(node);
+    if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        ChipLogError(SecureChannel, "Unable to delete session resumption state for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueX64(node.GetNodeId()), err.Format());
+    }
+
+    return SavePage(slot / kEntriesPerPage);
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::LoadPage(size_t page)
+{
+    std::array<uint8_t, MaxPageSize()> buf;
+    uint16_t len = static_cast<uint16_t>(buf.size());
+
+    CHIP_ERROR err =
+        mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SessionResumptionIndexPage(page).KeyName(), buf.data(), len);
+    VerifyOrReturnError(err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(err);
+
+    bool dirty = false;
+    err        = ReadPage(page, ByteSpan(buf.data(), len), dirty);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Dropping corrupt session resumption index page %u: %" CHIP_ERROR_FORMAT,
+                     static_cast<unsigned>(page), err.Format());
+        dirty = true;
+    }
+
+    if (dirty && page < PageCount())
+    {
+        ReturnErrorOnFailure(SavePage(page));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::ReadPage(size_t page, ByteSpan data, bool & dirty)
+{
+    TLV::ContiguousBufferTLVReader reader;
+    reader.Init(data);
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(reader.EnterContainer(arrayType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType containerType;
+        ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+        uint16_t slot;
+        ReturnErrorOnFailure(reader.Next(kSlotTag));
+        ReturnErrorOnFailure(reader.Get(slot));
+
+        FabricIndex fabricIndex;
+        ReturnErrorOnFailure(reader.Next(kFabricIndexTag));
+        ReturnErrorOnFailure(reader.Get(fabricIndex));
+
+        NodeId peerNodeId;
+        ReturnErrorOnFailure(reader.Next(kPeerNodeIdTag));
+        ReturnErrorOnFailure(reader.Get(peerNodeId));
+
+        ByteSpan resumptionIdSpan;
+        ReturnErrorOnFailure(reader.Next(kResumptionIdTag));
+        ReturnErrorOnFailure(reader.Get(resumptionIdSpan));
+        VerifyOrReturnError(resumptionIdSpan.size() == kResumptionIdSize, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        uint32_t saveCounter;
+        ReturnErrorOnFailure(reader.Next(kSaveCounterTag));
+        ReturnErrorOnFailure(reader.Get(saveCounter));
+
+        ReturnErrorOnFailure(reader.ExitContainer(containerType));
+
+        const ScopedNodeId node(peerNodeId, fabricIndex);
+        const ConstResumptionIdView resumptionId(resumptionIdSpan.data());
+        if (slot / kEntriesPerPage != page || FindSlot(node) != kInvalidSlot || FindSlot(resumptionId) != kInvalidSlot ||
+            (slot < mCapacity && mEntries[slot].mInUse))
+        {
+            dirty = true;
+            continue;
+        }
+
+        if (slot < mCapacity)
+        {
+            InsertEntry(slot, node, resumptionId, saveCounter);
+        }
+        else if (mFreeList != kInvalidSlot)
+        {
+            slot = AllocateSlot();
+            InsertEntry(slot, node, resumptionId, saveCounter);
+            ReturnErrorOnFailure(SavePage(slot / kEntriesPerPage));
+        }
+        else
+        {
+            err = mStateStorage.DeleteState(node);
+            VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+            continue;
+        }
+
+        if (saveCounter >= mNextSaveCounter)
+        {
+            mNextSaveCounter = saveCounter + 1;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(reader.ExitContainer(arrayType));
+    return reader.VerifyEndOfContainer();
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::SavePage(size_t page)
+{
+    const StorageKeyName key = DefaultStorageKeyAllocator::SessionResumptionIndexPage(page);
+
+    std::array<uint8_t, MaxPageSize()> buf;
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, arrayType));
+
+    bool empty = true;
+    for (size_t slot = page * kEntriesPerPage; slot < (page + 1) * kEntriesPerPage; slot++)
+    {
+        const Entry & entry = mEntries[slot];
+        if (!entry.mInUse)
+        {
+            continue;
+        }
+
+        TLV::TLVType innerType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, innerType));
+        ReturnErrorOnFailure(writer.Put(kSlotTag, static_cast<uint16_t>(slot)));
+        ReturnErrorOnFailure(writer.Put(kFabricIndexTag, entry.mNode.GetFabricIndex()));
+        ReturnErrorOnFailure(writer.Put(kPeerNodeIdTag, entry.mNode.GetNodeId()));
+        ReturnErrorOnFailure(writer.Put(kResumptionIdTag, ByteSpan(entry.mResumptionId)));
+        ReturnErrorOnFailure(writer.Put(kSaveCounterTag, entry.mSaveCounter));
+        ReturnErrorOnFailure(writer.EndContainer(innerType));
+        empty = false;
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(arrayType));
+
+    if (empty)
+    {
+        CHIP_ERROR err = mStorage->SyncDeleteKeyValue(key.KeyName());
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+        return CHIP_NO_ERROR;
+    }
+
+    const auto len = writer.GetLengthWritten();
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    return mStorage->SyncSetKeyValue(key.KeyName(), buf.data(), static_cast<uint16_t>(len));
+}
+
+CHIP_ERROR IndexedSessionResumptionStorage::MigrateSimpleStorage()
+{
+    // The index of SimpleSessionResumptionStorage is too large to live on the stack.
+    auto index = Platform::MakeUnique<DefaultSessionResumptionStorage::SessionIndex>();
+    VerifyOrReturnError(index, CHIP_ERROR_NO_MEMORY);
+
+    CHIP_ERROR err = mStateStorage.LoadIndex(*index);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to load session resumption index to migrate: %" CHIP_ERROR_FORMAT, err.Format());
+        index->mSize = 0;
+    }
+
+    // The states stay where they are; only the links from resumption IDs to nodes are replaced by the index.
+    for (size_t i = 0; i < index->mSize; i++)
+    {
+        const ScopedNodeId & node = index->mNodes[i];
+        ResumptionIdStorage resumptionId;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+
+        if (mStateStorage.LoadState(node, resumptionId, sharedSecret, peerCATs) != CHIP_NO_ERROR)
+        {
+            continue;
+        }
+        err = mStateStorage.DeleteLink(resumptionId);
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+
+        // A migration interrupted before the old index was deleted may already have saved the node in the index pages.
+        const uint16_t slot = FindSlot(node);
+        if (slot != kInvalidSlot && mEntries[slot].mResumptionId == resumptionId)
+        {
+            continue;
+        }
+        if (slot != kInvalidSlot)
+        {
+            RemoveEntry(slot);
+        }
+
+        if (FindSlot(resumptionId) != kInvalidSlot || mFreeList == kInvalidSlot)
+        {
+            err = mStateStorage.DeleteState(node);
+            VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+            continue;
+        }
+
+        InsertEntry(AllocateSlot(), node, resumptionId, mNextSaveCounter++);
+    }
+
+    for (size_t page = 0; page * kEntriesPerPage < mCapacity; page++)
+    {
+        ReturnErrorOnFailure(SavePage(page));
+    }
+
+    err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SessionResumptionIndex().KeyName());
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace chip
@@ -0,0 +1,124 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/TLV.h>
+#include <lib/support/ScopedBuffer.h>
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+
+namespace chip {
+
+/**
+ * @brief A SessionResumptionStorage for large numbers of peers, e.g. on controllers.
+ *
+ *   The index of the stored sessions is loaded once, on Init, into memory, where it is hashed both by ScopedNodeId and by
+ *   ResumptionId, so that lookups only read the state of the session found, and misses do not touch storage at all.
+ *
+ *   The index is persisted in pages of kEntriesPerPage entries, each entry keeping its slot, so that saving or deleting a
+ *   session only rewrites the page of its slot, instead of the whole index.  The session states are stored as by
+ *   SimpleSessionResumptionStorage, which also provides the format of the data this storage migrates from on Init.
+ *
+ *   When full, saving a new session evicts the least recently saved one.
+ */
+class IndexedSessionResumptionStorage : public SessionResumptionStorage
+{
+public:
+    static constexpr size_t kEntriesPerPage = 32;
+    static constexpr size_t kMaxCapacity    = UINT16_MAX / kEntriesPerPage * kEntriesPerPage;
+
+    /**
+     * Loads the index, migrating the data of a SimpleSessionResumptionStorage if there is no index yet.  The capacity is rounded
+     * up to a whole number of pages.  Sessions beyond the capacity, e.g. after it was reduced, are deleted.
+     */
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, size_t capacity = CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE);
+
+    CHIP_ERROR FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override;
+    CHIP_ERROR FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override;
+    CHIP_ERROR Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                    const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs) override;
+    CHIP_ERROR Delete(const ScopedNodeId & node);
+    CHIP_ERROR DeleteAll(FabricIndex fabricIndex) override;
+
+    size_t Count() const { return mCount; }
+
+private:
+    static constexpr uint16_t kInvalidSlot = UINT16_MAX;
+
+    struct Entry
+    {
+        ScopedNodeId mNode;
+        ResumptionIdStorage mResumptionId;
+        uint32_t mSaveCounter        = 0;            // When the entry was last saved, to find the least recently saved one.
+        uint16_t mNextByNode         = kInvalidSlot; // Next entry in the same node bucket, or in the free list.
+        uint16_t mNextByResumptionId = kInvalidSlot; // Next entry in the same resumption ID bucket.
+        bool mInUse                  = false;
+    };
+
+    static constexpr size_t MaxPageSize()
+    {
+        // The max size of the list is (1 byte control + bytes for actual value) times max number of list items
+        return TLV::EstimateStructOverhead(
+            (1 +
+             TLV::EstimateStructOverhead(sizeof(uint16_t), sizeof(FabricIndex), sizeof(NodeId), kResumptionIdSize,
+                                         sizeof(uint32_t))) *
+            kEntriesPerPage);
+    }
+
+    static constexpr TLV::Tag kSlotTag         = TLV::ContextTag(1);
+    static constexpr TLV::Tag kFabricIndexTag  = TLV::ContextTag(2);
+    static constexpr TLV::Tag kPeerNodeIdTag   = TLV::ContextTag(3);
+    static constexpr TLV::Tag kResumptionIdTag = TLV::ContextTag(4);
+    static constexpr TLV::Tag kSaveCounterTag  = TLV::ContextTag(5);
+
+    static size_t HashNode(const ScopedNodeId & node);
+    static size_t HashResumptionId(ConstResumptionIdView resumptionId);
+
+    uint16_t FindSlot(const ScopedNodeId & node) const;
+    uint16_t FindSlot(ConstResumptionIdView resumptionId) const;
+    uint16_t FindLeastRecentlySavedSlot() const;
+
+    uint16_t AllocateSlot();
+    void InsertEntry(uint16_t slot, const ScopedNodeId & node, ConstResumptionIdView resumptionId, uint32_t saveCounter);
+    void RemoveEntry(uint16_t slot);
+    void LinkResumptionId(uint16_t slot);
+    void UnlinkResumptionId(uint16_t slot);
+
+    CHIP_ERROR DeleteSlot(uint16_t slot);
+    CHIP_ERROR LoadPage(size_t page);
+    CHIP_ERROR ReadPage(size_t page, ByteSpan data, bool & dirty);
+    CHIP_ERROR SavePage(size_t page);
+    CHIP_ERROR MigrateSimpleStorage();
+
+    size_t PageCount() const { return (mCapacity + kEntriesPerPage - 1) / kEntriesPerPage; }
+
+    PersistentStorageDelegate * mStorage = nullptr;
+    SimpleSessionResumptionStorage mStateStorage;
+
+    Platform::ScopedMemoryBuffer<Entry> mEntries;
+    Platform::ScopedMemoryBuffer<uint16_t> mNodeBuckets;
+    Platform::ScopedMemoryBuffer<uint16_t> mResumptionIdBuckets;
+    size_t mCapacity          = 0;
+    size_t mBucketMask        = 0;
+    size_t mCount             = 0;
+    uint16_t mFreeList        = kInvalidSlot;
+    uint32_t mNextSaveCounter = 0;
+};
+
+} // namespace chip
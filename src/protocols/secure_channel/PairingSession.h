@@ -216,7 +216,17 @@ protected:
      * If the parameters are present, but TLV reader fails to correctly parse it, the function will
      * return the corresponding error.
      */
-    CHIP_ERROR DecodeMRPParametersIfPresent(TLV::Tag expectedTag, TLV::ContiguousBufferTLVReader & tlvReader);
+    CHIP_ERROR DecodeMRPParametersIfPresent(TLV::Tag expectedTag, TLV::ContiguousBufferTLVReader & tlvReader)
+    {
+        return DecodeMRPParametersIfPresent(expectedTag, tlvReader, mRemoteSessionParams);
+    }
+
+    /**
+     * Same as above, but updates outParams instead of mRemoteSessionParams, for parameters that
+     * must not be used before the rest of the message is verified.
+     */
+    static CHIP_ERROR DecodeMRPParametersIfPresent(TLV::Tag expectedTag, TLV::ContiguousBufferTLVReader & tlvReader,
+                                                   SessionParameters & outParams);
 
     bool IsSessionEstablishmentInProgress();
 
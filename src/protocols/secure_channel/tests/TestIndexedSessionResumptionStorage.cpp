@@ -0,0 +1,355 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <protocols/secure_channel/IndexedSessionResumptionStorage.h>
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+
+#include <string.h>
+
+namespace {
+
+constexpr size_t kTestCapacity = 2 * chip::IndexedSessionResumptionStorage::kEntriesPerPage;
+
+struct TestVector
+{
+    chip::SessionResumptionStorage::ResumptionIdStorage resumptionId;
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    chip::ScopedNodeId node;
+    chip::CATValues cats;
+};
+
+void MakeVector(nlTestSuite * inSuite, TestVector & vector, size_t i)
+{
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(vector.resumptionId.data(), vector.resumptionId.size()));
+    vector.sharedSecret.SetLength(vector.sharedSecret.Capacity());
+    NL_TEST_ASSERT(inSuite,
+                   CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(vector.sharedSecret.Bytes(), vector.sharedSecret.Length()));
+    vector.node           = chip::ScopedNodeId(static_cast<chip::NodeId>(i + 1), static_cast<chip::FabricIndex>(i % 3 + 1));
+    vector.cats.values[0] = static_cast<chip::CASEAuthTag>(rand());
+}
+
+bool IsStored(chip::SessionResumptionStorage & sessionStorage, const TestVector & vector)
+{
+    chip::ScopedNodeId outNode;
+    chip::SessionResumptionStorage::ResumptionIdStorage outResumptionId;
+    chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+    chip::CATValues outCats;
+
+    if (sessionStorage.FindByScopedNodeId(vector.node, outResumptionId, outSharedSecret, outCats) != CHIP_NO_ERROR ||
+        outResumptionId != vector.resumptionId || outCats != vector.cats ||
+        memcmp(vector.sharedSecret.ConstBytes(), outSharedSecret.ConstBytes(), vector.sharedSecret.Length()) != 0)
+    {
+        return false;
+    }
+
+    return sessionStorage.FindByResumptionId(vector.resumptionId, outNode, outSharedSecret, outCats) == CHIP_NO_ERROR &&
+        outNode == vector.node && outCats == vector.cats &&
+        memcmp(vector.sharedSecret.ConstBytes(), outSharedSecret.ConstBytes(), vector.sharedSecret.Length()) == 0;
+}
+
+void TestSaveAndEvict(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::IndexedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+
+    TestVector vectors[kTestCapacity + 2];
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        MakeVector(inSuite, vectors[i], i);
+    }
+
+    for (size_t i = 0; i < kTestCapacity; ++i)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, vectors[i].sharedSecret, vectors[i].cats) ==
+                           CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sessionStorage.Count() == kTestCapacity);
+
+    // Saving vector 0 again makes vector 1 the least recently saved one, which is evicted first.
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.Save(vectors[0].node, vectors[0].resumptionId, vectors[0].sharedSecret, vectors[0].cats) ==
+                       CHIP_NO_ERROR);
+    for (size_t i = kTestCapacity; i < ArraySize(vectors); ++i)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, vectors[i].sharedSecret, vectors[i].cats) ==
+                           CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sessionStorage.Count() == kTestCapacity);
+
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        NL_TEST_ASSERT(inSuite, IsStored(sessionStorage, vectors[i]) == (i != 1 && i != 2));
+    }
+    NL_TEST_ASSERT(inSuite,
+                   !storage.HasKey(chip::DefaultStorageKeyAllocator::FabricSession(vectors[1].node.GetFabricIndex(),
+                                                                                   vectors[1].node.GetNodeId())
+                                       .KeyName()));
+
+    // The index is found again on restart.
+    chip::IndexedSessionResumptionStorage reloadedStorage;
+    NL_TEST_ASSERT(inSuite, reloadedStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reloadedStorage.Count() == kTestCapacity);
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        NL_TEST_ASSERT(inSuite, IsStored(reloadedStorage, vectors[i]) == (i != 1 && i != 2));
+    }
+
+    // The least recently saved session is still known after the restart.
+    TestVector extra;
+    MakeVector(inSuite, extra, ArraySize(vectors));
+    NL_TEST_ASSERT(inSuite, reloadedStorage.Save(extra.node, extra.resumptionId, extra.sharedSecret, extra.cats) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !IsStored(reloadedStorage, vectors[3]));
+    NL_TEST_ASSERT(inSuite, IsStored(reloadedStorage, vectors[0]));
+    NL_TEST_ASSERT(inSuite, IsStored(reloadedStorage, extra));
+}
+
+void TestInPlaceSaveAndDelete(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::IndexedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+    const size_t initialKeyCount = storage.GetNumKeys();
+
+    TestVector vector;
+    TestVector updated;
+    MakeVector(inSuite, vector, 0);
+    MakeVector(inSuite, updated, 0);
+
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.Save(vector.node, vector.resumptionId, vector.sharedSecret, vector.cats) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.Save(updated.node, updated.resumptionId, updated.sharedSecret, updated.cats) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Count() == 1);
+    NL_TEST_ASSERT(inSuite, IsStored(sessionStorage, updated));
+
+    // The previous resumption ID is no longer valid.
+    chip::ScopedNodeId outNode;
+    chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+    chip::CATValues outCats;
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.FindByResumptionId(vector.resumptionId, outNode, outSharedSecret, outCats) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, sessionStorage.Delete(updated.node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Count() == 0);
+    NL_TEST_ASSERT(inSuite, !IsStored(sessionStorage, updated));
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == initialKeyCount);
+}
+
+void TestDeleteAll(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::IndexedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+
+    TestVector vectors[kTestCapacity];
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        MakeVector(inSuite, vectors[i], i);
+        NL_TEST_ASSERT(inSuite,
+                       sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, vectors[i].sharedSecret, vectors[i].cats) ==
+                           CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, sessionStorage.DeleteAll(2) == CHIP_NO_ERROR);
+
+    chip::IndexedSessionResumptionStorage reloadedStorage;
+    NL_TEST_ASSERT(inSuite, reloadedStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+    for (auto & vector : vectors)
+    {
+        NL_TEST_ASSERT(inSuite, IsStored(sessionStorage, vector) == (vector.node.GetFabricIndex() != 2));
+        NL_TEST_ASSERT(inSuite, IsStored(reloadedStorage, vector) == (vector.node.GetFabricIndex() != 2));
+    }
+}
+
+void TestMigrateSimpleStorage(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::SimpleSessionResumptionStorage simpleStorage;
+    NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    TestVector vectors[3];
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        MakeVector(inSuite, vectors[i], i);
+        NL_TEST_ASSERT(inSuite,
+                       simpleStorage.Save(vectors[i].node, vectors[i].resumptionId, vectors[i].sharedSecret, vectors[i].cats) ==
+                           CHIP_NO_ERROR);
+    }
+
+    chip::IndexedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Count() == ArraySize(vectors));
+    for (auto & vector : vectors)
+    {
+        NL_TEST_ASSERT(inSuite, IsStored(sessionStorage, vector));
+        NL_TEST_ASSERT(inSuite,
+                       !storage.HasKey(chip::SimpleSessionResumptionStorage::GetStorageKey(vector.resumptionId).KeyName()));
+    }
+    NL_TEST_ASSERT(inSuite, !storage.HasKey(chip::DefaultStorageKeyAllocator::SessionResumptionIndex().KeyName()));
+}
+
+void TestResumeInterruptedMigration(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::SimpleSessionResumptionStorage simpleStorage;
+    NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    TestVector vectors[3];
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        MakeVector(inSuite, vectors[i], i);
+        NL_TEST_ASSERT(inSuite,
+                       simpleStorage.Save(vectors[i].node, vectors[i].resumptionId, vectors[i].sharedSecret, vectors[i].cats) ==
+                           CHIP_NO_ERROR);
+    }
+
+    const chip::StorageKeyName simpleIndexKey = chip::DefaultStorageKeyAllocator::SessionResumptionIndex();
+    uint8_t simpleIndex[1024];
+    uint16_t simpleIndexSize = sizeof(simpleIndex);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue(simpleIndexKey.KeyName(), simpleIndex, simpleIndexSize) == CHIP_NO_ERROR);
+
+    {
+        chip::IndexedSessionResumptionStorage sessionStorage;
+        NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+    }
+
+    // Leave the storage as if the migration stopped after saving the index pages, before deleting the old index.
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue(simpleIndexKey.KeyName(), simpleIndex, simpleIndexSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   storage.SyncDeleteKeyValue(
+                       chip::DefaultStorageKeyAllocator::SessionResumptionIndexPageCount().KeyName()) == CHIP_NO_ERROR);
+
+    chip::IndexedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Count() == ArraySize(vectors));
+    for (auto & vector : vectors)
+    {
+        NL_TEST_ASSERT(inSuite, IsStored(sessionStorage, vector));
+    }
+    NL_TEST_ASSERT(inSuite, !storage.HasKey(simpleIndexKey.KeyName()));
+}
+
+void TestReduceCapacity(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::IndexedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, kTestCapacity) == CHIP_NO_ERROR);
+
+    TestVector vectors[kTestCapacity];
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        MakeVector(inSuite, vectors[i], i);
+        NL_TEST_ASSERT(inSuite,
+                       sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, vectors[i].sharedSecret, vectors[i].cats) ==
+                           CHIP_NO_ERROR);
+    }
+
+    // Free some slots in the first page, which the sessions of the second page are moved to.
+    constexpr size_t kDeleted = 10;
+    for (size_t i = 0; i < kDeleted; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, sessionStorage.Delete(vectors[i].node) == CHIP_NO_ERROR);
+    }
+
+    chip::IndexedSessionResumptionStorage smallerStorage;
+    NL_TEST_ASSERT(inSuite,
+                   smallerStorage.Init(&storage, chip::IndexedSessionResumptionStorage::kEntriesPerPage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, smallerStorage.Count() == chip::IndexedSessionResumptionStorage::kEntriesPerPage);
+
+    size_t storedCount = 0;
+    for (auto & vector : vectors)
+    {
+        storedCount += IsStored(smallerStorage, vector) ? 1 : 0;
+    }
+    NL_TEST_ASSERT(inSuite, storedCount == chip::IndexedSessionResumptionStorage::kEntriesPerPage);
+    NL_TEST_ASSERT(inSuite, !storage.HasKey(chip::DefaultStorageKeyAllocator::SessionResumptionIndexPage(1).KeyName()));
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestSaveAndEvict", TestSaveAndEvict),
+    NL_TEST_DEF("TestInPlaceSaveAndDelete", TestInPlaceSaveAndDelete),
+    NL_TEST_DEF("TestDeleteAll", TestDeleteAll),
+    NL_TEST_DEF("TestMigrateSimpleStorage", TestMigrateSimpleStorage),
+    NL_TEST_DEF("TestResumeInterruptedMigration", TestResumeInterruptedMigration),
+    NL_TEST_DEF("TestReduceCapacity", TestReduceCapacity),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+int TestSetup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Test-CHIP-IndexedSessionResumptionStorage",
+    &sTests[0],
+    TestSetup,
+    TestTeardown,
+};
+// clang-format on
+
+} // namespace
+
+/**
+ *  Main
+ */
+int TestIndexedSessionResumptionStorage()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestIndexedSessionResumptionStorage)
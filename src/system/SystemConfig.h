@@ -375,6 +375,20 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE
+ *
+ *  @brief
+ *      When packet buffers are allocated using Platform::MemoryAlloc (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is 0), this is
+ *      the number of freed packet buffers of each size class that are kept for reuse instead of being returned to the heap.
+ *
+ *      Cached buffers are kept across Platform::MemoryShutdown(), so this should only be enabled with a memory allocator whose
+ *      blocks stay valid after shutdown, such as the default malloc-based one. Set to zero (0) to disable caching.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -109,6 +109,108 @@ PacketBuffer * PacketBuffer::BuildFreeList()
 // Heap allocation for PacketBuffer objects.
 //
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+namespace {
+
+// Freed buffers are kept in a bounded free list per size class, so that most allocations on the message path do not go
+// to the heap. Every buffer is allocated with the capacity of its size class, so that it can be reused for any allocation
+// in that class.
+constexpr size_t kSmallestSizeClassCapacity = 128;
+
+constexpr size_t SizeClassCapacity(size_t aSizeClass)
+{
+    return ((kSmallestSizeClassCapacity << aSizeClass) < PacketBuffer::kMaxSizeWithoutReserve)
+        ? (kSmallestSizeClassCapacity << aSizeClass)
+        : PacketBuffer::kMaxSizeWithoutReserve;
+}
+
+constexpr size_t CountSizeClasses()
+{
+    size_t count = 1;
+    while (SizeClassCapacity(count - 1) < PacketBuffer::kMaxSizeWithoutReserve)
+    {
+        count++;
+    }
+    return count;
+}
+
+constexpr size_t kSizeClassCount = CountSizeClasses();
+
+constexpr size_t SizeClassOf(size_t aAllocSize)
+{
+    size_t sizeClass = 0;
+    while ((sizeClass + 1 < kSizeClassCount) && (SizeClassCapacity(sizeClass) < aAllocSize))
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+struct BufferCache
+{
+    BufferCache()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        Mutex::Init(mLock);
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    Mutex mLock;
+    PacketBuffer * mFreeList[kSizeClassCount] = {};
+    size_t mCount[kSizeClassCount]            = {};
+};
+
+BufferCache sBufferCache;
+
+} // namespace
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+
+PacketBuffer * PacketBuffer::AllocateFromHeap(size_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    const size_t sizeClass = SizeClassOf(aAllocSize);
+
+    sBufferCache.mLock.Lock();
+    PacketBuffer * lPacket = sBufferCache.mFreeList[sizeClass];
+    if (lPacket != nullptr)
+    {
+        sBufferCache.mFreeList[sizeClass] = lPacket->ChainedBuffer();
+        sBufferCache.mCount[sizeClass]--;
+        SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+    }
+    sBufferCache.mLock.Unlock();
+
+    if (lPacket == nullptr)
+    {
+        lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(kStructureSize + SizeClassCapacity(sizeClass)));
+    }
+    return lPacket;
+#else
+    return reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(kStructureSize + aAllocSize));
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+}
+
+void PacketBuffer::ReleaseToHeap(PacketBuffer * aPacket, size_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    const size_t sizeClass = SizeClassOf(aAllocSize);
+
+    sBufferCache.mLock.Lock();
+    if (sBufferCache.mCount[sizeClass] < CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE)
+    {
+        aPacket->next                     = sBufferCache.mFreeList[sizeClass];
+        sBufferCache.mFreeList[sizeClass] = aPacket;
+        sBufferCache.mCount[sizeClass]++;
+        SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+        aPacket = nullptr;
+    }
+    sBufferCache.mLock.Unlock();
+
+    VerifyOrReturn(aPacket != nullptr);
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    chip::Platform::MemoryFree(aPacket);
+}
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 {
@@ -142,9 +244,15 @@ void PacketBufferHandle::InternalRightSize()
     {
         return;
     }
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    // Buffers are allocated with the capacity of their size class, so only a smaller size class saves memory.
+    if (SizeClassOf(usedSize) == SizeClassOf(mBuffer->alloc_size))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
-    PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+    PacketBuffer * newBuffer = PacketBuffer::AllocateFromHeap(usedSize);
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -591,10 +699,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     UNLOCK_BUF_POOL();
 
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-    // sumOfSizes is essentially (kStructureSize + lAllocSize) which we already
-    // checked to fit in a size_t.
-    const size_t lBlockSize = static_cast<size_t>(sumOfSizes);
-    lPacket                 = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+    lPacket = PacketBuffer::AllocateFromHeap(lAllocSize);
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
 #else
@@ -677,13 +782,14 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+            const size_t lAllocSize = aPacket->alloc_size;
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-            chip::Platform::MemoryFree(aPacket);
+            ReleaseToHeap(aPacket, lAllocSize);
 #endif
             aPacket       = lNextPacket;
         }
@@ -367,6 +367,11 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    static PacketBuffer * AllocateFromHeap(size_t aAllocSize);
+    static void ReleaseToHeap(PacketBuffer * aPacket, size_t aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -49,6 +49,17 @@
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+ *
+ * True if packet buffers allocated using Platform::MemoryAlloc are recycled through per-size-class free lists.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE > 0)
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL
  *
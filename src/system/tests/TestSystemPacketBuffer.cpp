@@ -1603,6 +1603,36 @@ TEST_F_FROM_FIXTURE(TestSystemPacketBuffer, CheckHandleRightSize)
 #endif // CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHTSIZE
 }
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+TEST_F(TestSystemPacketBuffer, CheckHeapCache)
+{
+    // Taking a buffer out of the cache leaves room in it, so the buffer freed below is cached.
+    PacketBufferHandle handle = PacketBufferHandle::New(100, 0);
+    ASSERT_FALSE(handle.IsNull());
+    const uint8_t * const start = handle->Start() - handle->ReservedSize();
+    handle                      = nullptr;
+
+    // A cached buffer is reused for an allocation of the same size class, with the capacity that was asked for.
+    handle = PacketBufferHandle::New(100, 20);
+    ASSERT_FALSE(handle.IsNull());
+    EXPECT_EQ(handle->Start() - handle->ReservedSize(), start);
+    EXPECT_EQ(handle->ReservedSize(), 20u);
+    EXPECT_EQ(handle->MaxDataLength(), 100u);
+    memset(handle->Start(), 0xA5, handle->MaxDataLength());
+    handle->SetDataLength(handle->MaxDataLength());
+
+    // A buffer from a larger size class can be used up to its full capacity.
+    PacketBufferHandle large = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    ASSERT_FALSE(large.IsNull());
+    EXPECT_EQ(large->MaxDataLength(), PacketBuffer::kMaxSizeWithoutReserve);
+    memset(large->Start(), 0x5A, large->MaxDataLength());
+    large->SetDataLength(large->MaxDataLength());
+
+    EXPECT_EQ(handle->DataLength(), 100u);
+    EXPECT_EQ(handle->Start()[99], 0xA5);
+}
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+
 TEST_F_FROM_FIXTURE(TestSystemPacketBuffer, CheckHandleCloneData)
 {
     uint8_t lPayload[2 * PacketBuffer::kMaxSizeWithoutReserve];
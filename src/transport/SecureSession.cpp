@@ -50,6 +50,7 @@ void SecureSession::Activate(const ScopedNodeId & localNode, const ScopedNodeId
 
     Retain(); // This ref is released inside MarkForEviction
     MoveToState(State::kActive);
+    mTable.SessionActivated(this);
 
     if (mSecureSessionType == Type::kCASE)
         mTable.NewerSessionAvailable(this);
@@ -54,7 +54,15 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
 
     SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
                                                    peerSessionId, fabricIndex, config);
-    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    VerifyOrReturnValue(result != nullptr, Optional<SessionHandle>::Missing());
+
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mLocalSessionIdIndex.Insert(result, HashKey(localSessionId));
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    // Test sessions are created in the active state.
+    SessionActivated(result);
+
+    return MakeOptional<SessionHandle>(*result);
 }
 
 Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession::Type secureSessionType,
@@ -82,6 +90,10 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
 
     VerifyOrReturnValue(allocated != nullptr, Optional<SessionHandle>::Missing());
 
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mLocalSessionIdIndex.Insert(allocated, HashKey(sessionId.Value()));
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
     rv             = MakeOptional<SessionHandle>(*allocated);
     mNextSessionId = sessionId.Value() == kMaxSessionID ? static_cast<uint16_t>(kUnsecuredSessionId + 1)
                                                         : static_cast<uint16_t>(sessionId.Value() + 1);
@@ -89,6 +101,24 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     return rv;
 }
 
+void SecureSessionTable::ReleaseSession(SecureSession * session)
+{
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mLocalSessionIdIndex.Remove(session, HashKey(session->GetLocalSessionId()));
+    mPeerIndex.Remove(session, HashKey(session->GetPeerNodeId()));
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mEntries.ReleaseObject(session);
+}
+
+void SecureSessionTable::SessionActivated(SecureSession * session)
+{
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mPeerIndex.Insert(session, HashKey(session->GetPeerNodeId()));
+#else
+    (void) session;
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+}
+
 SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, SecureSession::Type secureSessionType,
                                                      const ScopedNodeId & sessionEvictionHint)
 {
@@ -338,21 +368,46 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
 }
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
+{
+    SecureSession * result = FindSessionByLocalKey(localSessionId);
+    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+}
+
+SecureSession * SecureSessionTable::FindSessionByLocalKey(uint16_t localSessionId)
 {
     SecureSession * result = nullptr;
-    mEntries.ForEachActiveObject([&](auto session) {
+    auto matches           = [&](SecureSession * session) {
         if (session->GetLocalSessionId() == localSessionId)
         {
             result = session;
             return Loop::Break;
         }
         return Loop::Continue;
-    });
-    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    };
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mLocalSessionIdIndex.ForEachCandidate(HashKey(localSessionId), matches);
+#else
+    mEntries.ForEachActiveObject(std::move(matches));
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    return result;
 }
 
 Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
 {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    // Each session holds a single ID, so this stops after at most one lookup per
+    // allocated session (plus kUnsecuredSessionId).
+    for (uint32_t i = 0; i <= kMaxSessionID; i++)
+    {
+        uint16_t candidate = static_cast<uint16_t>(mNextSessionId + i);
+        if (candidate != kUnsecuredSessionId && FindSessionByLocalKey(candidate) == nullptr)
+        {
+            return MakeOptional<uint16_t>(candidate);
+        }
+    }
+
+    return NullOptional;
+#else
     uint16_t candidate_base = 0;
     uint64_t candidate_mask = 0;
     for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
@@ -401,7 +456,47 @@ Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
     }
 
     return NullOptional;
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+}
+
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+void SecureSessionTable::SessionIndex::Insert(SecureSession * session, uint32_t hash)
+{
+    size_t i = hash & kMask;
+    // The table holds at most CHIP_CONFIG_SECURE_SESSION_POOL_SIZE entries, so there always is a free slot.
+    while (mSlots[i].mSession != nullptr)
+    {
+        i = (i + 1) & kMask;
+    }
+    mSlots[i].mSession = session;
+    mSlots[i].mHash    = hash;
+}
+
+void SecureSessionTable::SessionIndex::Remove(SecureSession * session, uint32_t hash)
+{
+    size_t i = hash & kMask;
+    while (mSlots[i].mSession != session)
+    {
+        VerifyOrReturn(mSlots[i].mSession != nullptr);
+        i = (i + 1) & kMask;
+    }
+
+    // Move back every following entry of the probe sequence which would no longer
+    // be reachable from its home slot once slot i is emptied.
+    for (size_t j = (i + 1) & kMask; mSlots[j].mSession != nullptr; j = (j + 1) & kMask)
+    {
+        size_t home = mSlots[j].mHash & kMask;
+        // Entry j can stay where it is if its home slot lies cyclically in (i, j].
+        bool reachable = (i < j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!reachable)
+        {
+            mSlots[i] = mSlots[j];
+            i         = j;
+        }
+    }
+    mSlots[i] = Slot();
 }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
 
 } // namespace Transport
 } // namespace chip
@@ -29,6 +29,20 @@ namespace Transport {
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+namespace internal {
+
+constexpr size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace internal
+
 /**
  * Handles a set of sessions.
  *
@@ -76,7 +90,11 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session);
+
+    // Called by a session once its peer is known, i.e. when it gets activated.
+    // This is an internal API, using raw pointer to a session is allowed here.
+    void SessionActivated(SecureSession * session);
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -84,6 +102,25 @@ public:
         return mEntries.ForEachActiveObject(std::forward<Function>(function));
     }
 
+    /**
+     * Iterate over the sessions whose peer is the given node.  Sessions that
+     * were never activated have no peer and are not visited.
+     *
+     * The function must not create or release sessions.
+     */
+    template <typename Function>
+    Loop ForEachSessionWithPeer(const ScopedNodeId & peer, Function && function)
+    {
+        auto visit = [&](SecureSession * session) {
+            return (session->GetPeer() == peer && !session->IsEstablishing()) ? function(session) : Loop::Continue;
+        };
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        return mPeerIndex.ForEachCandidate(HashKey(peer.GetNodeId()), visit);
+#else
+        return mEntries.ForEachActiveObject(std::move(visit));
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    }
+
     /**
      * Get a secure session given its session ID.
      *
@@ -248,14 +285,72 @@ private:
      * from the starting mNextSessionId clue.
      *
      * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  With
+     * CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX, candidate IDs are instead checked
+     * against the local session ID index, one at a time.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    SecureSession * FindSessionByLocalKey(uint16_t localSessionId);
+
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    /**
+     * An open-addressing hash table of sessions, with linear probing.  Entries
+     * are removed by shifting the following entries of the probe sequence back,
+     * so that no tombstones are needed.
+     *
+     * Several sessions may be stored under the same key: ForEachCandidate()
+     * visits every session stored with the given hash and the caller checks
+     * which of them actually match.
+     */
+    class SessionIndex
+    {
+    public:
+        void Insert(SecureSession * session, uint32_t hash);
+        void Remove(SecureSession * session, uint32_t hash);
+
+        template <typename Function>
+        Loop ForEachCandidate(uint32_t hash, Function && function) const
+        {
+            for (size_t i = hash & kMask; mSlots[i].mSession != nullptr; i = (i + 1) & kMask)
+            {
+                if (mSlots[i].mHash == hash && function(mSlots[i].mSession) == Loop::Break)
+                {
+                    return Loop::Break;
+                }
+            }
+            return Loop::Finish;
+        }
+
+    private:
+        // Keep the load factor at or below 1/2 so that probe sequences stay short.
+        static constexpr size_t kCapacity = internal::RoundUpToPowerOfTwo(2 * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+        static constexpr size_t kMask     = kCapacity - 1;
+
+        struct Slot
+        {
+            SecureSession * mSession = nullptr;
+            uint32_t mHash           = 0;
+        };
+        Slot mSlots[kCapacity];
+    };
+
+    static uint32_t HashKey(uint64_t key)
+    {
+        // Fibonacci hashing: the high bits of the product depend on all the bits of the key.
+        return static_cast<uint32_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+    }
+
+    // Every session in mEntries, keyed by local session ID.
+    SessionIndex mLocalSessionIdIndex;
+    // Every activated session, keyed by peer node ID.  The fabric index is not
+    // part of the key since a PASE session may adopt one after activation.
+    SessionIndex mPeerIndex;
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
@@ -535,9 +535,8 @@ void SessionManager::ExpireAllPASESessions()
 
 void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Optional<Transport::SecureSession::Type> & type)
 {
-    mSecureSessions.ForEachSession([&node, &type](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == node &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionWithPeer(node, [&type](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             session->MarkAsDefunct();
         }
@@ -547,10 +546,10 @@ void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Opti
 
 void SessionManager::UpdateAllSessionsPeerAddress(const ScopedNodeId & node, const Transport::PeerAddress & addr)
 {
-    mSecureSessions.ForEachSession([&node, &addr](auto session) {
+    mSecureSessions.ForEachSessionWithPeer(node, [&addr](auto session) {
         // Arguably we should only be updating active and defunct sessions, but there is no harm
         // in updating evicted sessions.
-        if (session->GetPeer() == node && Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
+        if (Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
         {
             session->SetPeerAddress(addr);
         }
@@ -610,29 +609,34 @@ CHIP_ERROR SessionManager::InjectCaseSessionWithTestKey(SessionHolder & sessionH
 void SessionManager::OnMessageReceived(const PeerAddress & peerAddress, System::PacketBufferHandle && msg,
                                        Transport::MessageTransportContext * ctxt)
 {
-    PacketHeader partialPacketHeader;
+    // Decode the packet header once, here, rather than decoding its fixed fields first and the whole header again in each
+    // dispatch method.  Only the fixed fields are meaningful yet if the header is obfuscated for privacy.
+    PacketHeader packetHeader;
+    uint16_t headerSize = 0;
 
-    CHIP_ERROR err = partialPacketHeader.DecodeFixed(msg);
+    CHIP_ERROR err = packetHeader.Decode(msg->Start(), msg->DataLength(), &headerSize);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Inet, "Failed to decode packet header: %" CHIP_ERROR_FORMAT, err.Format());
         return;
     }
 
-    if (partialPacketHeader.IsEncrypted())
+    if (packetHeader.IsEncrypted() && packetHeader.IsGroupSession())
     {
-        if (partialPacketHeader.IsGroupSession())
-        {
-            SecureGroupMessageDispatch(partialPacketHeader, peerAddress, std::move(msg));
-        }
-        else
-        {
-            SecureUnicastMessageDispatch(partialPacketHeader, peerAddress, std::move(msg), ctxt);
-        }
+        // Group messages are decrypted from a copy of the whole message, header included, for each candidate key.
+        SecureGroupMessageDispatch(packetHeader, peerAddress, std::move(msg));
+        return;
+    }
+
+    msg->ConsumeHead(headerSize);
+
+    if (packetHeader.IsEncrypted())
+    {
+        SecureUnicastMessageDispatch(packetHeader, peerAddress, std::move(msg), ctxt);
     }
     else
     {
-        UnauthenticatedMessageDispatch(partialPacketHeader, peerAddress, std::move(msg), ctxt);
+        UnauthenticatedMessageDispatch(packetHeader, peerAddress, std::move(msg), ctxt);
     }
 }
 
@@ -758,9 +762,8 @@ void SessionManager::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, b
 }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
-void SessionManager::UnauthenticatedMessageDispatch(const PacketHeader & partialPacketHeader,
-                                                    const Transport::PeerAddress & peerAddress, System::PacketBufferHandle && msg,
-                                                    Transport::MessageTransportContext * ctxt)
+void SessionManager::UnauthenticatedMessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
+                                                    System::PacketBufferHandle && msg, Transport::MessageTransportContext * ctxt)
 {
     MATTER_TRACE_SCOPE("Unauthenticated Message Dispatch", "SessionManager");
 
@@ -773,15 +776,12 @@ void SessionManager::UnauthenticatedMessageDispatch(const PacketHeader & partial
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
     // Drop unsecured messages with privacy enabled.
-    if (partialPacketHeader.HasPrivacyFlag())
+    if (packetHeader.HasPrivacyFlag())
     {
         ChipLogError(Inet, "Dropping unauthenticated message with privacy flag set");
         return;
     }
 
-    PacketHeader packetHeader;
-    ReturnOnFailure(packetHeader.DecodeAndConsume(msg));
-
     Optional<NodeId> source      = packetHeader.GetSourceNodeId();
     Optional<NodeId> destination = packetHeader.GetDestinationNodeId();
 
@@ -878,9 +878,8 @@ void SessionManager::UnauthenticatedMessageDispatch(const PacketHeader & partial
     }
 }
 
-void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPacketHeader,
-                                                  const Transport::PeerAddress & peerAddress, System::PacketBufferHandle && msg,
-                                                  Transport::MessageTransportContext * ctxt)
+void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
+                                                  System::PacketBufferHandle && msg, Transport::MessageTransportContext * ctxt)
 {
     MATTER_TRACE_SCOPE("Secure Unicast Message Dispatch", "SessionManager");
 
@@ -894,10 +893,10 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
-    Optional<SessionHandle> session = mSecureSessions.FindSecureSessionByLocalKey(partialPacketHeader.GetSessionId());
+    Optional<SessionHandle> session = mSecureSessions.FindSecureSessionByLocalKey(packetHeader.GetSessionId());
     if (!session.HasValue())
     {
-        ChipLogError(Inet, "Data received on an unknown session (LSID=%d). Dropping it!", partialPacketHeader.GetSessionId());
+        ChipLogError(Inet, "Data received on an unknown session (LSID=%d). Dropping it!", packetHeader.GetSessionId());
         return;
     }
 
@@ -932,15 +931,12 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     PayloadHeader payloadHeader;
 
     // Drop secure unicast messages with privacy enabled.
-    if (partialPacketHeader.HasPrivacyFlag())
+    if (packetHeader.HasPrivacyFlag())
     {
         ChipLogError(Inet, "Dropping secure unicast message with privacy flag set");
         return;
     }
 
-    PacketHeader packetHeader;
-    ReturnOnFailure(packetHeader.DecodeAndConsume(msg));
-
     SessionMessageDelegate::DuplicateMessage isDuplicate = SessionMessageDelegate::DuplicateMessage::No;
 
     if (msg.IsNull())
@@ -1023,7 +1019,7 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
  * Helper function to implement a single attempt to decrypt a groupcast message
  * using the given group key and privacy setting.
  *
- * @param[in] partialPacketHeader The partial packet header with non-obfuscated message fields (result of calling DecodeFixed).
+ * @param[in] partialPacketHeader The packet header as received; only its fixed fields are meaningful if privacy is applied.
  * @param[out] packetHeaderCopy A copy of the packet header, to be filled with privacy decrypted fields
  * @param[out] payloadHeader The payload header of the decrypted message
  * @param[in] applyPrivacy Whether to apply privacy deobfuscation
@@ -1121,10 +1117,22 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     ReturnOnFailure(mac.Decode(partialPacketHeader, &data[len - footerLen], footerLen, &taglen));
     VerifyOrReturn(taglen == footerLen);
 
+    // Without privacy, the destination group is sent in the clear and known before decryption, so
+    // the keys of other groups can be skipped without copying the message.
+    Optional<GroupId> destinationGroupId;
+    if (!partialPacketHeader.HasPrivacyFlag())
+    {
+        destinationGroupId = partialPacketHeader.GetDestinationGroupId();
+    }
+
     bool decrypted = false;
     while (!decrypted && iter->Next(groupContext))
     {
-        CryptoContext context(groupContext.keyContext);
+        if (destinationGroupId.HasValue() && destinationGroupId.Value() != groupContext.group_id)
+        {
+            continue;
+        }
+
         msgCopy = msg.CloneData();
         if (msgCopy.IsNull())
         {
@@ -1248,13 +1256,12 @@ Optional<SessionHandle> SessionManager::FindSecureSessionForNode(ScopedNodeId pe
     SecureSession * tcpSession = nullptr;
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
-    mSecureSessions.ForEachSession([&peerNodeId, &type, &mrpSession,
+    mSecureSessions.ForEachSessionWithPeer(peerNodeId, [&type, &mrpSession,
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &tcpSession,
+                                                        &tcpSession,
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &transportPayloadCapability](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == peerNodeId &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+                                                        &transportPayloadCapability](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
             if ((transportPayloadCapability == TransportPayloadCapability::kMRPOrTCPCompatiblePayload ||
@@ -554,20 +554,20 @@ private:
     /**
      * @brief Parse, decrypt, validate, and dispatch a secure unicast message.
      *
-     * @param[in] partialPacketHeader The partial PacketHeader of the message after processing with DecodeFixed.
-     * If the message decrypts successfully, this will be filled with a fully decoded PacketHeader.
+     * @param[in] packetHeader The decoded PacketHeader of the message.
      * @param[in] peerAddress The PeerAddress of the message as provided by the receiving Transport Endpoint.
-     * @param msg The full message buffer, including header fields.
+     * @param msg The message buffer, starting after the PacketHeader.
      * @param ctxt The pointer to additional context on the underlying transport. For TCP, it is a pointer
      *             to the underlying connection object.
      */
-    void SecureUnicastMessageDispatch(const PacketHeader & partialPacketHeader, const Transport::PeerAddress & peerAddress,
+    void SecureUnicastMessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
                                       System::PacketBufferHandle && msg, Transport::MessageTransportContext * ctxt = nullptr);
 
     /**
      * @brief Parse, decrypt, validate, and dispatch a secure group message.
      *
-     * @param partialPacketHeader The partial PacketHeader of the message once processed with DecodeFixed.
+     * @param partialPacketHeader The decoded PacketHeader of the message. Only its fixed fields are meaningful if the
+     *                            header is obfuscated for privacy.
      * @param peerAddress The PeerAddress of the message as provided by the receiving Transport Endpoint.
      * @param msg The full message buffer, including header fields.
      */
@@ -577,13 +577,13 @@ private:
     /**
      * @brief Parse, decrypt, validate, and dispatch an unsecured message.
      *
-     * @param partialPacketHeader The partial PacketHeader of the message after processing with DecodeFixed.
+     * @param packetHeader The decoded PacketHeader of the message.
      * @param peerAddress The PeerAddress of the message as provided by the receiving Transport Endpoint.
-     * @param msg The full message buffer, including header fields.
+     * @param msg The message buffer, starting after the PacketHeader.
      * @param ctxt The pointer to additional context on the underlying transport. For TCP, it is a pointer
      *             to the underlying connection object.
      */
-    void UnauthenticatedMessageDispatch(const PacketHeader & partialPacketHeader, const Transport::PeerAddress & peerAddress,
+    void UnauthenticatedMessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
                                         System::PacketBufferHandle && msg, Transport::MessageTransportContext * ctxt = nullptr);
 
     void OnReceiveError(CHIP_ERROR error, const Transport::PeerAddress & source);
@@ -643,6 +643,28 @@ inline bool HasFooterSpace(const System::PacketBufferHandle & aBuffer)
     return aBuffer->AvailableDataLength() >= kMaxFooterSize;
 }
 
+/**
+ * Prepares the buffer of a received message to carry an outgoing message with the same contents, e.g. a response that
+ * echoes the request, so that the outgoing message does not need a buffer of its own.
+ *
+ *  The contents are moved within the buffer if that is needed to make room for the message headers.
+ *
+ *  @param[in]  aBuffer         The received message buffer, starting at the application data.
+ *
+ *  @return     The same buffer if it can be reused, otherwise a new buffer with a copy of its contents. \c nullptr if
+ *              a new buffer was needed but no memory is available.
+ */
+inline System::PacketBufferHandle ReuseOrCopy(System::PacketBufferHandle && aBuffer)
+{
+    // A buffer that someone else holds on to, e.g. an application callback that retained it, must not be changed.
+    if (aBuffer.HasSoleOwnership() && !aBuffer->HasChainedBuffer() &&
+        aBuffer->EnsureReservedSize(System::PacketBuffer::kDefaultHeaderReserve) && HasFooterSpace(aBuffer))
+    {
+        return std::move(aBuffer);
+    }
+    return NewWithData(aBuffer->Start(), aBuffer->DataLength());
+}
+
 } // namespace MessagePacketBuffer
 
 } // namespace chip
@@ -21,6 +21,7 @@
  *      This file implements unit tests for the SessionManager implementation.
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <vector>
 
@@ -460,5 +461,99 @@ TEST_F(TestSecureSessionTable, ValidateSessionSorting)
     ValidateSessionSorting();
 }
 
+TEST_F(TestSecureSessionTable, FindSessionsByLocalKeyAndPeer)
+{
+    constexpr size_t kNumSessions      = CHIP_CONFIG_SECURE_SESSION_POOL_SIZE - 1;
+    constexpr NodeId kNumPeers         = 4;
+    constexpr FabricIndex kFabric      = 1;
+    constexpr FabricIndex kOtherFabric = 2;
+    const ReliableMessageProtocolConfig config(System::Clock::Milliseconds32(0), System::Clock::Milliseconds32(0),
+                                               System::Clock::Milliseconds16(0));
+
+    SecureSessionTable table;
+    table.Init();
+
+    std::vector<SecureSession *> sessions;
+    for (size_t i = 0; i < kNumSessions; i++)
+    {
+        auto session = table.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+        ASSERT_TRUE(session.HasValue());
+
+        // Activation keeps the session in the table once the handle goes away.
+        ScopedNodeId peer(static_cast<NodeId>(100 + (i % kNumPeers)), kFabric);
+        session.Value()->AsSecureSession()->Activate(ScopedNodeId(1, kFabric), peer, CATValues(), static_cast<uint16_t>(i),
+                                                     config);
+        sessions.push_back(session.Value()->AsSecureSession());
+    }
+
+    // Evict every third session.
+    std::vector<uint16_t> evictedSessionIds;
+    for (size_t i = 0; i < kNumSessions; i += 3)
+    {
+        evictedSessionIds.push_back(sessions[i]->GetLocalSessionId());
+        sessions[i]->MarkForEviction();
+        sessions[i] = nullptr;
+    }
+
+    // A pending session is found by its local session ID but has no peer yet.
+    auto pending = table.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+    ASSERT_TRUE(pending.HasValue());
+    uint16_t pendingSessionId = pending.Value()->AsSecureSession()->GetLocalSessionId();
+    auto found                = table.FindSecureSessionByLocalKey(pendingSessionId);
+    ASSERT_TRUE(found.HasValue());
+    EXPECT_TRUE(found.Value() == pending.Value());
+
+    for (uint16_t sessionId : evictedSessionIds)
+    {
+        if (sessionId != pendingSessionId)
+        {
+            EXPECT_FALSE(table.FindSecureSessionByLocalKey(sessionId).HasValue());
+        }
+    }
+
+    for (size_t i = 0; i < kNumSessions; i++)
+    {
+        if (sessions[i] == nullptr)
+        {
+            continue;
+        }
+        auto session = table.FindSecureSessionByLocalKey(sessions[i]->GetLocalSessionId());
+        ASSERT_TRUE(session.HasValue());
+        EXPECT_EQ(session.Value()->AsSecureSession(), sessions[i]);
+    }
+
+    for (NodeId peer = 0; peer < kNumPeers; peer++)
+    {
+        size_t expected = 0;
+        for (size_t i = 0; i < kNumSessions; i++)
+        {
+            expected += (sessions[i] != nullptr && sessions[i]->GetPeer() == ScopedNodeId(100 + peer, kFabric)) ? 1 : 0;
+        }
+
+        size_t count = 0;
+        table.ForEachSessionWithPeer(ScopedNodeId(100 + peer, kFabric), [&](SecureSession * session) {
+            EXPECT_NE(std::find(sessions.begin(), sessions.end(), session), sessions.end());
+            count++;
+            return Loop::Continue;
+        });
+        EXPECT_EQ(count, expected);
+
+        count = 0;
+        table.ForEachSessionWithPeer(ScopedNodeId(100 + peer, kOtherFabric), [&](SecureSession * session) {
+            count++;
+            return Loop::Continue;
+        });
+        EXPECT_EQ(count, 0u);
+    }
+
+    for (auto * session : sessions)
+    {
+        if (session != nullptr)
+        {
+            session->MarkForEviction();
+        }
+    }
+}
+
 } // namespace Transport
 } // namespace chip
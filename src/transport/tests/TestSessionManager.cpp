@@ -1014,4 +1014,35 @@ TEST_F(TestSessionManager, TestFindSecureSessionForNode)
     sessionManager.Shutdown();
 }
 
+TEST_F(TestSessionManager, ReuseOrCopyReceivedBufferTest)
+{
+    const char payload[] = "Echo Message";
+
+    // A received buffer, starting right after the headers consumed while receiving it.
+    System::PacketBufferHandle received = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+    ASSERT_FALSE(received.IsNull());
+    received->SetDataLength(16 + sizeof(payload));
+    memcpy(received->Start() + 16, payload, sizeof(payload));
+    received->ConsumeHead(16);
+
+    // A buffer that nothing else holds on to is reused, with room for the outgoing headers.
+    const uint8_t * receivedBuffer      = received->Start() - received->ReservedSize();
+    System::PacketBufferHandle response = MessagePacketBuffer::ReuseOrCopy(std::move(received));
+    ASSERT_FALSE(response.IsNull());
+    EXPECT_EQ(response->Start() - response->ReservedSize(), receivedBuffer);
+    EXPECT_GE(response->ReservedSize(), System::PacketBuffer::kDefaultHeaderReserve);
+    EXPECT_TRUE(MessagePacketBuffer::HasFooterSpace(response));
+    ASSERT_EQ(response->DataLength(), sizeof(payload));
+    EXPECT_EQ(memcmp(response->Start(), payload, sizeof(payload)), 0);
+
+    // A buffer that is also held elsewhere is left alone and copied.
+    System::PacketBufferHandle retained = response.Retain();
+    System::PacketBufferHandle copy     = MessagePacketBuffer::ReuseOrCopy(std::move(response));
+    ASSERT_FALSE(copy.IsNull());
+    EXPECT_NE(copy->Start(), retained->Start());
+    EXPECT_TRUE(MessagePacketBuffer::HasFooterSpace(copy));
+    ASSERT_EQ(copy->DataLength(), sizeof(payload));
+    EXPECT_EQ(memcmp(copy->Start(), payload, sizeof(payload)), 0);
+}
+
 } // namespace
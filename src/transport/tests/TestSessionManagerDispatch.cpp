@@ -470,6 +470,7 @@ public:
 
         ChipLogProgress(Test, "OnMessageReceived: sessionId=0x%04x", testEntry.sessionId);
         EXPECT_EQ(header.GetSessionId(), testEntry.sessionId);
+        mLastHeader = header;
 
         size_t dataLength   = msgBuf->DataLength();
         size_t expectLength = testEntry.payloadLength;
@@ -490,6 +491,7 @@ public:
 
     unsigned mTestVectorIndex = 0;
     unsigned mReceivedCount   = 0;
+    PacketHeader mLastHeader;
 };
 
 PeerAddress AddressFromString(const char * str)
@@ -508,7 +510,10 @@ void TestSessionManagerInit(TestContext & ctx, SessionManager & sessionManager)
     static chip::TestPersistentStorageDelegate deviceStorage;
     static chip::Crypto::DefaultSessionKeystore sessionKeystore;
 
-    EXPECT_EQ(CHIP_NO_ERROR, fabricTableHolder.Init());
+    // The fabric table and group data provider outlive the session managers of the tests using them.
+    static const CHIP_ERROR fabricTableInitError = fabricTableHolder.Init();
+
+    EXPECT_EQ(CHIP_NO_ERROR, fabricTableInitError);
     EXPECT_EQ(CHIP_NO_ERROR,
               sessionManager.Init(&ctx.GetSystemLayer(), &ctx.GetTransportMgr(), &gMessageCounterManager, &deviceStorage,
                                   &fabricTableHolder.GetFabricTable(), sessionKeystore));
@@ -611,4 +616,112 @@ TEST_F(TestSessionManagerDispatch, TestSessionManagerDispatch)
     sessionManager.Shutdown();
 }
 
+#if !CHIP_CONFIG_SECURITY_TEST_MODE
+TEST_F(TestSessionManagerDispatch, TestGroupMessageWithoutPrivacy)
+{
+    constexpr uint16_t kKeySetIndex = 0x0;
+
+    SessionManager sessionManager;
+    TestSessionManagerCallback callback;
+
+    TestSessionManagerInit(mContext, sessionManager);
+    sessionManager.SetMessageDelegate(&callback);
+
+    unsigned testVectorIndex = 0;
+    while (strcmp(theMessageTestVector[testVectorIndex].name, "secure group message (no privacy)") != 0)
+    {
+        testVectorIndex++;
+        ASSERT_LT(testVectorIndex, theMessageTestVectorLength);
+    }
+    MessageTestEntry & testEntry = theMessageTestVector[testVectorIndex];
+    ASSERT_NE(testEntry.groupId, 1);
+
+    // Map the message's key set to another group first, so that the dispatch has to skip it.
+    GroupDataProvider * provider = GetGroupDataProvider();
+    KeySet keySet(kKeySetIndex, SecurityPolicy::kTrustFirst, 1);
+    memcpy(keySet.epoch_keys[0].key, testEntry.epochKey, 16);
+    keySet.epoch_keys[0].start_time = 0;
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetKeySet(kFabricIndex, kCompressedFabricId1, keySet));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupKeyAt(kFabricIndex, 0, GroupKey(1, kKeySetIndex)));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupInfoAt(kFabricIndex, 0, GroupInfo(1, "Other Group")));
+
+    const PeerAddress peerAddress = AddressFromString(testEntry.peerAddr);
+    auto sendTestMessage          = [&]() {
+        // Forget the message counters seen so far, so that the same test vector can be sent again.
+        sessionManager.FabricRemoved(kFabricIndex);
+        callback.ResetTest(testVectorIndex);
+
+        chip::System::PacketBufferHandle msg =
+            chip::MessagePacketBuffer::NewWithData(reinterpret_cast<const uint8_t *>(testEntry.privacy), testEntry.privacyLength);
+        sessionManager.OnMessageReceived(peerAddress, std::move(msg));
+        return callback.NumMessagesReceived();
+    };
+
+    // Only the other group uses the key: the message is not for this node.
+    EXPECT_EQ(sendTestMessage(), 0u);
+
+    // Once the destination group uses the key too, the message is received.
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupKeyAt(kFabricIndex, 1, GroupKey(testEntry.groupId, kKeySetIndex)));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupInfoAt(kFabricIndex, 1, GroupInfo(testEntry.groupId, "Name Matter Not")));
+    EXPECT_EQ(sendTestMessage(), 1u);
+
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveGroupKeys(kFabricIndex));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveGroupInfo(kFabricIndex, testEntry.groupId));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveGroupInfo(kFabricIndex, 1));
+
+    sessionManager.Shutdown();
+}
+
+TEST_F(TestSessionManagerDispatch, TestGroupMessageWithPrivacy)
+{
+    SessionManager sessionManager;
+    TestSessionManagerCallback callback;
+
+    TestSessionManagerInit(mContext, sessionManager);
+    sessionManager.SetMessageDelegate(&callback);
+
+    unsigned testVectorIndex = 0;
+    while (strcmp(theMessageTestVector[testVectorIndex].name, "private group message") != 0)
+    {
+        testVectorIndex++;
+        ASSERT_LT(testVectorIndex, theMessageTestVectorLength);
+    }
+    MessageTestEntry & testEntry = theMessageTestVector[testVectorIndex];
+
+    SessionHolder groupSession;
+    EXPECT_EQ(CHIP_NO_ERROR, InjectGroupSessionWithTestKey(groupSession, testEntry));
+
+    // SessionManager decodes the header once as received, before the privacy obfuscation is removed: the source node and
+    // destination group it finds there are not the real ones, and must not be used to pick the group key.
+    chip::System::PacketBufferHandle msg =
+        chip::MessagePacketBuffer::NewWithData(reinterpret_cast<const uint8_t *>(testEntry.privacy), testEntry.privacyLength);
+    PacketHeader obfuscatedHeader;
+    uint16_t obfuscatedHeaderSize = 0;
+    EXPECT_EQ(CHIP_NO_ERROR, obfuscatedHeader.Decode(msg->Start(), msg->DataLength(), &obfuscatedHeaderSize));
+    EXPECT_TRUE(obfuscatedHeader.HasPrivacyFlag());
+    EXPECT_NE(obfuscatedHeader.GetDestinationGroupId(), MakeOptional(testEntry.groupId));
+
+    // Forget the message counters seen so far, so that the test vector is not dropped as a replay.
+    sessionManager.FabricRemoved(kFabricIndex);
+    callback.ResetTest(testVectorIndex);
+    sessionManager.OnMessageReceived(AddressFromString(testEntry.peerAddr), std::move(msg));
+
+    // The delegate gets the header with the obfuscation removed.
+    PacketHeader plainHeader;
+    uint16_t plainHeaderSize = 0;
+    EXPECT_EQ(CHIP_NO_ERROR,
+              plainHeader.Decode(reinterpret_cast<const uint8_t *>(testEntry.plain), testEntry.plainLength, &plainHeaderSize));
+    EXPECT_EQ(callback.NumMessagesReceived(), 1u);
+    EXPECT_EQ(callback.mLastHeader.GetMessageCounter(), plainHeader.GetMessageCounter());
+    EXPECT_EQ(callback.mLastHeader.GetSourceNodeId(), plainHeader.GetSourceNodeId());
+    EXPECT_EQ(callback.mLastHeader.GetDestinationGroupId(), MakeOptional(testEntry.groupId));
+
+    GroupDataProvider * provider = GetGroupDataProvider();
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveGroupKeys(kFabricIndex));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveGroupInfo(kFabricIndex, testEntry.groupId));
+
+    sessionManager.Shutdown();
+}
+#endif // !CHIP_CONFIG_SECURITY_TEST_MODE
+
 } // namespace